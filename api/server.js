@@ -34,6 +34,8 @@ var data_timestamp;
 var data_timing;
 var data_iqdata;
 var capture = false;
+var map_division = [];
+var detection_division = [];
 
 // api server
 const app = express();
@@ -54,6 +56,12 @@ app.get('/api/map', (req, res) => {
 app.get('/api/detection', (req, res) => {
   res.send(detection);
 });
+app.get('/api/map/:i', (req, res) => {
+  res.send(map_division[req.params.i] || '');
+});
+app.get('/api/detection/:i', (req, res) => {
+  res.send(detection_division[req.params.i] || '');
+});
 app.get('/api/tracker', (req, res) => {
   res.send(track);
 });
@@ -212,6 +220,31 @@ const server_iqdata = net.createServer((socket)=>{
 });
 server_iqdata.listen(config.network.ports.iqdata);
 
+// tcp listeners for each CPI division map and detection
+function listen_division(port, store, i) {
+  var data = '';
+  const server = net.createServer((socket)=>{
+    socket.on("data",(msg)=>{
+      data = data + msg.toString();
+      if (data.slice(-1) === "}")
+      {
+        store[i] = data;
+        data = '';
+      }
+    });
+    socket.on("close",()=>{
+        console.log("Connection closed.");
+    })
+  });
+  server.listen(port);
+}
+(config.network.ports.mapDivisions || []).forEach((port, i) => {
+  listen_division(port, map_division, i);
+});
+(config.network.ports.detectionDivisions || []).forEach((port, i) => {
+  listen_division(port, detection_division, i);
+});
+
 process.on('SIGTERM', () => {
   console.log('SIGTERM signal received.');
   process.exit(0);
@@ -9,13 +9,25 @@
 #include "data/meta/Timing.h"
 #include "data/Track.h"
 #include "process/ambiguity/Ambiguity.h"
+#include "process/ambiguity/AmbiguityDirect.h"
+#include "process/ambiguity/AmbiguityRoi.h"
+#include "process/ambiguity/AmbiguitySliding.h"
 #include "process/clutter/WienerHopf.h"
+#include "process/clutter/EcaBatches.h"
+#include "process/clutter/EcaDoppler.h"
 #include "process/detection/CfarDetector1D.h"
+#include "process/detection/CfarDetector2D.h"
+#include "process/detection/CfarDetectorOs.h"
+#include "process/detection/CfarDetectorClutterMap.h"
 #include "process/detection/Centroid.h"
 #include "process/detection/Interpolate.h"
+#include "process/detection/PeakExtractor.h"
 #include "process/spectrum/SpectrumAnalyser.h"
+#include "process/spectrum/ReferenceSpectrum.h"
 #include "process/tracker/Tracker.h"
 #include "process/utility/Socket.h"
+#include "process/meta/Fftw.h"
+#include "process/meta/Autotune.h"
 #include "data/meta/Constants.h"
 
 #include <ryml/ryml.hpp>
@@ -32,6 +44,7 @@
 #include <sys/time.h>
 #include <signal.h>
 #include <atomic>
+#include <type_traits>
 #include <memory>
 #include <iostream>
 
@@ -52,6 +65,9 @@ uint64_t current_time_us();
 void timing_helper(std::vector<std::string>& timing_name, 
   std::vector<double>& timing_time, std::vector<uint64_t>& time_us, 
   std::string name);
+template <typename T>
+void run_process(ryml::Tree &tree, IqData *buffer1, IqData *buffer2, 
+  uint32_t fs, uint32_t fc, std::string path, bool saveIq);
 
 int main(int argc, char **argv)
 {
@@ -112,12 +128,13 @@ int main(int argc, char **argv)
   }
 
   // set up fftw multithread
-  if (fftw_init_threads() == 0)
+  if (Fftw<double>::init_threads() == 0 || Fftw<float>::init_threads() == 0)
   {
     std::cout << "Error in FFTW multithreading." << "\n";
     return -1;
   }
-  fftw_plan_with_nthreads(4);
+  Fftw<double>::plan_with_nthreads(4);
+  Fftw<float>::plan_with_nthreads(4);
 
   Capture *capture = new Capture(type, fs, fc, path);
   CAPTURE_POINTER = capture;
@@ -138,32 +155,214 @@ int main(int argc, char **argv)
     tree["capture"]["device"], ip_capture, port_capture);
   });
 
+  // run process at selected precision
+  std::string precision;
+  tree["process"]["data"]["precision"] >> precision;
+  if (precision == "float")
+  {
+    run_process<float>(tree, buffer1, buffer2, fs, fc, path, saveIq);
+  }
+  else if (precision == "double")
+  {
+    run_process<double>(tree, buffer1, buffer2, fs, fc, path, saveIq);
+  }
+  else
+  {
+    std::cout << "Error: Precision must be float or double." << "\n";
+    exit(1);
+  }
+  t1.join();
+
+  return 0;
+}
+
+template <typename T>
+void run_process(ryml::Tree &tree, IqData *buffer1, IqData *buffer2, 
+  uint32_t fs, uint32_t fc, std::string path, bool saveIq)
+{
   // set up process CPI
+  double tCpi;
+  tree["process"]["data"]["cpi"] >> tCpi;
   uint32_t nSamples = fs * tCpi;
   IqData *x = new IqData(nSamples);
   IqData *y = new IqData(nSamples);
-  Map<std::complex<double>> *map;
-  std::unique_ptr<Detection> detection;
-  std::unique_ptr<Detection> detection1;
-  std::unique_ptr<Detection> detection2;
+  IqData *yRaw = new IqData(nSamples);
+  Map<std::complex<T>> *map;
+  std::unique_ptr<Detection> detection = std::make_unique<Detection>();
+  std::unique_ptr<Detection> detection1 = std::make_unique<Detection>();
+  std::unique_ptr<Detection> detection2 = std::make_unique<Detection>();
   std::unique_ptr<Track> track;
 
   // set up process ambiguity
   int32_t delayMin, delayMax;
   int32_t dopplerMin, dopplerMax;
+  uint32_t nThreadsAmbiguity, oversample;
+  std::string algorithm;
   bool roundHamming = true;
   tree["process"]["ambiguity"]["delayMin"] >> delayMin;
   tree["process"]["ambiguity"]["delayMax"] >> delayMax;
   tree["process"]["ambiguity"]["dopplerMin"] >> dopplerMin;
   tree["process"]["ambiguity"]["dopplerMax"] >> dopplerMax;
-  Ambiguity *ambiguity = new Ambiguity(delayMin, delayMax, 
-    dopplerMin, dopplerMax, fs, nSamples, roundHamming);
-
-  // set up process clutter
+  tree["process"]["ambiguity"]["nThreads"] >> nThreadsAmbiguity;
+  tree["process"]["ambiguity"]["algorithm"] >> algorithm;
+  tree["process"]["ambiguity"]["oversample"] >> oversample;
+  int32_t roiDelayMin, roiDelayMax;
+  double roiDopplerMin, roiDopplerMax;
+  tree["process"]["ambiguity"]["roiDelayMin"] >> roiDelayMin;
+  tree["process"]["ambiguity"]["roiDelayMax"] >> roiDelayMax;
+  tree["process"]["ambiguity"]["roiDopplerMin"] >> roiDopplerMin;
+  tree["process"]["ambiguity"]["roiDopplerMax"] >> roiDopplerMax;
+  uint32_t nUpdate;
+  tree["process"]["ambiguity"]["nUpdate"] >> nUpdate;
+  std::vector<uint32_t> cpiDivisions;
+  for (size_t i = 0; i < tree["process"]["ambiguity"]["cpiDivisions"].num_children(); i++)
+  {
+    uint32_t division;
+    tree["process"]["ambiguity"]["cpiDivisions"][i] >> division;
+    cpiDivisions.push_back(division);
+  }
   int32_t delayMinClutter, delayMaxClutter;
   tree["process"]["clutter"]["delayMin"] >> delayMinClutter;
   tree["process"]["clutter"]["delayMax"] >> delayMaxClutter;
-  WienerHopf *filter = new WienerHopf(delayMinClutter, delayMaxClutter, nSamples);
+
+  // set up autotune of FFT lengths and FFTW threads
+  bool isAutotune;
+  std::string autotuneProfile;
+  tree["process"]["autotune"]["enable"] >> isAutotune;
+  tree["process"]["autotune"]["profile"] >> autotuneProfile;
+  Autotune<T> *autotune = nullptr;
+  if (isAutotune)
+  {
+    std::string autotuneConfig = std::string(std::is_same_v<T, float> ? "float" : "double") + 
+      "_n" + std::to_string(nSamples) + 
+      "_delay" + std::to_string(delayMin) + ":" + std::to_string(delayMax) + 
+      "_doppler" + std::to_string(dopplerMin) + ":" + std::to_string(dopplerMax) + 
+      "_clutter" + std::to_string(delayMinClutter) + ":" + std::to_string(delayMaxClutter);
+    autotune = new Autotune<T>(autotuneProfile, autotuneConfig, 4);
+    autotune->fft_threads("fftw_threads", nSamples, std::thread::hardware_concurrency());
+    roundHamming = false;
+  }
+
+  AmbiguityEngine<T> *ambiguity;
+  AmbiguitySliding<T> *sliding = nullptr;
+  Ambiguity<T> *batches = nullptr;
+  if (algorithm == "batches")
+  {
+    batches = new Ambiguity<T>(delayMin, delayMax, 
+      dopplerMin, dopplerMax, fs, nSamples, roundHamming, nThreadsAmbiguity, autotune);
+    for (uint32_t division : cpiDivisions)
+    {
+      batches->add_resolution(division);
+    }
+    ambiguity = batches;
+  }
+  else if (algorithm == "direct")
+  {
+    ambiguity = new AmbiguityDirect<T>(delayMin, delayMax, 
+      dopplerMin, dopplerMax, fs, nSamples, oversample, roundHamming, nThreadsAmbiguity);
+  }
+  else if (algorithm == "roi")
+  {
+    ambiguity = new AmbiguityRoi<T>(delayMin, delayMax, 
+      dopplerMin, dopplerMax, fs, nSamples, roiDelayMin, roiDelayMax, 
+      roiDopplerMin, roiDopplerMax, roundHamming, nThreadsAmbiguity, 
+      AmbiguityRoi<T>::Method::Auto, autotune);
+  }
+  else if (algorithm == "sliding")
+  {
+    sliding = new AmbiguitySliding<T>(delayMin, delayMax, 
+      dopplerMin, dopplerMax, fs, nSamples, nUpdate, roundHamming, nThreadsAmbiguity, autotune);
+    ambiguity = sliding;
+  }
+  else
+  {
+    std::cout << "Error: Ambiguity algorithm must be batches, direct, roi or sliding." << "\n";
+    exit(1);
+  }
+  if (!cpiDivisions.empty() && batches == nullptr)
+  {
+    std::cout << "Error: CPI divisions require the batches algorithm." << "\n";
+    exit(1);
+  }
+
+  // set up output of shorter CPI maps
+  std::vector<std::unique_ptr<Socket>> socket_map_division;
+  std::vector<std::unique_ptr<Socket>> socket_detection_division;
+  std::string ip;
+  tree["network"]["ip"] >> ip;
+  for (size_t i = 0; i < cpiDivisions.size(); i++)
+  {
+    uint16_t port_map, port_detection;
+    tree["network"]["ports"]["mapDivisions"][i] >> port_map;
+    tree["network"]["ports"]["detectionDivisions"][i] >> port_detection;
+    try {
+      socket_map_division.push_back(std::make_unique<Socket>(ip, port_map));
+      socket_detection_division.push_back(std::make_unique<Socket>(ip, port_detection));
+    } catch (const std::exception& e) {
+      std::cerr << "Failed to initialize CPI division socket connections: " << e.what() << "\n";
+      exit(1);
+    }
+  }
+
+  // set up process clutter
+  double thresholdClutter, forgetClutter;
+  uint32_t nBatchesClutter, nThreadsClutter;
+  std::string algorithmClutter;
+  tree["process"]["clutter"]["algorithm"] >> algorithmClutter;
+  tree["process"]["clutter"]["threshold"] >> thresholdClutter;
+  tree["process"]["clutter"]["forget"] >> forgetClutter;
+  tree["process"]["clutter"]["nBatches"] >> nBatchesClutter;
+  tree["process"]["clutter"]["nThreads"] >> nThreadsClutter;
+  std::vector<double> dopplerClutter;
+  for (size_t i = 0; i < tree["process"]["clutter"]["doppler"].num_children(); i++)
+  {
+    double doppler;
+    tree["process"]["clutter"]["doppler"][i] >> doppler;
+    dopplerClutter.push_back(doppler);
+  }
+  ClutterFilter<T> *filter;
+  EcaDoppler<T> *ecaDoppler = nullptr;
+  if (algorithmClutter == "wienerhopf")
+  {
+    filter = new WienerHopf<T>(delayMinClutter, delayMaxClutter, 
+      nSamples, autotune, thresholdClutter, forgetClutter);
+  }
+  else if (algorithmClutter == "ecab")
+  {
+    try {
+      filter = new EcaBatches<T>(delayMinClutter, delayMaxClutter, 
+        nSamples, nBatchesClutter, nThreadsClutter, autotune);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << "\n";
+      exit(1);
+    }
+  }
+  else if (algorithmClutter == "ecacd")
+  {
+    try {
+      ecaDoppler = new EcaDoppler<T>(delayMinClutter, delayMaxClutter, 
+        nSamples, fs, dopplerClutter);
+    } catch (const std::exception& e) {
+      std::cerr << "Error: " << e.what() << "\n";
+      exit(1);
+    }
+    filter = ecaDoppler;
+  }
+  else
+  {
+    std::cout << "Error: Clutter algorithm must be wienerhopf, ecab or ecacd." << "\n";
+    exit(1);
+  }
+
+  // report and cache autotune decisions
+  if (autotune != nullptr)
+  {
+    std::cout << autotune->to_string();
+    if (!autotune->save())
+    {
+      std::cerr << "Failed to save autotune profile " << autotuneProfile << "\n";
+    }
+  }
 
   // set up process detection
   double pfa, minDoppler;
@@ -174,13 +373,157 @@ int main(int argc, char **argv)
   tree["process"]["detection"]["nTrain"] >> nTrain;
   tree["process"]["detection"]["minDelay"] >> minDelay;
   tree["process"]["detection"]["minDoppler"] >> minDoppler;
-  CfarDetector1D *cfarDetector1D = new CfarDetector1D(pfa, nGuard, nTrain, minDelay, minDoppler);
+  uint32_t nThreadsDetection;
+  tree["process"]["detection"]["nThreads"] >> nThreadsDetection;
+  std::string algorithmDetection, modeDetection, windowDetection;
+  int32_t nGuardDoppler, nTrainDoppler;
+  double rankDetection;
+  tree["process"]["detection"]["algorithm"] >> algorithmDetection;
+  tree["process"]["detection"]["mode"] >> modeDetection;
+  tree["process"]["detection"]["window"] >> windowDetection;
+  tree["process"]["detection"]["nGuardDoppler"] >> nGuardDoppler;
+  tree["process"]["detection"]["nTrainDoppler"] >> nTrainDoppler;
+  tree["process"]["detection"]["rank"] >> rankDetection;
+  double forgetDetection;
+  std::string backgroundDetection;
+  tree["process"]["detection"]["forget"] >> forgetDetection;
+  tree["process"]["detection"]["background"] >> backgroundDetection;
+
+  // each map size has its own detector, as a clutter map keeps state per cell
+  auto create_detector = [&](std::string background) -> CfarDetector *
+  {
+    if (algorithmDetection == "cfar1d")
+    {
+      return new CfarDetector1D(pfa, nGuard, nTrain, 
+        minDelay, minDoppler, nThreadsDetection);
+    }
+    else if (algorithmDetection == "cfar2d")
+    {
+      CfarDetector2D::Mode mode;
+      CfarDetector2D::Window window;
+      if (modeDetection == "ca")
+      {
+        mode = CfarDetector2D::Mode::Ca;
+      }
+      else if (modeDetection == "go")
+      {
+        mode = CfarDetector2D::Mode::Go;
+      }
+      else if (modeDetection == "so")
+      {
+        mode = CfarDetector2D::Mode::So;
+      }
+      else
+      {
+        std::cout << "Error: Detection mode must be ca, go or so." << "\n";
+        exit(1);
+      }
+      if (windowDetection == "rectangle")
+      {
+        window = CfarDetector2D::Window::Rectangle;
+      }
+      else if (windowDetection == "cross")
+      {
+        window = CfarDetector2D::Window::Cross;
+      }
+      else
+      {
+        std::cout << "Error: Detection window must be rectangle or cross." << "\n";
+        exit(1);
+      }
+      try {
+        return new CfarDetector2D(pfa, nGuard, nGuardDoppler, nTrain, 
+          nTrainDoppler, mode, window, minDelay, minDoppler, nThreadsDetection);
+      } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        exit(1);
+      }
+    }
+    else if (algorithmDetection == "cfaros")
+    {
+      try {
+        return new CfarDetectorOs(pfa, nGuard, nTrain, rankDetection, 
+          minDelay, minDoppler, nThreadsDetection);
+      } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        exit(1);
+      }
+    }
+    else if (algorithmDetection == "cfarmap")
+    {
+      try {
+        return new CfarDetectorClutterMap(pfa, forgetDetection, minDelay, 
+          minDoppler, background);
+      } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        exit(1);
+      }
+    }
+    std::cout << "Error: Detection algorithm must be cfar1d, cfar2d, cfaros or cfarmap." << "\n";
+    exit(1);
+  };
+  CfarDetector *cfarDetector = create_detector(backgroundDetection);
+  std::vector<CfarDetector *> cfarDetectorDivision;
+  for (size_t i = 0; i < cpiDivisions.size(); i++)
+  {
+    cfarDetectorDivision.push_back(create_detector(backgroundDetection.empty() ? 
+      "" : backgroundDetection + "." + std::to_string(cpiDivisions[i])));
+  }
   Interpolate *interpolate = new Interpolate(true, true);
 
   // set up process centroid
   uint16_t nCentroid;
+  std::string modeCentroid;
   tree["process"]["detection"]["nCentroid"] >> nCentroid;
-  Centroid *centroid = new Centroid(nCentroid, nCentroid, 1/tCpi);
+  tree["process"]["detection"]["centroid"] >> modeCentroid;
+  Centroid::Mode centroidMode;
+  if (modeCentroid == "window")
+  {
+    centroidMode = Centroid::Mode::Window;
+  }
+  else if (modeCentroid == "component")
+  {
+    centroidMode = Centroid::Mode::Component;
+  }
+  else
+  {
+    std::cout << "Error: Centroid must be window or component." << "\n";
+    exit(1);
+  }
+  Centroid *centroid = new Centroid(nCentroid, nCentroid, 1/tCpi, centroidMode);
+  std::vector<Centroid *> centroidDivision;
+  for (size_t i = 0; i < cpiDivisions.size(); i++)
+  {
+    centroidDivision.push_back(new Centroid(nCentroid, nCentroid, 
+      1/batches->get_cpi(i + 1), centroidMode));
+  }
+
+  // set up fused detection, reusing the detection storage each CPI
+  bool isFused;
+  tree["process"]["detection"]["fused"] >> isFused;
+  PeakExtractor *peakExtractor = nullptr;
+  std::vector<PeakExtractor *> peakExtractorDivision;
+  std::vector<std::unique_ptr<Detection>> detectionDivision;
+  if (isFused && (algorithmDetection != "cfar1d" || centroidMode != Centroid::Mode::Window))
+  {
+    std::cout << "Error: Fused detection requires cfar1d and window centroid." << "\n";
+    exit(1);
+  }
+  if (isFused)
+  {
+    peakExtractor = new PeakExtractor(pfa, nGuard, nTrain, minDelay, minDoppler, 
+      nCentroid, nCentroid, 1/tCpi, nThreadsDetection);
+  }
+  for (size_t i = 0; i < cpiDivisions.size(); i++)
+  {
+    if (isFused)
+    {
+      peakExtractorDivision.push_back(new PeakExtractor(pfa, nGuard, nTrain, 
+        minDelay, minDoppler, nCentroid, nCentroid, 1/batches->get_cpi(i + 1), 
+        nThreadsDetection));
+    }
+    detectionDivision.push_back(std::make_unique<Detection>());
+  }
 
   // set up process tracker
   uint8_t m, n, nDelete;
@@ -196,7 +539,10 @@ int main(int argc, char **argv)
 
   // set up process spectrum analyser
   double spectrumBandwidth = 2000;
-  SpectrumAnalyser *spectrumAnalyser = new SpectrumAnalyser(nSamples, spectrumBandwidth);
+  SpectrumAnalyser<T> *spectrumAnalyser = new SpectrumAnalyser<T>(nSamples, spectrumBandwidth);
+
+  // set up shared reference spectrum
+  ReferenceSpectrum<T> *referenceSpectrum = new ReferenceSpectrum<T>(nSamples);
 
   // process options
   bool isClutter, isDetection, isTracker;
@@ -247,31 +593,65 @@ int main(int argc, char **argv)
       {
         buffer1->lock();
         buffer2->lock();
-        if ((buffer1->get_length() > nSamples) && (buffer2->get_length() > nSamples))
+        // new samples per update, only a step once a sliding window is full
+        uint32_t nExtract = (sliding != nullptr && x->get_length() == nSamples) ? 
+          sliding->get_n_step() : nSamples;
+        if ((buffer1->get_length() > nExtract) && (buffer2->get_length() > nExtract))
         {
           time.push_back(current_time_us());
           // extract data from buffer
-          for (uint32_t i = 0; i < nSamples; i++)
+          IqData *yExtract = (sliding != nullptr) ? yRaw : y;
+          for (uint32_t i = 0; i < nExtract; i++)
           {
             x->push_back(buffer1->pop_front());
-            y->push_back(buffer2->pop_front());      
+            yExtract->push_back(buffer2->pop_front());      
           }
           buffer1->unlock();
           buffer2->unlock();
+
+          // sliding window keeps unfiltered surveillance for the clutter filter
+          if (sliding != nullptr)
+          {
+            y->clear();
+            for (const auto &sample : yRaw->get_data())
+            {
+              y->push_back(sample);
+            }
+          }
           timing_helper(timing_name, timing_time, time, "extract_buffer");
           
+          // reference spectrum shared by spectrum and clutter filter
+          referenceSpectrum->process(x);
+          timing_helper(timing_name, timing_time, time, "reference_spectrum");
+
           // spectrum
-          spectrumAnalyser->process(x);
+          spectrumAnalyser->process(x, referenceSpectrum);
           timing_helper(timing_name, timing_time, time, "spectrum");
           
           // clutter filter
           if (isClutter)
           {
-            if (!filter->process(x, y))
+            if (!filter->process(x, y, referenceSpectrum))
             {
+              if (sliding != nullptr)
+              {
+                sliding->reset();
+              }
               continue;
             }
             timing_helper(timing_name, timing_time, time, "clutter_filter");
+
+            // per-CPI cost of the Doppler-extended clutter filter stages
+            if (ecaDoppler != nullptr)
+            {
+              typename EcaDoppler<T>::Cost cost = ecaDoppler->get_cost();
+              timing_name.push_back("clutter_correlation");
+              timing_time.push_back(cost.correlation);
+              timing_name.push_back("clutter_solve");
+              timing_time.push_back(cost.solve);
+              timing_name.push_back("clutter_apply");
+              timing_time.push_back(cost.filter);
+            }
           }
           
           // ambiguity process
@@ -282,9 +662,16 @@ int main(int argc, char **argv)
           // detection process
           if (isDetection)
           {
-            detection1 = cfarDetector1D->process(map);
-            detection2 = centroid->process(detection1.get());
-            detection = interpolate->process(detection2.get(), map);
+            if (isFused)
+            {
+              peakExtractor->process(map, detection.get());
+            }
+            else
+            {
+              cfarDetector->process(map, detection1.get());
+              centroid->process(detection1.get(), detection2.get());
+              interpolate->process(detection2.get(), map, detection.get());
+            }
             timing_helper(timing_name, timing_time, time, "detector");
           }
 
@@ -330,6 +717,36 @@ int main(int argc, char **argv)
           // output radar data timer
           timing_helper(timing_name, timing_time, time, "output_radar_data");
 
+          // shorter CPI maps, each with its own detection and output
+          if (!cpiDivisions.empty())
+          {
+            for (uint32_t i = 0; i < cpiDivisions.size(); i++)
+            {
+              Map<std::complex<T>> *mapDivision = batches->get_map(i + 1);
+              mapDivision->set_metrics();
+              mapJson = mapDivision->to_json(time[0]/1000);
+              mapJson = mapDivision->delay_bin_to_km(mapJson, fs);
+              socket_map_division[i]->sendData(mapJson);
+              if (isDetection)
+              {
+                if (isFused)
+                {
+                  peakExtractorDivision[i]->process(mapDivision, detectionDivision[i].get());
+                }
+                else
+                {
+                  cfarDetectorDivision[i]->process(mapDivision, detection1.get());
+                  centroidDivision[i]->process(detection1.get(), detection2.get());
+                  interpolate->process(detection2.get(), mapDivision, detectionDivision[i].get());
+                }
+                detectionJson = detectionDivision[i]->to_json(time[0]/1000);
+                detectionJson = detectionDivision[i]->delay_bin_to_km(detectionJson, fs);
+                socket_detection_division[i]->sendData(detectionJson);
+              }
+            }
+            timing_helper(timing_name, timing_time, time, "cpi_divisions");
+          }
+
           // cpi timer
           time.push_back(current_time_us());
           double delta_ms = (double)(time.back()-time[0]) / 1000;
@@ -360,9 +777,6 @@ int main(int argc, char **argv)
       }
     });
   t2.join();
-  t1.join();
-
-  return 0;
 }
 
 void signal_callback_handler(int signum) {
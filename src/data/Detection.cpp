@@ -3,6 +3,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <chrono>
+#include <utility>
 
 #include "rapidjson/document.h"
 #include "rapidjson/writer.h"
@@ -10,11 +11,25 @@
 #include "rapidjson/filewritestream.h"
 
 // constructor
+Detection::Detection()
+{
+}
+
 Detection::Detection(std::vector<double> _delay, std::vector<double> _doppler, std::vector<double> _snr)
 {
-  delay = _delay;
-  doppler = _doppler;
-  snr = _snr;
+  delay = std::move(_delay);
+  doppler = std::move(_doppler);
+  snr = std::move(_snr);
+}
+
+Detection::Detection(std::vector<double> _delay, std::vector<double> _doppler, 
+  std::vector<double> _snr, std::vector<int32_t> _delayBin, std::vector<int32_t> _dopplerBin)
+{
+  delay = std::move(_delay);
+  doppler = std::move(_doppler);
+  snr = std::move(_snr);
+  delayBin = std::move(_delayBin);
+  dopplerBin = std::move(_dopplerBin);
 }
 
 Detection::Detection(double _delay, double _doppler, double _snr)
@@ -24,22 +39,77 @@ Detection::Detection(double _delay, double _doppler, double _snr)
   snr.push_back(_snr);
 }
 
-std::vector<double> Detection::get_delay()
+const std::vector<double> &Detection::get_delay() const
 {
   return delay;
 }
 
-std::vector<double> Detection::get_doppler()
+const std::vector<double> &Detection::get_doppler() const
 {
   return doppler;
 }
 
-std::vector<double> Detection::get_snr()
+const std::vector<double> &Detection::get_snr() const
 {
   return snr;
 }
 
-size_t Detection::get_nDetections()
+Plot Detection::get_plot(size_t i) const
+{
+  return {delay[i], doppler[i], snr[i]};
+}
+
+const std::vector<int32_t> &Detection::get_delay_bin() const
+{
+  return delayBin;
+}
+
+const std::vector<int32_t> &Detection::get_doppler_bin() const
+{
+  return dopplerBin;
+}
+
+bool Detection::has_bin() const
+{
+  return delayBin.size() == delay.size() && dopplerBin.size() == delay.size();
+}
+
+void Detection::clear()
+{
+  delay.clear();
+  doppler.clear();
+  snr.clear();
+  delayBin.clear();
+  dopplerBin.clear();
+}
+
+void Detection::reserve(size_t n)
+{
+  delay.reserve(n);
+  doppler.reserve(n);
+  snr.reserve(n);
+  delayBin.reserve(n);
+  dopplerBin.reserve(n);
+}
+
+void Detection::push_back(double _delay, double _doppler, double _snr, 
+  int32_t _delayBin, int32_t _dopplerBin)
+{
+  delay.push_back(_delay);
+  doppler.push_back(_doppler);
+  snr.push_back(_snr);
+  delayBin.push_back(_delayBin);
+  dopplerBin.push_back(_dopplerBin);
+}
+
+void Detection::push_back(double _delay, double _doppler, double _snr)
+{
+  delay.push_back(_delay);
+  doppler.push_back(_doppler);
+  snr.push_back(_snr);
+}
+
+size_t Detection::get_nDetections() const
 {
   return delay.size();
 }
@@ -1,11 +1,14 @@
 /// @file Detection.h
 /// @class Detection
 /// @brief A class to store detection data.
+/// @details Stored as a structure of arrays. Storage is kept on clear so a list can be refilled each CPI without allocating.
 /// @author 30hours
 
 #ifndef DETECTION_H
 #define DETECTION_H
 
+#include "data/Plot.h"
+
 #include <stdint.h>
 #include <vector>
 #include <complex>
@@ -22,13 +25,33 @@ private:
   /// @brief Detections in SNR.
   std::vector<double> snr;
 
+  /// @brief Map column index of each detection, empty if unknown.
+  std::vector<int32_t> delayBin;
+
+  /// @brief Map row index of each detection, empty if unknown.
+  std::vector<int32_t> dopplerBin;
+
 public:
+  /// @brief Constructor for no detections.
+  /// @return The object.
+  Detection();
+
   /// @brief Constructor.
   /// @param delay Detections in delay (bins).
   /// @param doppler Detections in Doppler (Hz).
   /// @return The object.
   Detection(std::vector<double> delay, std::vector<double> doppler, std::vector<double> snr);
 
+  /// @brief Constructor with map indices.
+  /// @param delay Detections in delay (bins).
+  /// @param doppler Detections in Doppler (Hz).
+  /// @param snr Detections in SNR.
+  /// @param delayBin Map column index of each detection.
+  /// @param dopplerBin Map row index of each detection.
+  /// @return The object.
+  Detection(std::vector<double> delay, std::vector<double> doppler, std::vector<double> snr, 
+    std::vector<int32_t> delayBin, std::vector<int32_t> dopplerBin);
+
   /// @brief Constructor for single detection.
   /// @param delay Detection in delay (bins).
   /// @param doppler Detection in Doppler (Hz).
@@ -37,19 +60,61 @@ public:
 
   /// @brief Get detections in delay.
   /// @return Detections in delay (bins).
-  std::vector<double> get_delay();
+  const std::vector<double> &get_delay() const;
 
   /// @brief Get detections in Doppler.
   /// @return Detections in Doppler (Hz).
-  std::vector<double> get_doppler();
+  const std::vector<double> &get_doppler() const;
 
   /// @brief Detections in SNR.
   /// @return Detections in SNR.
-  std::vector<double> get_snr();
+  const std::vector<double> &get_snr() const;
+
+  /// @brief Get a single detection.
+  /// @param i Index of detection.
+  /// @return Detection as a plot.
+  Plot get_plot(size_t i) const;
+
+  /// @brief Get map column index of detections.
+  /// @return Map column indices, empty if unknown.
+  const std::vector<int32_t> &get_delay_bin() const;
+
+  /// @brief Get map row index of detections.
+  /// @return Map row indices, empty if unknown.
+  const std::vector<int32_t> &get_doppler_bin() const;
+
+  /// @brief Check the detections carry map indices.
+  /// @return True if every detection has a map index.
+  bool has_bin() const;
+
+  /// @brief Remove all detections, keeping the storage for reuse.
+  /// @return Void.
+  void clear();
+
+  /// @brief Reserve storage for a number of detections with map indices.
+  /// @param n Number of detections.
+  /// @return Void.
+  void reserve(size_t n);
+
+  /// @brief Append a detection with map indices.
+  /// @param delay Detection in delay (bins).
+  /// @param doppler Detection in Doppler (Hz).
+  /// @param snr Detection in SNR.
+  /// @param delayBin Map column index of detection.
+  /// @param dopplerBin Map row index of detection.
+  /// @return Void.
+  void push_back(double delay, double doppler, double snr, int32_t delayBin, int32_t dopplerBin);
+
+  /// @brief Append a detection without map indices.
+  /// @param delay Detection in delay (bins).
+  /// @param doppler Detection in Doppler (Hz).
+  /// @param snr Detection in SNR.
+  /// @return Void.
+  void push_back(double delay, double doppler, double snr);
 
   /// @brief Get number of detections.
   /// @return Number of detections
-  size_t get_nDetections();
+  size_t get_nDetections() const;
 
   /// @brief Generate JSON of the detections and metadata.
   /// @param timestamp Current time (POSIX ms).
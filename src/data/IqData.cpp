@@ -1,6 +1,7 @@
 #include "IqData.h"
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 
 #include "rapidjson/document.h"
 #include "rapidjson/writer.h"
@@ -61,6 +62,15 @@ std::complex<double> IqData::pop_front()
   data->pop_front();
   return sample;
 }
+
+void IqData::copy(std::complex<double> *out, uint32_t _n, uint32_t offset)
+{
+  if (data->size() < (size_t)offset + _n) {
+    throw std::runtime_error("Attempting to copy more samples than stored");
+  }
+  std::copy_n(data->begin() + offset, _n, out);
+}
+
 void IqData::print()
 {
   int n = data->size();
@@ -85,6 +95,11 @@ void IqData::update_spectrum(std::vector<std::complex<double>> _spectrum)
   spectrum = _spectrum;
 }
 
+std::vector<std::complex<double>> IqData::get_spectrum()
+{
+  return spectrum;
+}
+
 void IqData::update_frequency(std::vector<double> _frequency)
 {
   frequency = _frequency;
@@ -75,6 +75,13 @@ public:
   /// @return Sample from the front of the queue.
   std::complex<double> pop_front();
 
+  /// @brief Copy samples from the front of the queue without removing them.
+  /// @param out Destination of at least n samples.
+  /// @param n Number of samples to copy.
+  /// @param offset Number of samples to skip from the front.
+  /// @return Void.
+  void copy(std::complex<double> *out, uint32_t n, uint32_t offset = 0);
+
   /// @brief Print to stdout (debug).
   /// @return Void.
   void print();
@@ -88,6 +95,10 @@ public:
   /// @return Void.
   void update_spectrum(std::vector<std::complex<double>> spectrum);
 
+  /// @brief Getter for spectrum.
+  /// @return Spectrum vector.
+  std::vector<std::complex<double>> get_spectrum();
+
   /// @brief Update the time differences and names.
   /// @param frequency Frequency vector.
   /// @return Void.
@@ -1,72 +1,82 @@
 #include "Map.h"
 #include "data/meta/Constants.h"
+#include "data/meta/FastLog.h"
 #include <iostream>
 #include <cstdlib>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 
 #include "rapidjson/document.h"
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/filewritestream.h"
 
+template <class T>
+const uint32_t Map<T>::TRANSPOSE_BLOCK = 32;
+
 // constructor
 template <class T>
 Map<T>::Map(uint32_t _nRows, uint32_t _nCols)
 {
   nRows = _nRows;
   nCols = _nCols;
-  std::vector<std::vector<T>> tmp(nRows, std::vector<T>(nCols, {1}));
-  data = tmp;
+  isStale = true;
+  data.assign((size_t)nRows * nCols, T{1});
 }
 
 template <class T>
-void Map<T>::set_row(uint32_t i, std::vector<T> row)
+void Map<T>::set_row(uint32_t i, const std::vector<T> &row)
 {
-  //data[i].swap(row);
-  for (uint32_t j = 0; j < nCols; j++)
-  {
-    data[i][j] = row[j];
-  }
+  std::copy(row.begin(), row.begin() + nCols, data.begin() + (size_t)i * nCols);
+  isStale = true;
 }
 
 template <class T>
-void Map<T>::set_col(uint32_t i, std::vector<T> col)
+void Map<T>::set_col(uint32_t i, const std::vector<T> &col)
 {
+  MapView<T> view = get_col(i);
   for (uint32_t j = 0; j < nRows; j++)
   {
-    data[j][i] = col[j];
+    view[j] = col[j];
   }
 }
 
 template <class T>
-uint32_t Map<T>::get_nRows()
-{
-  return nRows;
-}
-
-template <class T>
-uint32_t Map<T>::get_nCols()
+void Map<T>::transpose(Map<T> *out)
 {
-  return nCols;
+  T *in = data.data();
+  T *dest = out->data.data();
+  out->mark_stale();
+  for (uint32_t i0 = 0; i0 < nRows; i0 += TRANSPOSE_BLOCK)
+  {
+    uint32_t i1 = std::min(i0 + TRANSPOSE_BLOCK, nRows);
+    for (uint32_t j0 = 0; j0 < nCols; j0 += TRANSPOSE_BLOCK)
+    {
+      uint32_t j1 = std::min(j0 + TRANSPOSE_BLOCK, nCols);
+      for (uint32_t i = i0; i < i1; i++)
+      {
+        for (uint32_t j = j0; j < j1; j++)
+        {
+          dest[(size_t)j * nRows + i] = in[(size_t)i * nCols + j];
+        }
+      }
+    }
+  }
 }
 
 template <class T>
-std::vector<T> Map<T>::get_row(uint32_t row)
+uint32_t Map<T>::get_nRows() const
 {
-  return data[row];
+  return nRows;
 }
 
 template <class T>
-std::vector<T> Map<T>::get_col(uint32_t col)
+uint32_t Map<T>::get_nCols() const
 {
-  std::vector<T> colData;
-
-  for (uint32_t i = 0; i < nRows; i++)
-  {
-    colData.push_back(data[i][col]);
-  }
-
-  return colData;
+  return nCols;
 }
 
 template <class T>
@@ -78,7 +88,7 @@ Map<double> *Map<T>::get_map_db()
   {
     for (uint32_t j = 0; j < nCols; j++)
     {
-      map->data[i][j] = (double)10 * std::log10(std::abs(data[i][j]));
+      map->at(i, j) = (double)10 * std::log10(std::abs(data[(size_t)i * nCols + j]));
     }
   }
 
@@ -92,7 +102,7 @@ void Map<T>::print()
   {
     for (uint32_t j = 0; j < nCols; j++)
     {
-      std::cout << data[i][j];
+      std::cout << data[(size_t)i * nCols + j];
       std::cout << " ";
     }
     std::cout << std::endl;
@@ -100,16 +110,35 @@ void Map<T>::print()
 }
 
 template <class T>
-uint32_t Map<T>::doppler_hz_to_bin(double dopplerHz)
+int32_t Map<T>::doppler_hz_to_bin(double dopplerHz) const
 {
-  for (size_t i = 0; i < doppler.size(); i++)
+  if (doppler.empty())
   {
-    if (dopplerHz == doppler[i])
-    {
-      return (int) i;
-    }
+    return -1;
+  }
+  double step = doppler.size() > 1 ? doppler[1] - doppler[0] : 0;
+  double index = step != 0 ? std::round((dopplerHz - doppler[0]) / step) : 0;
+  if (!(index >= 0 && index < (double)doppler.size()) || 
+    std::abs(dopplerHz - doppler[(size_t)index]) > std::abs(step) / 2)
+  {
+    return -1;
   }
-  return 0;
+  return (int32_t)index;
+}
+
+template <class T>
+int32_t Map<T>::delay_to_bin(double delayBin) const
+{
+  if (delay.empty())
+  {
+    return -1;
+  }
+  double index = std::round(delayBin - delay[0]);
+  if (!(index >= 0 && index < (double)delay.size()))
+  {
+    return -1;
+  }
+  return (int32_t)index;
 }
 
 template <class T>
@@ -119,14 +148,19 @@ std::string Map<T>::to_json(uint64_t timestamp)
   document.SetObject();
   rapidjson::Document::AllocatorType &allocator = document.GetAllocator();
 
-  // store data array
+  // store data array from the level plane
+  if (!has_planes())
+  {
+    set_metrics();
+  }
   rapidjson::Value array(rapidjson::kArrayType);
-  for (size_t i = 0; i < data.size(); i++)
+  for (uint32_t i = 0; i < nRows; i++)
   {
     rapidjson::Value subarray(rapidjson::kArrayType);
-    for (size_t j = 0; j < data[i].size(); j++)
+    const Real *row = level.data() + (size_t)i * nCols;
+    for (uint32_t j = 0; j < nCols; j++)
     {
-      subarray.PushBack(10 * std::log10(std::abs(data[i][j])) - noisePower, document.GetAllocator());
+      subarray.PushBack((double)row[j] - noisePower, document.GetAllocator());
     }
     array.PushBack(subarray, document.GetAllocator());
   }
@@ -187,22 +221,60 @@ std::string Map<T>::delay_bin_to_km(std::string json, uint32_t fs)
 template <class T>
 void Map<T>::set_metrics()
 {
+  size_t n = data.size();
+  power.resize(n);
+  level.resize(n);
+  Real *p = power.data();
+  Real *l = level.data();
+  if constexpr (std::is_same_v<Real, float>)
+  {
+    // power and level planes in one branch-free pass
+    bool isNormal = true;
+    for (size_t i = 0; i < n; i++)
+    {
+      float re = std::real(data[i]);
+      float im = std::imag(data[i]);
+      p[i] = re * re + im * im;
+      l[i] = 5 * FastLog::log10(p[i]);
+      isNormal &= (p[i] >= std::numeric_limits<float>::min()) && 
+        (p[i] <= std::numeric_limits<float>::max());
+    }
+
+    // zero, denormal, infinite or NaN power falls back to the exact level
+    if (!isNormal)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        if (!(p[i] >= std::numeric_limits<float>::min() && 
+          p[i] <= std::numeric_limits<float>::max()))
+        {
+          l[i] = 10 * std::log10(std::abs(data[i]));
+        }
+      }
+    }
+  }
+  else
+  {
+    // exact planes as the detectors computed per cell
+    for (size_t i = 0; i < n; i++)
+    {
+      p[i] = std::abs(data[i] * data[i]);
+      l[i] = 10 * std::log10(std::abs(data[i]));
+    }
+  }
+
   // get map noise level
-  double value;
   double noisePower = 0;
   double maxPower = 0;
-  for (uint32_t i = 0; i < nRows; i++)
+  for (size_t i = 0; i < n; i++)
   {
-    for (uint32_t j = 0; j < nCols; j++)
-    {
-      value = 10 * std::log10(std::abs(data[i][j]));
-      noisePower = noisePower + value;
-      maxPower = (maxPower < value) ? value : maxPower;
-    }
+    noisePower = noisePower + l[i];
+    maxPower = (maxPower < l[i]) ? l[i] : maxPower;
   }
   noisePower = noisePower / (nRows * nCols);
   this->noisePower = noisePower;
   this->maxPower = maxPower - noisePower;
+  isStale = false;
 }
 
 template <class T>
@@ -263,4 +335,6 @@ bool Map<T>::save(std::string _json, std::string filename)
 
 // allowed types
 template class Map<std::complex<double>>;
+template class Map<std::complex<float>>;
 template class Map<double>;
+template class Map<float>;
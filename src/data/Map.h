@@ -9,15 +9,66 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include "data/meta/AlignedAllocator.h"
+
 #include <stdint.h>
 #include <vector>
 #include <deque>
 #include <complex>
+#include <string>
+#include <utility>
+
+/// @class MapView
+/// @brief A non-owning strided view of a map row or column.
+/// @details Rows have unit stride and columns have a stride of the number of columns.
+/// The view is invalidated if the map is destroyed.
+template <typename T>
+class MapView
+{
+private:
+  /// @brief Pointer to first element.
+  T *ptr;
+
+  /// @brief Number of elements.
+  uint32_t n;
+
+  /// @brief Distance between elements.
+  uint32_t stride;
+
+public:
+  /// @brief Constructor.
+  /// @param ptr Pointer to first element.
+  /// @param n Number of elements.
+  /// @param stride Distance between elements.
+  /// @return The object.
+  MapView(T *ptr, uint32_t n, uint32_t stride) : ptr(ptr), n(n), stride(stride) {}
+
+  /// @brief Access an element of the view.
+  /// @param i Index of element.
+  /// @return Reference to element.
+  T &operator[](uint32_t i) const { return ptr[(size_t)i * stride]; }
+
+  /// @brief Get the number of elements in the view.
+  /// @return Number of elements.
+  uint32_t size() const { return n; }
+
+  /// @brief Get the distance between elements.
+  /// @return Stride of view.
+  uint32_t get_stride() const { return stride; }
+
+  /// @brief Get a pointer to the first element.
+  /// @return Pointer to first element.
+  T *data() const { return ptr; }
+};
 
 template <typename T>
 
 class Map
 {
+public:
+  /// @brief Real type of the map cells, the precision of the power and level planes.
+  using Real = decltype(std::real(std::declval<T>()));
+
 private:
   /// @brief Number of rows.
   uint32_t nRows;
@@ -25,9 +76,18 @@ private:
   /// @brief Number of columns.
   uint32_t nCols;
 
+  /// @brief True if the data may have changed since set_metrics.
+  /// @details Set by every writable accessor, cleared by set_metrics.
+  bool isStale;
+
+  /// @brief Block size for cache-blocked transpose.
+  static const uint32_t TRANSPOSE_BLOCK;
+
 public:
   /// @brief Map data to store.
-  std::vector<std::vector<T>> data;
+  /// @details Row-major in one aligned contiguous buffer.
+  /// Writing here directly must be followed by mark_stale, prefer at, get_row or get_col.
+  std::vector<T, AlignedAllocator<T>> data;
 
   /// @brief Delay units of map data (bins).
   std::deque<int> delay;
@@ -41,45 +101,93 @@ public:
   /// @brief Dynamic range of map (dB).
   double maxPower;
 
+  /// @brief Power of each cell |x|^2, row-major.
+  /// @details Computed with the level by set_metrics in the map precision, read by detection.
+  std::vector<Real, AlignedAllocator<Real>> power;
+
+  /// @brief Level of each cell 10 log10|x| (dB), row-major.
+  /// @details Computed with the power by set_metrics in the map precision, read by detection and to_json.
+  std::vector<Real, AlignedAllocator<Real>> level;
+
   /// @brief Constructor.
   /// @param nRows Number of rows.
   /// @param nCols Number of columns.
   /// @return The object.
   Map(uint32_t nRows, uint32_t nCols);
 
+  /// @brief Access a cell of the 2D map for writing.
+  /// @details Marks the power and level planes stale.
+  /// @param i Index of row.
+  /// @param j Index of column.
+  /// @return Reference to cell.
+  T &at(uint32_t i, uint32_t j) { isStale = true; return data[(size_t)i * nCols + j]; }
+
+  /// @brief Access a cell of the 2D map.
+  /// @param i Index of row.
+  /// @param j Index of column.
+  /// @return Const reference to cell.
+  const T &at(uint32_t i, uint32_t j) const { return data[(size_t)i * nCols + j]; }
+
   /// @brief Update a row in the 2D map.
   /// @param i Index of row to update.
   /// @param row Data to update.
   /// @return Void.
-  void set_row(uint32_t i, std::vector<T> row);
+  void set_row(uint32_t i, const std::vector<T> &row);
 
   /// @brief Update a column in the 2D map.
   /// @param i Index of column to update.
   /// @param col Data to update.
   /// @return Void.
-  void set_col(uint32_t i, std::vector<T> col);
+  void set_col(uint32_t i, const std::vector<T> &col);
+
+  /// @brief Transpose the map into another map.
+  /// @details Cache-blocked to keep both reads and writes local.
+  /// @param out Map of size nCols by nRows to store result.
+  /// @return Void.
+  void transpose(Map<T> *out);
 
   /// @brief Create map metrics (noise power, dynamic range).
+  /// @details Computes the power and level planes in one pass, then the metrics from the level.
+  /// Double maps use |x.x| and the exact log10 as the detectors did per cell, so double detection is unchanged.
+  /// Float maps use |x|^2 and FastLog, within 1e-4 dB of the exact level.
   /// @return Void.
   void set_metrics();
 
+  /// @brief Check the power and level planes are current.
+  /// @return True if set_metrics has been called since the data was last written.
+  bool has_planes() const { return !isStale && power.size() == data.size() && level.size() == data.size(); }
+
+  /// @brief Mark the power and level planes stale after writing data directly.
+  /// @return Void.
+  void mark_stale() { isStale = true; }
+
   /// @brief Get the number of rows in the map.
   /// @return Number of rows.
-  uint32_t get_nRows();
+  uint32_t get_nRows() const;
 
   /// @brief Get the number of columns in the map.
   /// @return Number of columns.
-  uint32_t get_nCols();
+  uint32_t get_nCols() const;
 
-  /// @brief Get a row from the 2D map.
+  /// @brief Get a row from the 2D map for writing.
+  /// @details Marks the power and level planes stale.
   /// @param row Index of row to get.
-  /// @return Vector of data.
-  std::vector<T> get_row(uint32_t row);
-
-  /// @brief Get a column from the 2D map.
+  /// @return Non-owning view of row.
+  MapView<T> get_row(uint32_t row)
+  {
+    isStale = true;
+    return MapView<T>(data.data() + (size_t)row * nCols, nCols, 1);
+  }
+
+  /// @brief Get a column from the 2D map for writing.
+  /// @details Marks the power and level planes stale.
   /// @param col Index of column to get.
-  /// @return Vector of data.
-  std::vector<T> get_col(uint32_t col);
+  /// @return Non-owning view of column.
+  MapView<T> get_col(uint32_t col)
+  {
+    isStale = true;
+    return MapView<T>(data.data() + col, nRows, nCols);
+  }
 
   /// @brief Get a copy of the map in dB units.
   /// @return Pointer to dB map.
@@ -89,10 +197,17 @@ public:
   /// @return Void.
   void print();
 
-  /// @brief Convert a Doppler value from Hz to bins.
+  /// @brief Convert a Doppler value from Hz to a row index.
+  /// @details O(1) from the regular Doppler axis, rounding to the nearest row.
   /// @param dopplerHz Doppler value (Hz).
-  /// @return dopplerBin Doppler value (bins).
-  uint32_t doppler_hz_to_bin(double dopplerHz);
+  /// @return Row index, or -1 if outside the map.
+  int32_t doppler_hz_to_bin(double dopplerHz) const;
+
+  /// @brief Convert a delay value from bins to a column index.
+  /// @details O(1) from the regular delay axis, rounding to the nearest column.
+  /// @param delayBin Delay value (bins).
+  /// @return Column index, or -1 if outside the map.
+  int32_t delay_to_bin(double delayBin) const;
 
   /// @brief Generate JSON of the map and metadata.
   /// @return JSON string.
@@ -0,0 +1,22 @@
+/// @file Plot.h
+/// @struct Plot
+/// @brief A single detection in delay and Doppler.
+/// @details A value type for one detection, so track positions, predictions and histories are stored inline without their own vectors.
+/// @author 30hours
+
+#ifndef PLOT_H
+#define PLOT_H
+
+struct Plot
+{
+  /// @brief Delay (bins).
+  double delay;
+
+  /// @brief Doppler (Hz).
+  double doppler;
+
+  /// @brief SNR (dB).
+  double snr;
+};
+
+#endif
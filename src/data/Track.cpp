@@ -38,7 +38,7 @@ void Track::set_state(uint64_t index, std::string _state)
   state.at(index).push_back(_state);
 }
 
-void Track::set_current(uint64_t index, Detection smoothed)
+void Track::set_current(uint64_t index, const Plot &smoothed)
 {
   current.at(index) = smoothed;
   associated.at(index).push_back(smoothed);
@@ -72,7 +72,7 @@ uint64_t Track::get_n()
   return id.size();
 }
 
-Detection Track::get_current(uint64_t index)
+Plot Track::get_current(uint64_t index)
 {
   return current.at(index);
 }
@@ -92,7 +92,7 @@ uint64_t Track::get_nInactive(uint64_t index)
   return nInactive.at(index);
 }
 
-uint64_t Track::add(Detection initial)
+uint64_t Track::add(const Plot &initial)
 {
   id.push_back(uint2hex(iNext));
   std::vector<std::string> _state;
@@ -100,7 +100,7 @@ uint64_t Track::add(Detection initial)
   state.push_back(_state);
   current.push_back(initial);
   acceleration.push_back(0);
-  std::vector<Detection> _associated;
+  std::vector<Plot> _associated;
   _associated.push_back(initial);
   associated.push_back(_associated);
   nInactive.push_back(0);
@@ -167,6 +167,12 @@ void Track::remove(uint64_t index)
   } else {
     throw std::out_of_range("Index out of bounds for 'associated' vector");
   }
+
+  if (index < nInactive.size()) {
+    nInactive.erase(nInactive.begin() + index);
+  } else {
+    throw std::out_of_range("Index out of bounds for 'nInactive' vector");
+  }
 }
 
 std::string Track::to_json(uint64_t timestamp)
@@ -188,10 +194,10 @@ std::string Track::to_json(uint64_t timestamp)
         state.at(i).at(state.at(i).size()-1).c_str(), 
         document.GetAllocator()).Move(), document.GetAllocator());
       object1.AddMember("delay", 
-        current.at(i).get_delay().at(0),
+        current.at(i).delay,
         document.GetAllocator());
       object1.AddMember("doppler", 
-        current.at(i).get_doppler().at(0), 
+        current.at(i).doppler, 
         document.GetAllocator());
       object1.AddMember("acceleration", 
         acceleration.at(i), document.GetAllocator());
@@ -202,9 +208,9 @@ std::string Track::to_json(uint64_t timestamp)
       rapidjson::Value associatedState(rapidjson::kArrayType);
       for (size_t j = 0; j < associated.at(i).size(); j++)
       {
-        associatedDelay.PushBack(associated.at(i).at(j).get_delay().at(0), 
+        associatedDelay.PushBack(associated.at(i).at(j).delay, 
           document.GetAllocator());
-        associatedDoppler.PushBack(associated.at(i).at(j).get_doppler().at(0), 
+        associatedDoppler.PushBack(associated.at(i).at(j).doppler, 
           document.GetAllocator());
         associatedState.PushBack(rapidjson::Value(state.at(i).at(j).c_str(), 
           document.GetAllocator()).Move(), document.GetAllocator());
@@ -15,7 +15,7 @@
 #ifndef TRACK_H
 #define TRACK_H
 
-#include "data/Detection.h"
+#include "data/Plot.h"
 
 #include <stdint.h>
 #include <vector>
@@ -32,13 +32,13 @@ private:
   std::vector<std::vector<std::string>> state;
 
   /// @brief Curent track position.
-  std::vector<Detection> current;
+  std::vector<Plot> current;
 
   /// @brief Current acceleration (Hz/s).
   std::vector<double> acceleration;
 
   /// @brief Associated detections in track.
-  std::vector<std::vector<Detection>> associated;
+  std::vector<std::vector<Plot>> associated;
 
   /// @brief Number of updates the track has been tentative/coasting.
   /// @details Forms criteria for track deletion.
@@ -88,7 +88,7 @@ public:
   /// @param index Index of track to change.
   /// @param smoothed Updated state.
   /// @return Void.
-  void set_current(uint64_t index, Detection smoothed);
+  void set_current(uint64_t index, const Plot &smoothed);
 
   /// @brief Set the current acceleration.
   /// @param index Index of track to change.
@@ -112,8 +112,8 @@ public:
   uint64_t get_n();
 
   /// @brief Get current track position for track index.
-  /// @return Current detection.
-  Detection get_current(uint64_t index);
+  /// @return Current plot.
+  Plot get_current(uint64_t index);
 
   /// @brief Get current acceleration for track index.
   /// @return Current acceleration (Hz/s).
@@ -131,14 +131,14 @@ public:
   /// @param index Index of track to change.
   /// @param update New associated detection.
   /// @return Void.
-  void update(uint64_t index, Detection update);
+  void update(uint64_t index, const Plot &update);
 
   /// @brief Add track to the track set.
-  /// @param initial Initial Detection.
+  /// @param initial Initial plot.
   /// @details ID is incremented automatically. 
   /// @details Initial state is always TENTATIVE.
   /// @return Index of last track.
-  uint64_t add(Detection initial);
+  uint64_t add(const Plot &initial);
 
   /// @brief Promote track to state ACTIVE if applicable.
   /// @details Uses M of N rule for ACTIVE tracks.
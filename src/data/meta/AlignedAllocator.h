@@ -0,0 +1,59 @@
+/// @file AlignedAllocator.h
+/// @class AlignedAllocator
+/// @brief An allocator for over-aligned contiguous storage.
+/// @details Aligns the start of a buffer to a cache line so rows can be loaded with aligned SIMD instructions.
+/// @author 30hours
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept {}
+
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+  /// @brief Allocate aligned storage.
+  /// @param n Number of elements.
+  /// @return Pointer to storage.
+  T *allocate(std::size_t n)
+  {
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  /// @brief Free aligned storage.
+  /// @param p Pointer to storage.
+  /// @return Void.
+  void deallocate(T *p, std::size_t) noexcept
+  {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept
+  {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept
+  {
+    return false;
+  }
+};
+
+#endif
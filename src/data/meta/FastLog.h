@@ -0,0 +1,46 @@
+/// @file FastLog.h
+/// @brief Fast logarithm for whole-map conversion to dB.
+/// @details Splits the float into exponent and mantissa, and evaluates the mantissa by the
+/// <a href="https://en.wikipedia.org/wiki/Logarithm#Power_series">atanh series</a> of ln,
+/// which is branch-free so a loop over a map vectorises.
+/// Only valid for normal positive floats, other values must be handled by the caller.
+/// Accurate to a few float ulp of the result, below 1e-4 dB over the float range.
+/// @author 30hours
+
+#ifndef FASTLOG_H
+#define FASTLOG_H
+
+#include <stdint.h>
+#include <cstring>
+
+namespace FastLog
+{
+  /// @brief Fast log10 of a normal positive float.
+  /// @param x Input value.
+  /// @return log10(x).
+  inline float log10(float x)
+  {
+    // x = m 2^e with m in [1, 2)
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float e = (float)((int32_t)(bits >> 23) - 127);
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+
+    // fold m to [sqrt(1/2), sqrt(2)) so the series converges quickly
+    bool isHigh = m > 1.41421356f;
+    m = isHigh ? 0.5f * m : m;
+    e = isHigh ? e + 1.0f : e;
+
+    // ln(m) = 2 atanh(t) with t = (m - 1) / (m + 1), |t| < 0.172
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float ln = 2.0f * t * (1.0f + t2 * (1.0f / 3 + t2 * (1.0f / 5 + t2 * (1.0f / 7))));
+
+    // log10(x) = (e ln(2) + ln(m)) / ln(10)
+    return (e * 0.693147181f + ln) * 0.434294482f;
+  }
+}
+
+#endif
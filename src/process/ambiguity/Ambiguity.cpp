@@ -6,195 +6,198 @@
 #include <numeric>
 #include <math.h>
 #include <chrono>
+#include <algorithm>
 
 // constructor
-Ambiguity::Ambiguity(int32_t _delayMin, int32_t _delayMax, 
+template <typename T>
+Ambiguity<T>::Ambiguity(int32_t _delayMin, int32_t _delayMax, 
   int32_t _dopplerMin, int32_t _dopplerMax, uint32_t _fs, 
-  uint32_t _n, bool _roundHamming)
+  uint32_t _n, bool _roundHamming, uint32_t _nThreads, Autotune<T> *_autotune)
+  : AmbiguityEngine<T>(_delayMin, _delayMax, _dopplerMin, _dopplerMax, _fs, _n, _nThreads)
 {
-  // init
-  delayMin = _delayMin;
-  delayMax = _delayMax;
-  dopplerMin = _dopplerMin;
-  dopplerMax = _dopplerMax;
-  fs = _fs;
-  nSamples = _n;
-  nDelayBins = static_cast<uint16_t>(_delayMax - _delayMin + 1);
-  dopplerMiddle = (_dopplerMin + _dopplerMax) / 2.0;
-  
-  // doppler calculations
-  std::deque<double> doppler;
-  double resolutionDoppler = 1.0 / (static_cast<double>(_n) / static_cast<double>(_fs));
-  doppler.push_back(dopplerMiddle);
-  int i = 1;
-  while (dopplerMiddle + (i * resolutionDoppler) <= dopplerMax)
-  {
-    doppler.push_back(dopplerMiddle + (i * resolutionDoppler));
-    doppler.push_front(dopplerMiddle - (i * resolutionDoppler));
-    i++;
-  }
-  nDopplerBins = doppler.size();
-
   // batches constants
   nCorr = _n / nDopplerBins;
-  cpi = (static_cast<double>(nCorr) * nDopplerBins) / fs;
-
-  // update doppler bins to true cpi time
-  resolutionDoppler = 1.0 / cpi;
-
-  // create ambiguity map
-  map = std::make_unique<Map<Complex>>(nDopplerBins, nDelayBins);
-
-  // delay calculations
-  map->delay.resize(nDelayBins);
-  std::iota(map->delay.begin(), map->delay.end(), delayMin);
-
-  map->doppler.push_front(dopplerMiddle);
-  i = 1;
-  while (map->doppler.size() < nDopplerBins)
-  {
-    map->doppler.push_back(dopplerMiddle + (i * resolutionDoppler));
-    map->doppler.push_front(dopplerMiddle - (i * resolutionDoppler));
-    i++;
-  }
+  this->init(nDopplerBins * nCorr);
+  mapTranspose = std::make_unique<Map<Complex>>(nDelayBins, nDopplerBins);
 
   // other setup
   nfft = 2 * nCorr - 1;
-  if (_roundHamming) {
+  if (_autotune != nullptr) {
+    nfft = _autotune->fft_length("ambiguity_range", nfft);
+  }
+  else if (_roundHamming) {
     nfft = next_hamming(nfft);
   }
-  dataCorr.resize(2 * nDelayBins + 1);
 
-  // compute FFTW plans in constructor
-  dataXi.resize(nfft);
-  dataYi.resize(nfft);
-  dataZi.resize(nfft);
-  dataDoppler.resize(nfft);
-  fftXi = fftw_plan_dft_1d(nfft, reinterpret_cast<fftw_complex *>(dataXi.data()),
-                           reinterpret_cast<fftw_complex *>(dataXi.data()), FFTW_FORWARD, FFTW_ESTIMATE);
-  fftYi = fftw_plan_dft_1d(nfft, reinterpret_cast<fftw_complex *>(dataYi.data()),
-                           reinterpret_cast<fftw_complex *>(dataYi.data()), FFTW_FORWARD, FFTW_ESTIMATE);
-  fftZi = fftw_plan_dft_1d(nfft, reinterpret_cast<fftw_complex *>(dataZi.data()),
-                           reinterpret_cast<fftw_complex *>(dataZi.data()), FFTW_BACKWARD, FFTW_ESTIMATE);
-  fftDoppler = fftw_plan_dft_1d(nDopplerBins, reinterpret_cast<fftw_complex *>(dataDoppler.data()),
-                                reinterpret_cast<fftw_complex *>(dataDoppler.data()), FFTW_FORWARD, FFTW_ESTIMATE);
+  // per-thread storage
+  workspace.resize(pool->get_n_threads());
+  for (size_t k = 0; k < workspace.size(); k++)
+  {
+    workspace[k].dataXi.resize(nfft);
+    workspace[k].dataYi.resize(nfft);
+    workspace[k].dataZi.resize(nfft);
+    workspace[k].dataDoppler.resize(nDopplerBins);
+  }
 
+  // compute FFTW plans in constructor
+  Workspace &ws = workspace[0];
+  fftXi = Fftw<T>::plan_dft_1d(nfft, ws.dataXi.data(), ws.dataXi.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  fftYi = Fftw<T>::plan_dft_1d(nfft, ws.dataYi.data(), ws.dataYi.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  fftZi = Fftw<T>::plan_dft_1d(nfft, ws.dataZi.data(), ws.dataZi.data(), FFTW_BACKWARD, FFTW_ESTIMATE);
+  fftDoppler = Fftw<T>::plan_dft_1d(nDopplerBins, ws.dataDoppler.data(), ws.dataDoppler.data(), FFTW_FORWARD, FFTW_ESTIMATE);
 }
 
-Ambiguity::~Ambiguity()
+template <typename T>
+Ambiguity<T>::~Ambiguity()
 {
-  fftw_destroy_plan(fftXi);
-  fftw_destroy_plan(fftYi);
-  fftw_destroy_plan(fftZi);
-  fftw_destroy_plan(fftDoppler);
+  Fftw<T>::destroy_plan(fftXi);
+  Fftw<T>::destroy_plan(fftYi);
+  Fftw<T>::destroy_plan(fftZi);
+  Fftw<T>::destroy_plan(fftDoppler);
+  for (auto &resolution : resolutions)
+  {
+    Fftw<T>::destroy_plan(resolution.fftDoppler);
+  }
 }
 
-Map<std::complex<double>> *Ambiguity::process(IqData *x, IqData *y)
+template <typename T>
+uint32_t Ambiguity<T>::add_resolution(uint32_t division)
 {
-  // shift reference if not 0 centered
-  if (dopplerMiddle != 0)
+  Resolution resolution;
+  uint32_t nPulses = nDopplerBins / std::max<uint32_t>(1, division);
+  resolution.nPulses = std::max<uint32_t>(1, nPulses - (nPulses % 2 == 0));
+  resolution.cpi = static_cast<double>(resolution.nPulses) * nCorr / fs;
+  resolution.map = std::make_unique<Map<Complex>>(resolution.nPulses, nDelayBins);
+  resolution.mapTranspose = std::make_unique<Map<Complex>>(nDelayBins, resolution.nPulses);
+
+  // same delay bins, Doppler bins centered at coarser resolution
+  resolution.map->delay = map->delay;
+  resolution.map->doppler.push_front(dopplerMiddle);
+  int i = 1;
+  while (resolution.map->doppler.size() < resolution.nPulses)
   {
-    std::complex<double> j = {0, 1};
-    for (uint32_t i = 0; i < x->get_length(); i++)
-    {
-      x->push_back(x->pop_front() * std::exp(1.0 * j * 2.0 * M_PI * dopplerMiddle * ((double)i / fs)));
-    }
+    resolution.map->doppler.push_back(dopplerMiddle + (i / resolution.cpi));
+    resolution.map->doppler.push_front(dopplerMiddle - (i / resolution.cpi));
+    i++;
   }
 
-  // range processing
-  nSamples = nDopplerBins * nCorr;
-  for (uint16_t i = 0; i < nDopplerBins; i++)
-  {
-    for (uint16_t j = 0; j < nCorr; j++)
-    {
-      dataXi[j] = x->pop_front();
-      dataYi[j] = y->pop_front();
-    }
+  Workspace &ws = workspace[0];
+  resolution.fftDoppler = Fftw<T>::plan_dft_1d(resolution.nPulses, ws.dataDoppler.data(), ws.dataDoppler.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  resolutions.push_back(std::move(resolution));
 
-    for (uint16_t j = nCorr; j < nfft; j++)
-    {
-      dataXi[j] = {0, 0};
-      dataYi[j] = {0, 0};
-    }
+  return resolutions.size();
+}
 
-    fftw_execute(fftXi);
-    fftw_execute(fftYi);
+template <typename T>
+Map<std::complex<T>> *Ambiguity<T>::process(IqData *x, IqData *y)
+{
+  // copy CPI to contiguous storage, leaving the inputs untouched
+  this->load(x, y);
 
-    // compute correlation
-    for (uint32_t j = 0; j < nfft; j++)
+  // range processing
+  pool->parallel_for(nDopplerBins, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    Workspace &ws = workspace[thread];
+    for (uint32_t i = start; i < end; i++)
     {
-      dataZi[j] = (dataYi[j] * std::conj(dataXi[j])) / (double)nfft;
+      std::copy(dataX.begin() + i * nCorr, dataX.begin() + (i + 1) * nCorr, ws.dataXi.begin());
+      std::copy(dataY.begin() + i * nCorr, dataY.begin() + (i + 1) * nCorr, ws.dataYi.begin());
+      std::fill(ws.dataXi.begin() + nCorr, ws.dataXi.end(), Complex{0, 0});
+      std::fill(ws.dataYi.begin() + nCorr, ws.dataYi.end(), Complex{0, 0});
+
+      Fftw<T>::execute_dft(fftXi, ws.dataXi.data(), ws.dataXi.data());
+      Fftw<T>::execute_dft(fftYi, ws.dataYi.data(), ws.dataYi.data());
+
+      // compute correlation
+      for (uint32_t j = 0; j < nfft; j++)
+      {
+        ws.dataZi[j] = (ws.dataYi[j] * std::conj(ws.dataXi[j])) / (T)nfft;
+      }
+
+      Fftw<T>::execute_dft(fftZi, ws.dataZi.data(), ws.dataZi.data());
+
+      // extract delay bins of corr into map row
+      MapView<Complex> row = map->get_row(i);
+      for (uint16_t j = 0; j < nDelayBins; j++)
+      {
+        int32_t lag = delayMin + j;
+        row[j] = ws.dataZi[lag >= 0 ? lag : nfft + lag];
+      }
     }
+  });
 
-    fftw_execute(fftZi);
-
-    // extract center of corr
-    for (uint16_t j = 0; j < nDelayBins; j++)
-    {
-      dataCorr[j] = dataZi[nfft - nDelayBins + j];
-    }
-    for (uint16_t j = 0; j < nDelayBins + 1; j++)
-    {
-      dataCorr[j + nDelayBins] = dataZi[j];
-    }
+  // doppler processing on contiguous delay profiles
+  map->transpose(mapTranspose.get());
 
-    // cast from std::complex to std::vector
-    corr.clear();
-    for (uint16_t j = 0; j < nDelayBins; j++)
+  // shorter CPI maps from the most recent pulses, before the full CPI overwrites them
+  for (auto &resolution : resolutions)
+  {
+    uint16_t nPulses = resolution.nPulses;
+    pool->parallel_for(nDelayBins, [&](uint32_t start, uint32_t end, uint32_t thread)
     {
-      corr.push_back(dataCorr[nDelayBins + delayMin + j - 1 + 1]);
-    }
-
-    map->set_row(i, corr);
+      Workspace &ws = workspace[thread];
+      for (uint32_t i = start; i < end; i++)
+      {
+        MapView<Complex> delayProfile = mapTranspose->get_row(i);
+        std::copy(delayProfile.data() + (nDopplerBins - nPulses), delayProfile.data() + nDopplerBins, ws.dataDoppler.begin());
+
+        Fftw<T>::execute_dft(resolution.fftDoppler, ws.dataDoppler.data(), ws.dataDoppler.data());
+
+        MapView<Complex> delayProfileShort = resolution.mapTranspose->get_row(i);
+        for (uint16_t j = 0; j < nPulses; j++)
+        {
+          delayProfileShort[j] = ws.dataDoppler[(j + int(nPulses / 2) + 1) % nPulses];
+        }
+      }
+    });
+    resolution.mapTranspose->transpose(resolution.map.get());
   }
-
-  // doppler processing
-  for (uint16_t i = 0; i < nDelayBins; i++)
+  pool->parallel_for(nDelayBins, [&](uint32_t start, uint32_t end, uint32_t thread)
   {
-    delayProfile = map->get_col(i);
-    for (uint16_t j = 0; j < nDopplerBins; j++)
+    Workspace &ws = workspace[thread];
+    for (uint32_t i = start; i < end; i++)
     {
-      dataDoppler[j] = {delayProfile[j].real(), delayProfile[j].imag()};
-    }
+      MapView<Complex> delayProfile = mapTranspose->get_row(i);
+      std::copy(delayProfile.data(), delayProfile.data() + nDopplerBins, ws.dataDoppler.begin());
 
-    fftw_execute(fftDoppler);
+      Fftw<T>::execute_dft(fftDoppler, ws.dataDoppler.data(), ws.dataDoppler.data());
 
-    corr.clear();
-    for (uint16_t j = 0; j < nDopplerBins; j++)
-    {
-      corr.push_back(dataDoppler[(j + int(nDopplerBins / 2) + 1) % nDopplerBins]);
+      for (uint16_t j = 0; j < nDopplerBins; j++)
+      {
+        delayProfile[j] = ws.dataDoppler[(j + int(nDopplerBins / 2) + 1) % nDopplerBins];
+      }
     }
-
-    map->set_col(i, corr);
-  }
+  });
+  mapTranspose->transpose(map.get());
 
   return map.get();
 }
 
-double Ambiguity::get_doppler_middle() const {
-  return dopplerMiddle;
+template <typename T>
+Map<std::complex<T>> *Ambiguity<T>::get_map(uint32_t i) {
+  return i == 0 ? map.get() : resolutions.at(i - 1).map.get();
 }
 
-uint16_t Ambiguity::get_n_delay_bins() const {
-  return nDelayBins;
+template <typename T>
+double Ambiguity<T>::get_cpi(uint32_t i) const {
+  return i == 0 ? cpi : resolutions.at(i - 1).cpi;
 }
 
-uint16_t Ambiguity::get_n_doppler_bins() const {
-  return nDopplerBins;
+template <typename T>
+uint32_t Ambiguity<T>::get_n_maps() const {
+  return resolutions.size() + 1;
 }
 
-uint16_t Ambiguity::get_n_corr() const {
+template <typename T>
+uint16_t Ambiguity<T>::get_n_corr() const {
   return nCorr;
 }
 
-double Ambiguity::get_cpi() const {
-  return cpi;
-}
-
-uint32_t Ambiguity::get_nfft() const {
+template <typename T>
+uint32_t Ambiguity<T>::get_nfft() const {
   return nfft;
 }
 
-uint32_t Ambiguity::get_n_samples() const {
-  return nSamples;
-}
\ No newline at end of file
+// allowed types
+template class Ambiguity<double>;
+template class Ambiguity<float>;
@@ -3,24 +3,30 @@
 /// @brief A class to implement a ambiguity map processing.
 /// @details Implements a the batches algorithm as described in Principles of Modern Radar, Volume II, Chapter 17.
 /// See Fundamentals of Radar Signal Processing (Richards) for more on the pulse-Doppler processing method.
+/// Shorter CPI maps can be added, which reuse the range correlations of the most recent pulses.
 /// @author 30hours
 /// @todo Ambiguity maps are still offset by 1 bin.
-/// @todo Write a performance test for hamming assisted ambiguity processing.
 /// @todo If delayMin > delayMax = trouble, what's the exception policy?
 
-#include "data/IqData.h"
-#include "data/Map.h"
+#ifndef AMBIGUITY_H
+#define AMBIGUITY_H
+
+#include "AmbiguityEngine.h"
 #include "process/meta/HammingNumber.h"
+#include "process/meta/Autotune.h"
+#include "process/meta/Fftw.h"
 #include <stdint.h>
-#include <fftw3.h>
 #include <memory>
+#include <vector>
 
-class Ambiguity
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class Ambiguity : public AmbiguityEngine<T>
 {
 
 public:
 
-  using Complex = std::complex<double>;
+  using Complex = std::complex<T>;
 
   /// @brief Constructor.
   /// @param delayMin Minimum delay (bins).
@@ -30,92 +36,113 @@ public:
   /// @param fs Sampling frequency (Hz).
   /// @param n Number of samples.
   /// @param roundHamming Round the correlation FFT length to a Hamming number for performance.
+  /// @param nThreads Number of threads for range and Doppler processing.
+  /// @param autotune Autotuner to select the correlation FFT length, overrides roundHamming if set.
   /// @return The object.
-  Ambiguity(int32_t delayMin, int32_t delayMax, int32_t dopplerMin, int32_t dopplerMax, uint32_t fs, uint32_t n, bool roundHamming = false);
+  Ambiguity(int32_t delayMin, int32_t delayMax, int32_t dopplerMin, int32_t dopplerMax, uint32_t fs, uint32_t n, bool roundHamming = false, uint32_t nThreads = 1, Autotune<T> *autotune = nullptr);
 
   /// @brief Destructor.
   /// @return Void.
   ~Ambiguity();
 
   /// @brief Implement the ambiguity processor.
+  /// @details Samples are copied from the inputs, which are left unchanged.
   /// @param x Reference samples.
   /// @param y Surveillance samples.
   /// @return Ambiguity map data of IQ samples.
-  Map<Complex> *process(IqData *x, IqData *y);
+  Map<Complex> *process(IqData *x, IqData *y) override;
 
-  double get_doppler_middle() const;
+  /// @brief Add a map with a shorter CPI from the most recent pulses.
+  /// @details The number of pulses is rounded down to odd so the Doppler bins are centered.
+  /// @param division Ratio of the full CPI to the shorter CPI.
+  /// @return Index of the map for get_map().
+  uint32_t add_resolution(uint32_t division);
 
-  uint16_t get_n_delay_bins() const;
+  /// @brief Get a map computed by the last call to process().
+  /// @param i Index of the map, where 0 is the full CPI.
+  /// @return Ambiguity map data of IQ samples.
+  Map<Complex> *get_map(uint32_t i);
 
-  uint16_t get_n_doppler_bins() const;
+  using AmbiguityEngine<T>::get_cpi;
 
-  uint16_t get_n_corr() const;
+  /// @brief Get the true CPI time of a map.
+  /// @param i Index of the map, where 0 is the full CPI.
+  /// @return CPI time (s).
+  double get_cpi(uint32_t i) const;
 
-  double get_cpi() const;
+  /// @brief Get the number of maps including the full CPI.
+  /// @return Number of maps.
+  uint32_t get_n_maps() const;
 
-  uint32_t get_nfft() const;
+  uint16_t get_n_corr() const;
 
-  uint32_t get_n_samples() const;
+  uint32_t get_nfft() const;
 
 private:
-  /// @brief Minimum delay (bins).
-  int32_t delayMin;
-
-  /// @brief Maximum delay (bins).
-  int32_t delayMax;
-
-  /// @brief Minimum Doppler (Hz).
-  int32_t dopplerMin;
 
-  /// @brief Maximum Doppler (Hz).
-  int32_t dopplerMax;
-
-  /// @brief Sampling frequency (Hz).
-  uint32_t fs;
-
-  /// @brief Number of samples.
-  uint32_t nSamples;
-
-  /// @brief Number of delay bins.
-  uint16_t nDelayBins;
-
-  /// @brief Center of Doppler bins (Hz).
-  double dopplerMiddle;
-
-  /// @brief Number of Doppler bins.
-  uint16_t nDopplerBins;
+  using typename AmbiguityEngine<T>::AlignedVector;
+  using AmbiguityEngine<T>::delayMin;
+  using AmbiguityEngine<T>::fs;
+  using AmbiguityEngine<T>::cpi;
+  using AmbiguityEngine<T>::dopplerMiddle;
+  using AmbiguityEngine<T>::nSamples;
+  using AmbiguityEngine<T>::nDelayBins;
+  using AmbiguityEngine<T>::nDopplerBins;
+  using AmbiguityEngine<T>::dataX;
+  using AmbiguityEngine<T>::dataY;
+  using AmbiguityEngine<T>::pool;
+  using AmbiguityEngine<T>::map;
+
+  /// @brief Per-thread FFTW storage for ambiguity processing.
+  struct Workspace
+  {
+    AlignedVector dataXi;
+    AlignedVector dataYi;
+    AlignedVector dataZi;
+    AlignedVector dataDoppler;
+  };
+
+  /// @brief Map with a shorter CPI from the most recent pulses.
+  struct Resolution
+  {
+    /// @brief Number of pulses.
+    uint16_t nPulses;
+
+    /// @brief True CPI time (s).
+    double cpi;
+
+    /// @brief FFTW plan for Doppler processing.
+    typename Fftw<T>::Plan fftDoppler;
+
+    /// @brief Map to store result.
+    std::unique_ptr<Map<Complex>> map;
+
+    /// @brief Transposed map for contiguous Doppler processing.
+    std::unique_ptr<Map<Complex>> mapTranspose;
+  };
 
   /// @brief Number of correlation samples per pulse.
   uint16_t nCorr;
 
-  /// @brief True CPI time (s).
-  double cpi;
-
   /// @brief FFTW plans for ambiguity processing.
-  fftw_plan fftXi;
-  fftw_plan fftYi;
-  fftw_plan fftZi;
-  fftw_plan fftDoppler;
-
-  /// @brief FFTW storage for ambiguity processing.
-  /// @{
-  std::vector<Complex> dataXi;
-  std::vector<Complex> dataYi;
-  std::vector<Complex> dataZi;
-  std::vector<Complex> dataCorr;
-  std::vector<Complex> dataDoppler;
-  /// @}
+  typename Fftw<T>::Plan fftXi;
+  typename Fftw<T>::Plan fftYi;
+  typename Fftw<T>::Plan fftZi;
+  typename Fftw<T>::Plan fftDoppler;
+
+  /// @brief FFTW storage for ambiguity processing, one per thread.
+  /// @details Plans are created on the first workspace and executed on each with fftw_execute_dft.
+  std::vector<Workspace> workspace;
 
   /// @brief Number of samples to perform FFT per pulse.
   uint32_t nfft;
 
-  /// @brief Vector storage for ambiguity processing
-  /// @{
-  std::vector<Complex> corr;
-  std::vector<Complex> delayProfile;
-  /// @}
+  /// @brief Transposed map for contiguous Doppler processing.
+  std::unique_ptr<Map<Complex>> mapTranspose;
 
-  /// @brief Map to store result.
-  std::unique_ptr<Map<Complex>> map;
+  /// @brief Shorter CPI maps.
+  std::vector<Resolution> resolutions;
 
 };
+
+#endif
@@ -0,0 +1,100 @@
+#include "AmbiguityDirect.h"
+#include <complex>
+#include <algorithm>
+
+// constructor
+template <typename T>
+AmbiguityDirect<T>::AmbiguityDirect(int32_t _delayMin, int32_t _delayMax,
+  int32_t _dopplerMin, int32_t _dopplerMax, uint32_t _fs,
+  uint32_t _n, uint32_t _oversample, bool _roundHamming, uint32_t _nThreads)
+  : AmbiguityEngine<T>(_delayMin, _delayMax, _dopplerMin, _dopplerMax, _fs, _n, _nThreads)
+{
+  // decimated rate spans oversample times the Doppler window
+  nDecimation = std::max<uint32_t>(1, (_n / nDopplerBins) / std::max<uint32_t>(1, _oversample));
+  nfft = _n / nDecimation;
+  if (_roundHamming && prev_hamming(nfft) >= nDopplerBins) {
+    nfft = prev_hamming(nfft);
+  }
+  this->init(nfft * nDecimation);
+  mapTranspose = std::make_unique<Map<Complex>>(nDelayBins, nDopplerBins);
+
+  // per-thread storage
+  workspace.resize(pool->get_n_threads());
+  for (size_t k = 0; k < workspace.size(); k++)
+  {
+    workspace[k].resize(nfft);
+  }
+
+  // compute FFTW plan in constructor
+  fftDoppler = Fftw<T>::plan_dft_1d(nfft, workspace[0].data(), workspace[0].data(), FFTW_FORWARD, FFTW_ESTIMATE);
+}
+
+template <typename T>
+AmbiguityDirect<T>::~AmbiguityDirect()
+{
+  Fftw<T>::destroy_plan(fftDoppler);
+}
+
+template <typename T>
+Map<std::complex<T>> *AmbiguityDirect<T>::process(IqData *x, IqData *y)
+{
+  // copy CPI to contiguous storage, leaving the inputs untouched
+  this->load(x, y);
+
+  const T *xp = reinterpret_cast<const T *>(dataX.data());
+  const T *yp = reinterpret_cast<const T *>(dataY.data());
+  const int64_t n = nSamples;
+  const int64_t d = nDecimation;
+  const uint32_t half = nDopplerBins / 2;
+
+  pool->parallel_for(nDelayBins, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    AlignedVector &ws = workspace[thread];
+    for (uint32_t i = start; i < end; i++)
+    {
+      int64_t lag = delayMin + static_cast<int32_t>(i);
+
+      // integrate and dump y[k] * conj(x[k - lag])
+      for (uint32_t m = 0; m < nfft; m++)
+      {
+        int64_t lo = std::max<int64_t>(m * d, lag);
+        int64_t hi = std::min<int64_t>((m + 1) * d, n + lag);
+        T re = 0, im = 0;
+        for (int64_t k = lo; k < hi; k++)
+        {
+          T yr = yp[2*k], yi = yp[2*k+1];
+          T xr = xp[2*(k-lag)], xi = xp[2*(k-lag)+1];
+          re += yr * xr + yi * xi;
+          im += yi * xr - yr * xi;
+        }
+        ws[m] = Complex(re, im);
+      }
+
+      Fftw<T>::execute_dft(fftDoppler, ws.data(), ws.data());
+
+      // keep the Doppler window around 0 in ascending order
+      MapView<Complex> delayProfile = mapTranspose->get_row(i);
+      for (uint16_t j = 0; j < nDopplerBins; j++)
+      {
+        delayProfile[j] = ws[(j + nfft - half) % nfft];
+      }
+    }
+  });
+  mapTranspose->transpose(map.get());
+
+  return map.get();
+}
+
+template <typename T>
+uint32_t AmbiguityDirect<T>::get_n_decimation() const {
+  return nDecimation;
+}
+
+template <typename T>
+uint32_t AmbiguityDirect<T>::get_nfft() const {
+  return nfft;
+}
+
+// allowed types
+template class AmbiguityDirect<double>;
+template class AmbiguityDirect<float>;
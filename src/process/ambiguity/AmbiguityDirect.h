@@ -0,0 +1,86 @@
+/// @file AmbiguityDirect.h
+/// @class AmbiguityDirect
+/// @brief A class to implement full-CPI ambiguity map processing.
+/// @details Implements the decimation-based cross-ambiguity function. For each delay bin, the surveillance and shifted reference product is integrated and dumped over nDecimation samples, then transformed over the full CPI.
+/// The boxcar integration attenuates a target at the Doppler window edge by sinc(1/(2*oversample)), compared to sinc(1/2) for the batches algorithm.
+/// With nDecimation of 1, this is the direct FFT method with no straddle loss, at the cost of an FFT of the full CPI per delay bin.
+/// @author 30hours
+
+#ifndef AMBIGUITYDIRECT_H
+#define AMBIGUITYDIRECT_H
+
+#include "AmbiguityEngine.h"
+#include "process/meta/HammingNumber.h"
+#include "process/meta/Fftw.h"
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class AmbiguityDirect : public AmbiguityEngine<T>
+{
+
+public:
+
+  using Complex = std::complex<T>;
+
+  /// @brief Constructor.
+  /// @param delayMin Minimum delay (bins).
+  /// @param delayMax Maximum delay (bins).
+  /// @param dopplerMin Minimum Doppler (Hz).
+  /// @param dopplerMax Maximum Doppler (Hz).
+  /// @param fs Sampling frequency (Hz).
+  /// @param n Number of samples.
+  /// @param oversample Doppler oversampling factor of the decimated product, reduces integration loss.
+  /// @param roundHamming Round the Doppler FFT length down to a Hamming number for performance.
+  /// @param nThreads Number of threads for delay processing.
+  /// @return The object.
+  AmbiguityDirect(int32_t delayMin, int32_t delayMax, int32_t dopplerMin, int32_t dopplerMax, uint32_t fs, uint32_t n, uint32_t oversample = 4, bool roundHamming = false, uint32_t nThreads = 1);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~AmbiguityDirect();
+
+  /// @brief Implement the ambiguity processor.
+  /// @details Samples are copied from the inputs, which are left unchanged.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples.
+  /// @return Ambiguity map data of IQ samples.
+  Map<Complex> *process(IqData *x, IqData *y) override;
+
+  uint32_t get_n_decimation() const;
+
+  uint32_t get_nfft() const;
+
+private:
+
+  using typename AmbiguityEngine<T>::AlignedVector;
+  using AmbiguityEngine<T>::delayMin;
+  using AmbiguityEngine<T>::nSamples;
+  using AmbiguityEngine<T>::nDelayBins;
+  using AmbiguityEngine<T>::nDopplerBins;
+  using AmbiguityEngine<T>::dataX;
+  using AmbiguityEngine<T>::dataY;
+  using AmbiguityEngine<T>::pool;
+  using AmbiguityEngine<T>::map;
+
+  /// @brief Number of samples integrated per decimated sample.
+  uint32_t nDecimation;
+
+  /// @brief Number of decimated samples to perform Doppler FFT.
+  uint32_t nfft;
+
+  /// @brief FFTW plan for Doppler processing.
+  typename Fftw<T>::Plan fftDoppler;
+
+  /// @brief FFTW storage for Doppler processing, one per thread.
+  /// @details The plan is created on the first workspace and executed on each with fftw_execute_dft.
+  std::vector<AlignedVector> workspace;
+
+  /// @brief Transposed map, filled one delay bin per row.
+  std::unique_ptr<Map<Complex>> mapTranspose;
+
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "AmbiguityEngine.h"
+#include <complex>
+#include <deque>
+#include <numeric>
+#include <math.h>
+#include <algorithm>
+
+// constructor
+template <typename T>
+AmbiguityEngine<T>::AmbiguityEngine(int32_t _delayMin, int32_t _delayMax,
+  int32_t _dopplerMin, int32_t _dopplerMax, uint32_t _fs,
+  uint32_t _n, uint32_t _nThreads)
+{
+  // init
+  delayMin = _delayMin;
+  delayMax = _delayMax;
+  dopplerMin = _dopplerMin;
+  dopplerMax = _dopplerMax;
+  fs = _fs;
+  nSamples = _n;
+  nDelayBins = static_cast<uint16_t>(_delayMax - _delayMin + 1);
+  dopplerMiddle = (_dopplerMin + _dopplerMax) / 2.0;
+  cpi = static_cast<double>(_n) / _fs;
+
+  // doppler calculations
+  std::deque<double> doppler;
+  double resolutionDoppler = 1.0 / (static_cast<double>(_n) / static_cast<double>(_fs));
+  doppler.push_back(dopplerMiddle);
+  int i = 1;
+  while (dopplerMiddle + (i * resolutionDoppler) <= dopplerMax)
+  {
+    doppler.push_back(dopplerMiddle + (i * resolutionDoppler));
+    doppler.push_front(dopplerMiddle - (i * resolutionDoppler));
+    i++;
+  }
+  nDopplerBins = doppler.size();
+
+  pool = std::make_unique<ThreadPool>(_nThreads);
+}
+
+template <typename T>
+AmbiguityEngine<T>::~AmbiguityEngine()
+{
+}
+
+template <typename T>
+void AmbiguityEngine<T>::init(uint32_t _nSamples)
+{
+  nSamples = _nSamples;
+  cpi = static_cast<double>(nSamples) / fs;
+
+  // update doppler bins to true cpi time
+  double resolutionDoppler = 1.0 / cpi;
+
+  // create ambiguity map
+  map = std::make_unique<Map<Complex>>(nDopplerBins, nDelayBins);
+
+  // delay calculations
+  map->delay.resize(nDelayBins);
+  std::iota(map->delay.begin(), map->delay.end(), delayMin);
+
+  map->doppler.push_front(dopplerMiddle);
+  int i = 1;
+  while (map->doppler.size() < nDopplerBins)
+  {
+    map->doppler.push_back(dopplerMiddle + (i * resolutionDoppler));
+    map->doppler.push_front(dopplerMiddle - (i * resolutionDoppler));
+    i++;
+  }
+
+  dataX.resize(nSamples);
+  dataY.resize(nSamples);
+  dataRaw.resize(nSamples);
+
+  // phasor table to shift reference if not 0 centered
+  if (dopplerMiddle != 0)
+  {
+    phasor.resize(nSamples);
+    for (uint32_t k = 0; k < phasor.size(); k++)
+    {
+      phasor[k] = std::exp(std::complex<double>(0, 2.0 * M_PI * dopplerMiddle * ((double)k / fs)));
+    }
+  }
+}
+
+template <typename T>
+void AmbiguityEngine<T>::load(IqData *x, IqData *y, uint32_t start)
+{
+  x->copy(dataRaw.data() + start, nSamples - start, start);
+  if (dopplerMiddle != 0)
+  {
+    // shift reference if not 0 centered
+    const double *raw = reinterpret_cast<const double *>(dataRaw.data());
+    const double *shift = reinterpret_cast<const double *>(phasor.data());
+    for (uint32_t i = start; i < nSamples; i++)
+    {
+      double re = raw[2*i] * shift[2*i] - raw[2*i+1] * shift[2*i+1];
+      double im = raw[2*i] * shift[2*i+1] + raw[2*i+1] * shift[2*i];
+      dataX[i] = Complex((T)re, (T)im);
+    }
+  }
+  else
+  {
+    std::copy(dataRaw.begin() + start, dataRaw.begin() + nSamples, dataX.begin() + start);
+  }
+  y->copy(dataRaw.data() + start, nSamples - start, start);
+  std::copy(dataRaw.begin() + start, dataRaw.begin() + nSamples, dataY.begin() + start);
+}
+
+template <typename T>
+double AmbiguityEngine<T>::get_doppler_middle() const {
+  return dopplerMiddle;
+}
+
+template <typename T>
+uint16_t AmbiguityEngine<T>::get_n_delay_bins() const {
+  return nDelayBins;
+}
+
+template <typename T>
+uint16_t AmbiguityEngine<T>::get_n_doppler_bins() const {
+  return nDopplerBins;
+}
+
+template <typename T>
+double AmbiguityEngine<T>::get_cpi() const {
+  return cpi;
+}
+
+template <typename T>
+uint32_t AmbiguityEngine<T>::get_n_samples() const {
+  return nSamples;
+}
+
+template <typename T>
+uint32_t AmbiguityEngine<T>::get_n_threads() const {
+  return pool->get_n_threads();
+}
+
+// allowed types
+template class AmbiguityEngine<double>;
+template class AmbiguityEngine<float>;
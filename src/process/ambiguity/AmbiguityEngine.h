@@ -0,0 +1,131 @@
+/// @file AmbiguityEngine.h
+/// @class AmbiguityEngine
+/// @brief An abstract class for ambiguity map processing engines.
+/// @details Holds the delay and Doppler geometry, the map and the staged CPI samples common to each engine.
+/// Engines differ in how the cross-ambiguity function is approximated, trading CPU for integration loss.
+/// @author 30hours
+
+#ifndef AMBIGUITYENGINE_H
+#define AMBIGUITYENGINE_H
+
+#include "data/IqData.h"
+#include "data/Map.h"
+#include "process/utility/ThreadPool.h"
+#include "data/meta/AlignedAllocator.h"
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class AmbiguityEngine
+{
+
+public:
+
+  using Complex = std::complex<T>;
+
+  /// @brief Constructor.
+  /// @details Derived classes must call init() once the CPI length is known.
+  /// @param delayMin Minimum delay (bins).
+  /// @param delayMax Maximum delay (bins).
+  /// @param dopplerMin Minimum Doppler (Hz).
+  /// @param dopplerMax Maximum Doppler (Hz).
+  /// @param fs Sampling frequency (Hz).
+  /// @param n Number of samples.
+  /// @param nThreads Number of threads for processing.
+  /// @return The object.
+  AmbiguityEngine(int32_t delayMin, int32_t delayMax, int32_t dopplerMin, int32_t dopplerMax, uint32_t fs, uint32_t n, uint32_t nThreads);
+
+  /// @brief Destructor.
+  /// @return Void.
+  virtual ~AmbiguityEngine();
+
+  /// @brief Implement the ambiguity processor.
+  /// @details Samples are copied from the inputs, which are left unchanged.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples.
+  /// @return Ambiguity map data of IQ samples.
+  virtual Map<Complex> *process(IqData *x, IqData *y) = 0;
+
+  double get_doppler_middle() const;
+
+  uint16_t get_n_delay_bins() const;
+
+  uint16_t get_n_doppler_bins() const;
+
+  double get_cpi() const;
+
+  uint32_t get_n_samples() const;
+
+  uint32_t get_n_threads() const;
+
+protected:
+
+  using AlignedVector = std::vector<Complex, AlignedAllocator<Complex>>;
+
+  /// @brief Minimum delay (bins).
+  int32_t delayMin;
+
+  /// @brief Maximum delay (bins).
+  int32_t delayMax;
+
+  /// @brief Minimum Doppler (Hz).
+  int32_t dopplerMin;
+
+  /// @brief Maximum Doppler (Hz).
+  int32_t dopplerMax;
+
+  /// @brief Sampling frequency (Hz).
+  uint32_t fs;
+
+  /// @brief Number of samples processed per CPI.
+  uint32_t nSamples;
+
+  /// @brief Number of delay bins.
+  uint16_t nDelayBins;
+
+  /// @brief Center of Doppler bins (Hz).
+  double dopplerMiddle;
+
+  /// @brief Number of Doppler bins.
+  uint16_t nDopplerBins;
+
+  /// @brief True CPI time (s).
+  double cpi;
+
+  /// @brief Contiguous reference and surveillance samples for the CPI.
+  /// @details The reference is shifted to the Doppler window center.
+  /// @{
+  AlignedVector dataX;
+  AlignedVector dataY;
+  /// @}
+
+  /// @brief Staging buffer for samples copied from IqData.
+  std::vector<std::complex<double>, AlignedAllocator<std::complex<double>>> dataRaw;
+
+  /// @brief Phasor table to shift the reference to the Doppler window center.
+  /// @details Empty if the Doppler window is 0 centered.
+  std::vector<std::complex<double>, AlignedAllocator<std::complex<double>>> phasor;
+
+  /// @brief Worker pool for processing.
+  std::unique_ptr<ThreadPool> pool;
+
+  /// @brief Map to store result.
+  std::unique_ptr<Map<Complex>> map;
+
+  /// @brief Set the CPI length, create the map axes and sample buffers.
+  /// @param nSamples Number of samples processed per CPI.
+  /// @return Void.
+  void init(uint32_t nSamples);
+
+  /// @brief Copy the CPI to contiguous storage, shifting the reference.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples.
+  /// @param start Index of first sample of the CPI to copy.
+  /// @return Void.
+  void load(IqData *x, IqData *y, uint32_t start = 0);
+
+};
+
+#endif
@@ -0,0 +1,284 @@
+#include "AmbiguityRoi.h"
+#include <complex>
+#include <numeric>
+#include <stdexcept>
+#include <math.h>
+#include <algorithm>
+
+// constructor
+template <typename T>
+AmbiguityRoi<T>::AmbiguityRoi(int32_t _delayMin, int32_t _delayMax,
+  int32_t _dopplerMin, int32_t _dopplerMax, uint32_t _fs, uint32_t _n,
+  int32_t _roiDelayMin, int32_t _roiDelayMax, double _roiDopplerMin,
+  double _roiDopplerMax, bool _roundHamming, uint32_t _nThreads, Method _method, Autotune<T> *_autotune)
+  : AmbiguityEngine<T>(_delayMin, _delayMax, _dopplerMin, _dopplerMax, _fs, _n, _nThreads)
+{
+  // batches constants over the full window
+  nPulses = nDopplerBins;
+  nCorr = _n / nPulses;
+  this->init(nPulses * nCorr);
+  nfft = 2 * nCorr - 1;
+  if (_autotune != nullptr) {
+    nfft = _autotune->fft_length("ambiguity_range", nfft);
+  }
+  else if (_roundHamming) {
+    nfft = next_hamming(nfft);
+  }
+
+  // select ROI cells on the full map grid
+  int32_t roiDelayMin = std::max(_roiDelayMin, delayMin);
+  int32_t roiDelayMax = std::min(_roiDelayMax, delayMax);
+  int32_t first = -1, last = -1;
+  for (uint16_t i = 0; i < nPulses; i++)
+  {
+    if (map->doppler[i] >= _roiDopplerMin && map->doppler[i] <= _roiDopplerMax)
+    {
+      first = (first < 0) ? i : first;
+      last = i;
+    }
+  }
+  if (roiDelayMin > roiDelayMax || first < 0)
+  {
+    throw std::invalid_argument("ROI is outside the ambiguity window");
+  }
+  auto roi = std::make_unique<Map<Complex>>(last - first + 1, roiDelayMax - roiDelayMin + 1);
+  roi->delay.resize(roiDelayMax - roiDelayMin + 1);
+  std::iota(roi->delay.begin(), roi->delay.end(), roiDelayMin);
+  roi->doppler.assign(map->doppler.begin() + first, map->doppler.begin() + last + 1);
+  map = std::move(roi);
+  delayMin = roiDelayMin;
+  delayMax = roiDelayMax;
+  nDelayBins = static_cast<uint16_t>(roiDelayMax - roiDelayMin + 1);
+  nDopplerBins = static_cast<uint16_t>(last - first + 1);
+  dopplerStart = static_cast<uint16_t>(first);
+
+  // select method by operation count, 5N*log2(N) per FFT and 8 per complex MAC
+  double costFftRange = 15.0 * nfft * std::log2(nfft);
+  double costDirectRange = 8.0 * nDelayBins * nCorr;
+  double costFftDoppler = 5.0 * nPulses * std::log2(nPulses);
+  double costDirectDoppler = 8.0 * nDopplerBins * nPulses;
+  directRange = (_method == Method::Direct) ||
+    (_method == Method::Auto && costDirectRange < costFftRange);
+  directDoppler = (_method == Method::Direct) ||
+    (_method == Method::Auto && costDirectDoppler < costFftDoppler);
+
+  rangeRows = std::make_unique<Map<Complex>>(nPulses, nDelayBins);
+  rangeCols = std::make_unique<Map<Complex>>(nDelayBins, nPulses);
+  mapTranspose = std::make_unique<Map<Complex>>(nDelayBins, nDopplerBins);
+
+  // per-thread storage
+  workspace.resize(pool->get_n_threads());
+  for (size_t k = 0; k < workspace.size(); k++)
+  {
+    workspace[k].dataXi.resize(nfft);
+    workspace[k].dataYi.resize(nfft);
+    workspace[k].dataZi.resize(nfft);
+    workspace[k].dataDoppler.resize(nPulses);
+  }
+
+  // twiddles for direct Doppler bins
+  twiddle.resize(nPulses);
+  for (uint16_t k = 0; k < nPulses; k++)
+  {
+    twiddle[k] = Complex(std::exp(std::complex<double>(0, -2.0 * M_PI * k / nPulses)));
+  }
+
+  // compute FFTW plans in constructor
+  Workspace &ws = workspace[0];
+  fftXi = Fftw<T>::plan_dft_1d(nfft, ws.dataXi.data(), ws.dataXi.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  fftYi = Fftw<T>::plan_dft_1d(nfft, ws.dataYi.data(), ws.dataYi.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  fftZi = Fftw<T>::plan_dft_1d(nfft, ws.dataZi.data(), ws.dataZi.data(), FFTW_BACKWARD, FFTW_ESTIMATE);
+  fftDoppler = Fftw<T>::plan_dft_1d(nPulses, ws.dataDoppler.data(), ws.dataDoppler.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+}
+
+template <typename T>
+AmbiguityRoi<T>::~AmbiguityRoi()
+{
+  Fftw<T>::destroy_plan(fftXi);
+  Fftw<T>::destroy_plan(fftYi);
+  Fftw<T>::destroy_plan(fftZi);
+  Fftw<T>::destroy_plan(fftDoppler);
+}
+
+template <typename T>
+Map<std::complex<T>> *AmbiguityRoi<T>::process(IqData *x, IqData *y)
+{
+  // copy CPI to contiguous storage, leaving the inputs untouched
+  this->load(x, y);
+
+  // range processing of ROI lags
+  pool->parallel_for(nPulses, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    Workspace &ws = workspace[thread];
+    for (uint32_t i = start; i < end; i++)
+    {
+      MapView<Complex> row = rangeRows->get_row(i);
+      if (directRange)
+      {
+        // correlate y[m + lag] * conj(x[m]) within the pulse
+        const T *xp = reinterpret_cast<const T *>(dataX.data() + i * nCorr);
+        const T *yp = reinterpret_cast<const T *>(dataY.data() + i * nCorr);
+        for (uint16_t j = 0; j < nDelayBins; j++)
+        {
+          int32_t lag = delayMin + j;
+          int32_t lo = std::max(0, -lag);
+          int32_t hi = std::min<int32_t>(nCorr, nCorr - lag);
+          T re = 0, im = 0;
+          for (int32_t m = lo; m < hi; m++)
+          {
+            T yr = yp[2*(m+lag)], yi = yp[2*(m+lag)+1];
+            T xr = xp[2*m], xi = xp[2*m+1];
+            re += yr * xr + yi * xi;
+            im += yi * xr - yr * xi;
+          }
+          row[j] = Complex(re, im);
+        }
+        continue;
+      }
+
+      std::copy(dataX.begin() + i * nCorr, dataX.begin() + (i + 1) * nCorr, ws.dataXi.begin());
+      std::copy(dataY.begin() + i * nCorr, dataY.begin() + (i + 1) * nCorr, ws.dataYi.begin());
+      std::fill(ws.dataXi.begin() + nCorr, ws.dataXi.end(), Complex{0, 0});
+      std::fill(ws.dataYi.begin() + nCorr, ws.dataYi.end(), Complex{0, 0});
+
+      Fftw<T>::execute_dft(fftXi, ws.dataXi.data(), ws.dataXi.data());
+      Fftw<T>::execute_dft(fftYi, ws.dataYi.data(), ws.dataYi.data());
+
+      // compute correlation
+      for (uint32_t j = 0; j < nfft; j++)
+      {
+        ws.dataZi[j] = (ws.dataYi[j] * std::conj(ws.dataXi[j])) / (T)nfft;
+      }
+
+      Fftw<T>::execute_dft(fftZi, ws.dataZi.data(), ws.dataZi.data());
+
+      // extract ROI delay bins of corr
+      for (uint16_t j = 0; j < nDelayBins; j++)
+      {
+        int32_t lag = delayMin + j;
+        row[j] = ws.dataZi[lag >= 0 ? lag : nfft + lag];
+      }
+    }
+  });
+
+  // doppler processing of ROI bins on contiguous slow-time sequences
+  rangeRows->transpose(rangeCols.get());
+  uint16_t half = nPulses / 2;
+  pool->parallel_for(nDelayBins, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    Workspace &ws = workspace[thread];
+    for (uint32_t i = start; i < end; i++)
+    {
+      MapView<Complex> slowTime = rangeCols->get_row(i);
+      MapView<Complex> delayProfile = mapTranspose->get_row(i);
+      if (directDoppler)
+      {
+        const T *s = reinterpret_cast<const T *>(slowTime.data());
+        const T *w = reinterpret_cast<const T *>(twiddle.data());
+        for (uint16_t j = 0; j < nDopplerBins; j++)
+        {
+          uint64_t k = (dopplerStart + j + half + 1) % nPulses;
+          T re = 0, im = 0;
+          for (uint32_t p = 0; p < nPulses; p++)
+          {
+            uint32_t t = (k * p) % nPulses;
+            re += s[2*p] * w[2*t] - s[2*p+1] * w[2*t+1];
+            im += s[2*p] * w[2*t+1] + s[2*p+1] * w[2*t];
+          }
+          delayProfile[j] = Complex(re, im);
+        }
+        continue;
+      }
+
+      std::copy(slowTime.data(), slowTime.data() + nPulses, ws.dataDoppler.begin());
+      Fftw<T>::execute_dft(fftDoppler, ws.dataDoppler.data(), ws.dataDoppler.data());
+      for (uint16_t j = 0; j < nDopplerBins; j++)
+      {
+        delayProfile[j] = ws.dataDoppler[(dopplerStart + j + half + 1) % nPulses];
+      }
+    }
+  });
+  mapTranspose->transpose(map.get());
+
+  return map.get();
+}
+
+template <typename T>
+Map<std::complex<T>> *AmbiguityRoi<T>::zoom(int32_t delay, double doppler,
+  uint16_t nDelay, uint16_t nDoppler, uint16_t factor)
+{
+  int32_t zoomDelayMin = std::max(delay - nDelay, delayMin);
+  int32_t zoomDelayMax = std::min(delay + nDelay, delayMax);
+  if (zoomDelayMin > zoomDelayMax)
+  {
+    throw std::out_of_range("Cued delay is outside the ROI");
+  }
+  factor = std::max<uint16_t>(1, factor);
+  uint32_t nZoomDoppler = 2 * nDoppler * factor + 1;
+  uint32_t nZoomDelay = zoomDelayMax - zoomDelayMin + 1;
+  double resolution = 1.0 / (this->cpi * factor);
+
+  mapZoom = std::make_unique<Map<Complex>>(nZoomDoppler, nZoomDelay);
+  mapZoom->delay.resize(nZoomDelay);
+  std::iota(mapZoom->delay.begin(), mapZoom->delay.end(), zoomDelayMin);
+  for (uint32_t i = 0; i < nZoomDoppler; i++)
+  {
+    mapZoom->doppler.push_back(doppler + ((int32_t)i - nDoppler * factor) * resolution);
+  }
+
+  // zoom transform of the slow-time sequence at each Doppler
+  std::vector<Complex> kernel((size_t)nZoomDoppler * nPulses);
+  for (uint32_t i = 0; i < nZoomDoppler; i++)
+  {
+    double phase = -2.0 * M_PI * (mapZoom->doppler[i] - dopplerMiddle) * nCorr / fs;
+    for (uint32_t p = 0; p < nPulses; p++)
+    {
+      kernel[(size_t)i * nPulses + p] = Complex(std::exp(std::complex<double>(0, phase * p)));
+    }
+  }
+  for (uint32_t j = 0; j < nZoomDelay; j++)
+  {
+    MapView<Complex> slowTime = rangeCols->get_row(zoomDelayMin + j - delayMin);
+    for (uint32_t i = 0; i < nZoomDoppler; i++)
+    {
+      const Complex *w = kernel.data() + (size_t)i * nPulses;
+      Complex sum = 0;
+      for (uint32_t p = 0; p < nPulses; p++)
+      {
+        sum += slowTime[p] * w[p];
+      }
+      mapZoom->at(i, j) = sum;
+    }
+  }
+
+  return mapZoom.get();
+}
+
+template <typename T>
+uint16_t AmbiguityRoi<T>::get_n_corr() const {
+  return nCorr;
+}
+
+template <typename T>
+uint32_t AmbiguityRoi<T>::get_nfft() const {
+  return nfft;
+}
+
+template <typename T>
+uint16_t AmbiguityRoi<T>::get_n_pulses() const {
+  return nPulses;
+}
+
+template <typename T>
+bool AmbiguityRoi<T>::is_direct_range() const {
+  return directRange;
+}
+
+template <typename T>
+bool AmbiguityRoi<T>::is_direct_doppler() const {
+  return directDoppler;
+}
+
+// allowed types
+template class AmbiguityRoi<double>;
+template class AmbiguityRoi<float>;
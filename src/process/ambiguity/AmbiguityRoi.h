@@ -0,0 +1,158 @@
+/// @file AmbiguityRoi.h
+/// @class AmbiguityRoi
+/// @brief A class to implement region of interest ambiguity map processing.
+/// @details Uses the batches geometry of the full delay/Doppler window, but only computes cells in the region of interest.
+/// Range correlation lags are computed directly in the time domain when the ROI delay span is short, and Doppler bins with a direct DFT when the ROI Doppler span is short. Otherwise the FFT is computed and pruned.
+/// The per-pulse range rows of the ROI are kept, so a cued cell can be zoomed to a finer Doppler grid without reprocessing.
+/// @author 30hours
+
+#ifndef AMBIGUITYROI_H
+#define AMBIGUITYROI_H
+
+#include "AmbiguityEngine.h"
+#include "process/meta/HammingNumber.h"
+#include "process/meta/Autotune.h"
+#include "process/meta/Fftw.h"
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class AmbiguityRoi : public AmbiguityEngine<T>
+{
+
+public:
+
+  using Complex = std::complex<T>;
+
+  /// @brief Method to compute the pruned transforms.
+  enum class Method
+  {
+    Auto,   ///< Select by operation count.
+    Fft,    ///< Full FFT, then keep ROI bins.
+    Direct  ///< Direct evaluation of ROI bins only.
+  };
+
+  /// @brief Constructor.
+  /// @param delayMin Minimum delay of full window (bins).
+  /// @param delayMax Maximum delay of full window (bins).
+  /// @param dopplerMin Minimum Doppler of full window (Hz).
+  /// @param dopplerMax Maximum Doppler of full window (Hz).
+  /// @param fs Sampling frequency (Hz).
+  /// @param n Number of samples.
+  /// @param roiDelayMin Minimum delay of ROI (bins).
+  /// @param roiDelayMax Maximum delay of ROI (bins).
+  /// @param roiDopplerMin Minimum Doppler of ROI (Hz).
+  /// @param roiDopplerMax Maximum Doppler of ROI (Hz).
+  /// @param roundHamming Round the correlation FFT length to a Hamming number for performance.
+  /// @param nThreads Number of threads for range and Doppler processing.
+  /// @param method Method to compute the pruned transforms.
+  /// @param autotune Autotuner to select the correlation FFT length, overrides roundHamming if set.
+  /// @return The object.
+  AmbiguityRoi(int32_t delayMin, int32_t delayMax, int32_t dopplerMin, int32_t dopplerMax, uint32_t fs, uint32_t n, int32_t roiDelayMin, int32_t roiDelayMax, double roiDopplerMin, double roiDopplerMax, bool roundHamming = false, uint32_t nThreads = 1, Method method = Method::Auto, Autotune<T> *autotune = nullptr);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~AmbiguityRoi();
+
+  /// @brief Implement the ambiguity processor over the ROI.
+  /// @details Samples are copied from the inputs, which are left unchanged.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples.
+  /// @return Ambiguity map data of IQ samples, ROI cells only.
+  Map<Complex> *process(IqData *x, IqData *y) override;
+
+  /// @brief Zoom the Doppler axis around a cued cell of the last CPI.
+  /// @details Evaluates the Doppler transform of the stored range rows on a grid finer than the CPI resolution.
+  /// Delays outside the ROI are dropped from the patch.
+  /// @param delay Cued delay (bins).
+  /// @param doppler Cued Doppler (Hz).
+  /// @param nDelay Number of delay bins either side of the cue.
+  /// @param nDoppler Number of CPI Doppler bins either side of the cue.
+  /// @param factor Number of zoomed Doppler bins per CPI Doppler bin.
+  /// @return Zoomed map data of IQ samples.
+  Map<Complex> *zoom(int32_t delay, double doppler, uint16_t nDelay, uint16_t nDoppler, uint16_t factor);
+
+  uint16_t get_n_corr() const;
+
+  uint32_t get_nfft() const;
+
+  uint16_t get_n_pulses() const;
+
+  /// @brief Check if range lags are computed directly.
+  /// @return True if direct, false if FFT.
+  bool is_direct_range() const;
+
+  /// @brief Check if Doppler bins are computed directly.
+  /// @return True if direct, false if FFT.
+  bool is_direct_doppler() const;
+
+private:
+
+  using typename AmbiguityEngine<T>::AlignedVector;
+  using AmbiguityEngine<T>::delayMin;
+  using AmbiguityEngine<T>::delayMax;
+  using AmbiguityEngine<T>::dopplerMiddle;
+  using AmbiguityEngine<T>::fs;
+  using AmbiguityEngine<T>::nDelayBins;
+  using AmbiguityEngine<T>::nDopplerBins;
+  using AmbiguityEngine<T>::dataX;
+  using AmbiguityEngine<T>::dataY;
+  using AmbiguityEngine<T>::pool;
+  using AmbiguityEngine<T>::map;
+
+  /// @brief Per-thread FFTW storage for ambiguity processing.
+  struct Workspace
+  {
+    AlignedVector dataXi;
+    AlignedVector dataYi;
+    AlignedVector dataZi;
+    AlignedVector dataDoppler;
+  };
+
+  /// @brief Number of pulses in the CPI.
+  uint16_t nPulses;
+
+  /// @brief Number of correlation samples per pulse.
+  uint16_t nCorr;
+
+  /// @brief Number of samples to perform FFT per pulse.
+  uint32_t nfft;
+
+  /// @brief Index of first ROI Doppler bin in the full Doppler window.
+  uint16_t dopplerStart;
+
+  /// @brief True if range lags are computed directly.
+  bool directRange;
+
+  /// @brief True if Doppler bins are computed directly.
+  bool directDoppler;
+
+  /// @brief FFTW plans for ambiguity processing.
+  typename Fftw<T>::Plan fftXi;
+  typename Fftw<T>::Plan fftYi;
+  typename Fftw<T>::Plan fftZi;
+  typename Fftw<T>::Plan fftDoppler;
+
+  /// @brief FFTW storage for ambiguity processing, one per thread.
+  std::vector<Workspace> workspace;
+
+  /// @brief DFT twiddles over pulses for direct Doppler bins.
+  std::vector<Complex> twiddle;
+
+  /// @brief Per-pulse range rows of the ROI (pulse by delay).
+  std::unique_ptr<Map<Complex>> rangeRows;
+
+  /// @brief Slow-time sequence per ROI delay (delay by pulse).
+  std::unique_ptr<Map<Complex>> rangeCols;
+
+  /// @brief Transposed map for contiguous Doppler processing.
+  std::unique_ptr<Map<Complex>> mapTranspose;
+
+  /// @brief Map to store zoom result.
+  std::unique_ptr<Map<Complex>> mapZoom;
+
+};
+
+#endif
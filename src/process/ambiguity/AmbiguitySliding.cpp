@@ -0,0 +1,170 @@
+#include "AmbiguitySliding.h"
+#include <complex>
+#include <math.h>
+#include <algorithm>
+
+// constructor
+template <typename T>
+AmbiguitySliding<T>::AmbiguitySliding(int32_t _delayMin, int32_t _delayMax,
+  int32_t _dopplerMin, int32_t _dopplerMax, uint32_t _fs,
+  uint32_t _n, uint32_t _nUpdate, bool _roundHamming, uint32_t _nThreads, Autotune<T> *_autotune)
+  : AmbiguityEngine<T>(_delayMin, _delayMax, _dopplerMin, _dopplerMax, _fs, _n, _nThreads)
+{
+  // batches constants
+  nCorr = _n / nDopplerBins;
+  this->init(nDopplerBins * nCorr);
+  nPulsesStep = std::max<uint32_t>(1, nDopplerBins / std::max<uint32_t>(1, _nUpdate));
+  nfft = 2 * nCorr - 1;
+  if (_autotune != nullptr) {
+    nfft = _autotune->fft_length("ambiguity_range", nfft);
+  }
+  else if (_roundHamming) {
+    nfft = next_hamming(nfft);
+  }
+  reset();
+
+  ring = std::make_unique<Map<Complex>>(nDopplerBins, nDelayBins);
+  ringTranspose = std::make_unique<Map<Complex>>(nDelayBins, nDopplerBins);
+  mapTranspose = std::make_unique<Map<Complex>>(nDelayBins, nDopplerBins);
+
+  // per-thread storage
+  workspace.resize(pool->get_n_threads());
+  for (size_t k = 0; k < workspace.size(); k++)
+  {
+    workspace[k].dataXi.resize(nfft);
+    workspace[k].dataYi.resize(nfft);
+    workspace[k].dataZi.resize(nfft);
+    workspace[k].dataDoppler.resize(nDopplerBins);
+  }
+
+  // compute FFTW plans in constructor
+  Workspace &ws = workspace[0];
+  fftXi = Fftw<T>::plan_dft_1d(nfft, ws.dataXi.data(), ws.dataXi.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  fftYi = Fftw<T>::plan_dft_1d(nfft, ws.dataYi.data(), ws.dataYi.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  fftZi = Fftw<T>::plan_dft_1d(nfft, ws.dataZi.data(), ws.dataZi.data(), FFTW_BACKWARD, FFTW_ESTIMATE);
+  fftDoppler = Fftw<T>::plan_dft_1d(nDopplerBins, ws.dataDoppler.data(), ws.dataDoppler.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+}
+
+template <typename T>
+AmbiguitySliding<T>::~AmbiguitySliding()
+{
+  Fftw<T>::destroy_plan(fftXi);
+  Fftw<T>::destroy_plan(fftYi);
+  Fftw<T>::destroy_plan(fftZi);
+  Fftw<T>::destroy_plan(fftDoppler);
+}
+
+template <typename T>
+void AmbiguitySliding<T>::reset()
+{
+  head = 0;
+  isValid = false;
+  sampleStart = 0;
+}
+
+template <typename T>
+Map<std::complex<T>> *AmbiguitySliding<T>::process(IqData *x, IqData *y)
+{
+  // advance the ring, evicted slots are reused by the new pulses
+  uint16_t nNew = nDopplerBins;
+  if (isValid)
+  {
+    nNew = nPulsesStep;
+    head = (head + nNew) % nDopplerBins;
+    sampleStart += (uint64_t)nNew * nCorr;
+  }
+  uint16_t first = nDopplerBins - nNew;
+
+  // copy new pulses to contiguous storage, leaving the inputs untouched
+  this->load(x, y, first * nCorr);
+
+  // common phase of the window start, as the shift is relative to the window
+  std::complex<double> phase = 1;
+  if (dopplerMiddle != 0)
+  {
+    uint64_t period = 2 * (uint64_t)fs;
+    phase = std::polar(1.0, -2.0 * M_PI * dopplerMiddle * (double)(sampleStart % period) / fs);
+  }
+  Complex phaseT(phase);
+
+  // range processing of new pulses
+  pool->parallel_for(nNew, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    Workspace &ws = workspace[thread];
+    for (uint32_t k = start; k < end; k++)
+    {
+      uint32_t i = first + k;
+      std::copy(dataX.begin() + i * nCorr, dataX.begin() + (i + 1) * nCorr, ws.dataXi.begin());
+      std::copy(dataY.begin() + i * nCorr, dataY.begin() + (i + 1) * nCorr, ws.dataYi.begin());
+      std::fill(ws.dataXi.begin() + nCorr, ws.dataXi.end(), Complex{0, 0});
+      std::fill(ws.dataYi.begin() + nCorr, ws.dataYi.end(), Complex{0, 0});
+
+      Fftw<T>::execute_dft(fftXi, ws.dataXi.data(), ws.dataXi.data());
+      Fftw<T>::execute_dft(fftYi, ws.dataYi.data(), ws.dataYi.data());
+
+      // compute correlation
+      for (uint32_t j = 0; j < nfft; j++)
+      {
+        ws.dataZi[j] = (ws.dataYi[j] * std::conj(ws.dataXi[j])) / (T)nfft;
+      }
+
+      Fftw<T>::execute_dft(fftZi, ws.dataZi.data(), ws.dataZi.data());
+
+      // extract delay bins of corr into ring slot
+      MapView<Complex> row = ring->get_row((head + i) % nDopplerBins);
+      for (uint16_t j = 0; j < nDelayBins; j++)
+      {
+        int32_t lag = delayMin + j;
+        row[j] = ws.dataZi[lag >= 0 ? lag : nfft + lag];
+        if (dopplerMiddle != 0)
+        {
+          row[j] *= phaseT;
+        }
+      }
+    }
+  });
+  isValid = true;
+
+  // doppler processing of slow-time sequences from the oldest pulse
+  ring->transpose(ringTranspose.get());
+  pool->parallel_for(nDelayBins, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    Workspace &ws = workspace[thread];
+    for (uint32_t i = start; i < end; i++)
+    {
+      MapView<Complex> slowTime = ringTranspose->get_row(i);
+      std::copy(slowTime.data() + head, slowTime.data() + nDopplerBins, ws.dataDoppler.begin());
+      std::copy(slowTime.data(), slowTime.data() + head, ws.dataDoppler.begin() + (nDopplerBins - head));
+
+      Fftw<T>::execute_dft(fftDoppler, ws.dataDoppler.data(), ws.dataDoppler.data());
+
+      MapView<Complex> delayProfile = mapTranspose->get_row(i);
+      for (uint16_t j = 0; j < nDopplerBins; j++)
+      {
+        delayProfile[j] = ws.dataDoppler[(j + int(nDopplerBins / 2) + 1) % nDopplerBins];
+      }
+    }
+  });
+  mapTranspose->transpose(map.get());
+
+  return map.get();
+}
+
+template <typename T>
+uint16_t AmbiguitySliding<T>::get_n_corr() const {
+  return nCorr;
+}
+
+template <typename T>
+uint32_t AmbiguitySliding<T>::get_nfft() const {
+  return nfft;
+}
+
+template <typename T>
+uint32_t AmbiguitySliding<T>::get_n_step() const {
+  return (uint32_t)nPulsesStep * nCorr;
+}
+
+// allowed types
+template class AmbiguitySliding<double>;
+template class AmbiguitySliding<float>;
@@ -0,0 +1,127 @@
+/// @file AmbiguitySliding.h
+/// @class AmbiguitySliding
+/// @brief A class to implement sliding CPI ambiguity map processing.
+/// @details Implements the batches algorithm incrementally. Per-pulse range correlations are kept in a ring, so each update only correlates the new pulses before the Doppler FFTs.
+/// Each call after the first must follow a shift of the inputs by get_n_step() samples. Rows are phase referenced to the absolute sample count, so the map matches the batches map of the same window up to a common phase.
+/// @author 30hours
+
+#ifndef AMBIGUITYSLIDING_H
+#define AMBIGUITYSLIDING_H
+
+#include "AmbiguityEngine.h"
+#include "process/meta/HammingNumber.h"
+#include "process/meta/Autotune.h"
+#include "process/meta/Fftw.h"
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class AmbiguitySliding : public AmbiguityEngine<T>
+{
+
+public:
+
+  using Complex = std::complex<T>;
+
+  /// @brief Constructor.
+  /// @param delayMin Minimum delay (bins).
+  /// @param delayMax Maximum delay (bins).
+  /// @param dopplerMin Minimum Doppler (Hz).
+  /// @param dopplerMax Maximum Doppler (Hz).
+  /// @param fs Sampling frequency (Hz).
+  /// @param n Number of samples.
+  /// @param nUpdate Number of map updates per CPI length.
+  /// @param roundHamming Round the correlation FFT length to a Hamming number for performance.
+  /// @param nThreads Number of threads for range and Doppler processing.
+  /// @param autotune Autotuner to select the correlation FFT length, overrides roundHamming if set.
+  /// @return The object.
+  AmbiguitySliding(int32_t delayMin, int32_t delayMax, int32_t dopplerMin, int32_t dopplerMax, uint32_t fs, uint32_t n, uint32_t nUpdate = 1, bool roundHamming = false, uint32_t nThreads = 1, Autotune<T> *autotune = nullptr);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~AmbiguitySliding();
+
+  /// @brief Implement the ambiguity processor for the latest window.
+  /// @details Samples are copied from the inputs, which are left unchanged.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples.
+  /// @return Ambiguity map data of IQ samples.
+  Map<Complex> *process(IqData *x, IqData *y) override;
+
+  /// @brief Discard the ring so the next call processes the full window.
+  /// @details Use when the inputs did not shift by get_n_step() samples since the last call.
+  /// @return Void.
+  void reset();
+
+  uint16_t get_n_corr() const;
+
+  uint32_t get_nfft() const;
+
+  /// @brief Get the number of new samples per update.
+  /// @return Number of samples.
+  uint32_t get_n_step() const;
+
+private:
+
+  using typename AmbiguityEngine<T>::AlignedVector;
+  using AmbiguityEngine<T>::delayMin;
+  using AmbiguityEngine<T>::dopplerMiddle;
+  using AmbiguityEngine<T>::fs;
+  using AmbiguityEngine<T>::nSamples;
+  using AmbiguityEngine<T>::nDelayBins;
+  using AmbiguityEngine<T>::nDopplerBins;
+  using AmbiguityEngine<T>::dataX;
+  using AmbiguityEngine<T>::dataY;
+  using AmbiguityEngine<T>::pool;
+  using AmbiguityEngine<T>::map;
+
+  /// @brief Per-thread FFTW storage for ambiguity processing.
+  struct Workspace
+  {
+    AlignedVector dataXi;
+    AlignedVector dataYi;
+    AlignedVector dataZi;
+    AlignedVector dataDoppler;
+  };
+
+  /// @brief Number of correlation samples per pulse.
+  uint16_t nCorr;
+
+  /// @brief Number of samples to perform FFT per pulse.
+  uint32_t nfft;
+
+  /// @brief Number of new pulses per update.
+  uint16_t nPulsesStep;
+
+  /// @brief Ring slot of the oldest pulse.
+  uint16_t head;
+
+  /// @brief True if the ring holds a full window.
+  bool isValid;
+
+  /// @brief Absolute index of the first sample of the window.
+  uint64_t sampleStart;
+
+  /// @brief FFTW plans for ambiguity processing.
+  typename Fftw<T>::Plan fftXi;
+  typename Fftw<T>::Plan fftYi;
+  typename Fftw<T>::Plan fftZi;
+  typename Fftw<T>::Plan fftDoppler;
+
+  /// @brief FFTW storage for ambiguity processing, one per thread.
+  std::vector<Workspace> workspace;
+
+  /// @brief Ring of per-pulse range rows (pulse slot by delay).
+  std::unique_ptr<Map<Complex>> ring;
+
+  /// @brief Transposed ring for contiguous slow-time sequences.
+  std::unique_ptr<Map<Complex>> ringTranspose;
+
+  /// @brief Transposed map for contiguous Doppler processing.
+  std::unique_ptr<Map<Complex>> mapTranspose;
+
+};
+
+#endif
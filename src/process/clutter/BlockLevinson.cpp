@@ -0,0 +1,252 @@
+#include "BlockLevinson.h"
+#include <cmath>
+#include <algorithm>
+
+// constructor
+template <typename T>
+BlockLevinson<T>::BlockLevinson(uint32_t _n, uint32_t _m)
+{
+  n = _n;
+  m = _m;
+  r.resize(n * m * m);
+  rH.resize(n * m * m);
+  f.resize(n * m * m);
+  g.resize(n * m * m);
+  x.resize(n * m);
+  errorF.resize(m * m);
+  errorG.resize(m * m);
+  scaleF.resize(m * m);
+  scaleG.resize(m * m);
+  fi.resize(m * m);
+  gi.resize(m * m);
+  nextF.resize(m * m);
+  nextG.resize(m * m);
+  error.resize(m);
+}
+
+template <typename T>
+BlockLevinson<T>::~BlockLevinson()
+{
+}
+
+template <typename T>
+void BlockLevinson<T>::multiply(const std::complex<double> *a,
+  const std::complex<double> *b, std::complex<double> *out, bool isAdd) const
+{
+  // real arithmetic avoids the slow path of complex multiply for inf/nan
+  for (uint32_t i = 0; i < m; i++)
+  {
+    for (uint32_t j = 0; j < m; j++)
+    {
+      double re = isAdd ? out[i * m + j].real() : 0;
+      double im = isAdd ? out[i * m + j].imag() : 0;
+      for (uint32_t k = 0; k < m; k++)
+      {
+        const std::complex<double> &p = a[i * m + k];
+        const std::complex<double> &q = b[k * m + j];
+        re += p.real() * q.real() - p.imag() * q.imag();
+        im += p.real() * q.imag() + p.imag() * q.real();
+      }
+      out[i * m + j] = {re, im};
+    }
+  }
+}
+
+template <typename T>
+bool BlockLevinson<T>::invert(std::complex<double> *a) const
+{
+  // scale the singularity check to the block
+  double scale = 0;
+  for (uint32_t i = 0; i < m * m; i++)
+  {
+    scale = std::max(scale, std::abs(a[i]));
+  }
+  if (!std::isfinite(scale) || scale == 0)
+  {
+    return false;
+  }
+
+  std::vector<std::complex<double>> inverse(m * m, 0);
+  for (uint32_t i = 0; i < m; i++)
+  {
+    inverse[i * m + i] = 1;
+  }
+  for (uint32_t col = 0; col < m; col++)
+  {
+    uint32_t pivot = col;
+    for (uint32_t i = col + 1; i < m; i++)
+    {
+      if (std::abs(a[i * m + col]) > std::abs(a[pivot * m + col]))
+      {
+        pivot = i;
+      }
+    }
+    if (std::abs(a[pivot * m + col]) < 1e-12 * scale)
+    {
+      return false;
+    }
+    if (pivot != col)
+    {
+      for (uint32_t j = 0; j < m; j++)
+      {
+        std::swap(a[pivot * m + j], a[col * m + j]);
+        std::swap(inverse[pivot * m + j], inverse[col * m + j]);
+      }
+    }
+    std::complex<double> factor = 1.0 / a[col * m + col];
+    for (uint32_t j = 0; j < m; j++)
+    {
+      a[col * m + j] *= factor;
+      inverse[col * m + j] *= factor;
+    }
+    for (uint32_t i = 0; i < m; i++)
+    {
+      if (i == col)
+      {
+        continue;
+      }
+      std::complex<double> value = a[i * m + col];
+      for (uint32_t j = 0; j < m; j++)
+      {
+        a[i * m + j] -= value * a[col * m + j];
+        inverse[i * m + j] -= value * inverse[col * m + j];
+      }
+    }
+  }
+  std::copy(inverse.begin(), inverse.end(), a);
+  return true;
+}
+
+template <typename T>
+bool BlockLevinson<T>::solve(const std::vector<arma::Mat<Complex>> &_r,
+  const arma::Col<Complex> &b, arma::Col<Complex> &w)
+{
+  uint32_t i, j, k;
+  uint32_t mm = m * m;
+  for (k = 0; k < n; k++)
+  {
+    for (i = 0; i < m; i++)
+    {
+      for (j = 0; j < m; j++)
+      {
+        r[k * mm + i * m + j] = std::complex<double>(_r[k](i, j));
+        rH[k * mm + j * m + i] = std::conj(r[k * mm + i * m + j]);
+      }
+    }
+  }
+
+  // forward and backward vectors start as the inverse of r[0]
+  std::copy(r.begin(), r.begin() + mm, f.begin());
+  if (!invert(f.data()))
+  {
+    return false;
+  }
+  std::copy(f.begin(), f.begin() + mm, g.begin());
+  for (i = 0; i < m; i++)
+  {
+    x[i] = 0;
+    for (j = 0; j < m; j++)
+    {
+      x[i] += f[i * m + j] * std::complex<double>(b[j]);
+    }
+  }
+
+  for (uint32_t order = 1; order < n; order++)
+  {
+    // errors of extending the forward, backward and solution vectors
+    std::fill(errorF.begin(), errorF.end(), 0);
+    std::fill(errorG.begin(), errorG.end(), 0);
+    std::fill(error.begin(), error.end(), 0);
+    for (k = 0; k < order; k++)
+    {
+      const std::complex<double> *below = &rH[(order - k) * mm];
+      multiply(below, &f[k * mm], errorF.data(), true);
+      multiply(&r[(k + 1) * mm], &g[k * mm], errorG.data(), true);
+      for (i = 0; i < m; i++)
+      {
+        for (j = 0; j < m; j++)
+        {
+          error[i] += below[i * m + j] * x[k * m + j];
+        }
+      }
+    }
+
+    // scaleF = (I - errorG errorF)^-1 and scaleG = (I - errorF errorG)^-1
+    multiply(errorG.data(), errorF.data(), scaleF.data(), false);
+    multiply(errorF.data(), errorG.data(), scaleG.data(), false);
+    for (i = 0; i < mm; i++)
+    {
+      scaleF[i] = -scaleF[i];
+      scaleG[i] = -scaleG[i];
+    }
+    for (i = 0; i < m; i++)
+    {
+      scaleF[i * m + i] += 1.0;
+      scaleG[i * m + i] += 1.0;
+    }
+    if (!invert(scaleF.data()) || !invert(scaleG.data()))
+    {
+      return false;
+    }
+
+    // update in place from the end, as g[k-1] and f[k] are still required
+    std::fill(&f[order * mm], &f[order * mm] + mm, 0);
+    for (k = order + 1; k-- > 0;)
+    {
+      std::copy(&f[k * mm], &f[k * mm] + mm, fi.begin());
+      if (k == 0)
+      {
+        std::fill(gi.begin(), gi.end(), 0);
+      }
+      else
+      {
+        std::copy(&g[(k - 1) * mm], &g[(k - 1) * mm] + mm, gi.begin());
+      }
+      // f[k] = (fi - gi errorF) scaleF, g[k] = (gi - fi errorG) scaleG
+      multiply(gi.data(), errorF.data(), nextF.data(), false);
+      multiply(fi.data(), errorG.data(), nextG.data(), false);
+      for (i = 0; i < mm; i++)
+      {
+        nextF[i] = fi[i] - nextF[i];
+        nextG[i] = gi[i] - nextG[i];
+      }
+      multiply(nextF.data(), scaleF.data(), &f[k * mm], false);
+      multiply(nextG.data(), scaleG.data(), &g[k * mm], false);
+    }
+
+    // x = [x; 0] + g (b[order] - error)
+    for (i = 0; i < m; i++)
+    {
+      error[i] = std::complex<double>(b[order * m + i]) - error[i];
+      x[order * m + i] = 0;
+    }
+    for (k = 0; k <= order; k++)
+    {
+      for (i = 0; i < m; i++)
+      {
+        for (j = 0; j < m; j++)
+        {
+          x[k * m + i] += g[k * mm + i * m + j] * error[j];
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < n * m; i++)
+  {
+    if (!std::isfinite(std::abs(x[i])))
+    {
+      return false;
+    }
+  }
+  for (i = 0; i < n * m; i++)
+  {
+    w[i] = Complex(x[i]);
+  }
+
+  return true;
+}
+
+// allowed types
+template class BlockLevinson<double>;
+template class BlockLevinson<float>;
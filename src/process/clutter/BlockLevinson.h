@@ -0,0 +1,83 @@
+/// @file BlockLevinson.h
+/// @class BlockLevinson
+/// @brief A class to solve Hermitian block Toeplitz systems by block Levinson recursion.
+/// @details Extends the <a href="https://en.wikipedia.org/wiki/Levinson_recursion#Block_Levinson_algorithm">Levinson recursion</a> to blocks of m x m, in O(n^2 m^3) from the first block row of the matrix, without forming it.
+/// The recursion is carried out in double precision for either processing precision.
+/// @author 30hours
+
+#ifndef BLOCKLEVINSON_H
+#define BLOCKLEVINSON_H
+
+#include <stdint.h>
+#include <complex>
+#include <vector>
+#include <armadillo>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class BlockLevinson
+{
+public:
+
+  using Complex = std::complex<T>;
+
+private:
+  /// @brief Number of blocks.
+  uint32_t n;
+
+  /// @brief Size of each block.
+  uint32_t m;
+
+  /// @brief First block row and its conjugate transposed blocks, each block row-major.
+  /// @{
+  std::vector<std::complex<double>> r, rH;
+  /// @}
+
+  /// @brief Forward and backward block vectors of the recursion, each block row-major.
+  /// @{
+  std::vector<std::complex<double>> f, g;
+  /// @}
+
+  /// @brief Solution of the leading subsystem.
+  std::vector<std::complex<double>> x;
+
+  /// @brief Block storage for the recursion.
+  /// @{
+  std::vector<std::complex<double>> errorF, errorG, scaleF, scaleG, fi, gi, nextF, nextG, error;
+  /// @}
+
+  /// @brief Multiply blocks, out = a * b.
+  /// @param a First block.
+  /// @param b Second block.
+  /// @param out Output block.
+  /// @param isAdd True to add to out.
+  /// @return Void.
+  void multiply(const std::complex<double> *a, const std::complex<double> *b,
+    std::complex<double> *out, bool isAdd) const;
+
+  /// @brief Invert a block in place by Gauss-Jordan elimination with partial pivoting.
+  /// @param a Block to invert.
+  /// @return True if the block is numerically invertible.
+  bool invert(std::complex<double> *a) const;
+
+public:
+  /// @brief Constructor.
+  /// @param n Number of blocks.
+  /// @param m Size of each block.
+  /// @return The object.
+  BlockLevinson(uint32_t n, uint32_t m);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~BlockLevinson();
+
+  /// @brief Solve A w = b where A is Hermitian block Toeplitz with first block row r.
+  /// @details Block (i, j) of A is r[j-i] above the diagonal and r[i-j]^H below.
+  /// @param r First block row of A, n blocks of m x m, where r[0] is Hermitian.
+  /// @param b Right hand side, n * m long with block k at k * m.
+  /// @param w Solution, unchanged on failure.
+  /// @return True if successful.
+  bool solve(const std::vector<arma::Mat<Complex>> &r, const arma::Col<Complex> &b, arma::Col<Complex> &w);
+};
+
+#endif
@@ -0,0 +1,33 @@
+/// @file ClutterFilter.h
+/// @class ClutterFilter
+/// @brief An abstract class for clutter filters.
+/// @details Clutter filters remove the direct signal and static clutter from the surveillance signal in place, using the reference signal.
+/// @author 30hours
+
+#ifndef CLUTTERFILTER_H
+#define CLUTTERFILTER_H
+
+#include "data/IqData.h"
+#include "process/spectrum/ReferenceSpectrum.h"
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class ClutterFilter
+{
+public:
+
+  using Complex = std::complex<T>;
+
+  /// @brief Destructor.
+  /// @return Void.
+  virtual ~ClutterFilter() = default;
+
+  /// @brief Implement the clutter filter.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples, filtered in place.
+  /// @param reference Cached reference spectrum of this CPI, used if the filter can.
+  /// @return True if clutter filter successful.
+  virtual bool process(IqData *x, IqData *y, const ReferenceSpectrum<T> *reference = nullptr) = 0;
+};
+
+#endif
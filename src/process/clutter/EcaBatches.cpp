@@ -0,0 +1,209 @@
+#include "EcaBatches.h"
+#include "process/meta/HammingNumber.h"
+#include <complex>
+#include <iostream>
+#include <stdexcept>
+#include <atomic>
+
+// constructor
+template <typename T>
+EcaBatches<T>::EcaBatches(int32_t _delayMin, int32_t _delayMax, uint32_t _nSamples,
+  uint32_t _nBatches, uint32_t _nThreads, Autotune<T> *_autotune)
+{
+  // input
+  delayMin = _delayMin;
+  delayMax = _delayMax;
+  nBins = delayMax - delayMin;
+  nSamples = _nSamples;
+  nBatches = std::max<uint32_t>(1, _nBatches);
+  nBatch = nSamples / nBatches;
+  if (nBins == 0 || nBatch < nBins)
+  {
+    throw std::invalid_argument("Clutter batch of " + std::to_string(nBatch) +
+      " samples is shorter than the " + std::to_string(nBins) + " filter bins");
+  }
+
+  // longest batch with linear correlation and convolution
+  uint32_t nBatchMax = nSamples - (nBatches - 1) * nBatch;
+  nfft = nBatchMax + 2 * (nBins - 1);
+  if (_autotune != nullptr)
+  {
+    nfft = _autotune->fft_length("clutter_batch", nfft);
+  }
+  else
+  {
+    nfft = next_hamming(nfft - 1);
+  }
+
+  // initialise data
+  dataX.resize(nSamples);
+  dataY.resize(nSamples);
+  dataOut.resize(nSamples);
+  dataRaw.resize(nSamples);
+  weights.assign(nBatches, arma::Col<Complex>(nBins));
+  pool = std::make_unique<ThreadPool>(std::max<uint32_t>(1, _nThreads));
+  workspace.resize(pool->get_n_threads());
+  for (auto &ws : workspace)
+  {
+    ws.E.resize(nfft);
+    ws.Y.resize(nfft);
+    ws.A.resize(nfft);
+    ws.B.resize(nfft);
+    ws.W.resize(nfft);
+    ws.a = arma::Col<Complex>(nBins);
+    ws.b = arma::Col<Complex>(nBins);
+    ws.w = arma::Col<Complex>(nBins);
+    ws.levinson = std::make_unique<Levinson<T>>(nBins);
+  }
+
+  // compute FFTW plans in constructor, executed in place on each workspace
+  fftForward = Fftw<T>::plan_dft_1d(nfft, workspace[0].E.data(),
+    workspace[0].E.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  fftBackward = Fftw<T>::plan_dft_1d(nfft, workspace[0].A.data(),
+    workspace[0].A.data(), FFTW_BACKWARD, FFTW_ESTIMATE);
+}
+
+template <typename T>
+EcaBatches<T>::~EcaBatches()
+{
+  Fftw<T>::destroy_plan(fftForward);
+  Fftw<T>::destroy_plan(fftBackward);
+}
+
+template <typename T>
+bool EcaBatches<T>::process(IqData *x, IqData *y, const ReferenceSpectrum<T> *reference)
+{
+  (void)reference;
+  uint32_t i;
+
+  // shift reference by delayMin as in WienerHopf
+  x->copy(dataRaw.data(), nSamples);
+  for (i = 0; i < nSamples; i++)
+  {
+    dataX[i] = Complex(dataRaw[((((int64_t)i - delayMin) % nSamples) + nSamples) % nSamples]);
+  }
+  y->copy(dataRaw.data(), nSamples);
+  for (i = 0; i < nSamples; i++)
+  {
+    dataY[i] = Complex(dataRaw[i]);
+  }
+
+  // batches are independent
+  std::atomic<bool> success{true};
+  pool->parallel_for(nBatches, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    for (uint32_t j = start; j < end; j++)
+    {
+      if (!process_batch(j, workspace[thread]))
+      {
+        success = false;
+      }
+    }
+  });
+  if (!success)
+  {
+    std::cerr << "Batch solve failed, skip clutter filter" << std::endl;
+    return false;
+  }
+
+  y->clear();
+  for (i = 0; i < nSamples; i++)
+  {
+    y->push_back(std::complex<double>(dataOut[i]));
+  }
+
+  return true;
+}
+
+template <typename T>
+bool EcaBatches<T>::process_batch(uint32_t index, Workspace &ws)
+{
+  uint32_t i;
+  uint32_t start = index * nBatch;
+  uint32_t length = (index == nBatches - 1) ? nSamples - start : nBatch;
+  uint32_t nPre = nBins - 1;
+
+  // reference from nBins - 1 samples before the batch, surveillance aligned to its end
+  // zero before the CPI, so the first batch is a linear convolution
+  for (i = 0; i < length + nPre; i++)
+  {
+    ws.E[i] = start + i < nPre ? Complex(0, 0) : dataX[start + i - nPre];
+  }
+  for (i = length + nPre; i < nfft; i++)
+  {
+    ws.E[i] = {0, 0};
+  }
+  for (i = 0; i < nPre; i++)
+  {
+    ws.Y[i] = {0, 0};
+  }
+  for (i = 0; i < length; i++)
+  {
+    ws.Y[nPre + i] = dataY[start + i];
+  }
+  for (i = length + nPre; i < nfft; i++)
+  {
+    ws.Y[i] = {0, 0};
+  }
+  Fftw<T>::execute_dft(fftForward, ws.E.data(), ws.E.data());
+  Fftw<T>::execute_dft(fftForward, ws.Y.data(), ws.Y.data());
+
+  // auto-correlation vector a and cross-correlation vector b
+  for (i = 0; i < nfft; i++)
+  {
+    ws.A[i] = ws.E[i] * std::conj(ws.E[i]);
+    ws.B[i] = ws.Y[i] * std::conj(ws.E[i]);
+  }
+  Fftw<T>::execute_dft(fftBackward, ws.A.data(), ws.A.data());
+  Fftw<T>::execute_dft(fftBackward, ws.B.data(), ws.B.data());
+  for (i = 0; i < nBins; i++)
+  {
+    ws.a[i] = std::conj(ws.A[i]) / (T)nfft;
+    ws.b[i] = ws.B[i] / (T)nfft;
+  }
+
+  // compute batch weights
+  if (!ws.levinson->solve(ws.a, ws.b, ws.w))
+  {
+    return false;
+  }
+
+  // subtract the batch clutter estimate
+  weights[index] = ws.w;
+  for (i = 0; i < nBins; i++)
+  {
+    ws.W[i] = ws.w[i];
+  }
+  for (i = nBins; i < nfft; i++)
+  {
+    ws.W[i] = {0, 0};
+  }
+  Fftw<T>::execute_dft(fftForward, ws.W.data(), ws.W.data());
+  for (i = 0; i < nfft; i++)
+  {
+    ws.A[i] = ws.E[i] * ws.W[i];
+  }
+  Fftw<T>::execute_dft(fftBackward, ws.A.data(), ws.A.data());
+  for (i = 0; i < length; i++)
+  {
+    dataOut[start + i] = dataY[start + i] - ws.A[nPre + i] / (T)nfft;
+  }
+
+  return true;
+}
+
+template <typename T>
+uint32_t EcaBatches<T>::get_n_batches() const
+{
+  return nBatches;
+}
+
+template <typename T>
+arma::Col<typename EcaBatches<T>::Complex> EcaBatches<T>::get_weights(uint32_t index) const
+{
+  return weights.at(index);
+}
+
+// allowed types
+template class EcaBatches<double>;
+template class EcaBatches<float>;
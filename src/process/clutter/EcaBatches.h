@@ -0,0 +1,148 @@
+/// @file EcaBatches.h
+/// @class EcaBatches
+/// @brief A class to implement a batched Extensive Cancellation Algorithm (ECA-B) clutter filter.
+/// @details Splits the CPI into contiguous batches and removes the projection of each batch onto its own delayed reference subspace.
+/// Each batch solves a small Hermitian Toeplitz system by Levinson recursion, so the weights track clutter that varies over the CPI.
+/// Batches are independent and run in parallel on a worker pool, with per-thread buffers.
+/// The reference before the CPI is taken as zero, so the clutter estimate is a linear convolution as in WienerHopf.
+/// @author 30hours
+
+#ifndef ECABATCHES_H
+#define ECABATCHES_H
+
+#include "ClutterFilter.h"
+#include "data/IqData.h"
+#include "data/meta/AlignedAllocator.h"
+#include "process/meta/Fftw.h"
+#include "process/meta/Autotune.h"
+#include "process/utility/ThreadPool.h"
+#include "Levinson.h"
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <armadillo>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class EcaBatches : public ClutterFilter<T>
+{
+public:
+
+  using Complex = std::complex<T>;
+
+private:
+
+  using AlignedVector = std::vector<Complex, AlignedAllocator<Complex>>;
+
+  /// @brief Per-thread storage for batch processing.
+  struct Workspace
+  {
+    /// @brief Batch reference including the nBins - 1 samples before it.
+    AlignedVector E;
+
+    /// @brief Batch surveillance aligned to the end of E.
+    AlignedVector Y;
+
+    /// @brief Correlation and convolution storage.
+    /// @{
+    AlignedVector A, B;
+    /// @}
+
+    /// @brief Padded weights.
+    AlignedVector W;
+
+    /// @brief Auto-correlation, cross-correlation and weights vectors.
+    /// @{
+    arma::Col<Complex> a, b, w;
+    /// @}
+
+    /// @brief Toeplitz solver for the weights.
+    std::unique_ptr<Levinson<T>> levinson;
+  };
+
+  /// @brief Minimum clutter filter delay (bins).
+  int32_t delayMin;
+
+  /// @brief Maximum clutter filter delay (bins).
+  int32_t delayMax;
+
+  /// @brief Number of bins (delayMax - delayMin).
+  uint32_t nBins;
+
+  /// @brief Number of samples per CPI.
+  uint32_t nSamples;
+
+  /// @brief Number of batches per CPI.
+  uint32_t nBatches;
+
+  /// @brief Number of samples per batch, the last batch takes the remainder.
+  uint32_t nBatch;
+
+  /// @brief FFT length of the batch correlations, at least the longest batch + 2 * (nBins - 1).
+  uint32_t nfft;
+
+  /// @brief FFTW plans, executed on the per-thread storage.
+  /// @{
+  typename Fftw<T>::Plan fftForward, fftBackward;
+  /// @}
+
+  /// @brief Shifted reference and surveillance for the CPI.
+  /// @{
+  AlignedVector dataX, dataY;
+  /// @}
+
+  /// @brief Filtered surveillance for the CPI.
+  AlignedVector dataOut;
+
+  /// @brief Staging buffer for samples copied from IqData.
+  std::vector<std::complex<double>, AlignedAllocator<std::complex<double>>> dataRaw;
+
+  /// @brief Weights of each batch in the last CPI.
+  std::vector<arma::Col<Complex>> weights;
+
+  /// @brief Per-thread storage.
+  std::vector<Workspace> workspace;
+
+  /// @brief Worker pool for processing.
+  std::unique_ptr<ThreadPool> pool;
+
+  /// @brief Filter a single batch into dataOut.
+  /// @param index Batch index.
+  /// @param ws Thread storage.
+  /// @return True if the batch weights were solved.
+  bool process_batch(uint32_t index, Workspace &ws);
+
+public:
+  /// @brief Constructor.
+  /// @param delayMin Minimum clutter filter delay (bins).
+  /// @param delayMax Maximum clutter filter delay (bins).
+  /// @param nSamples Number of samples per CPI.
+  /// @param nBatches Number of batches per CPI.
+  /// @param nThreads Number of threads to process batches.
+  /// @param autotune Autotuner to select the batch FFT length, 5-smooth if not set.
+  /// @return The object.
+  /// @throws std::invalid_argument If a batch is shorter than the number of bins.
+  EcaBatches(int32_t delayMin, int32_t delayMax, uint32_t nSamples, uint32_t nBatches, uint32_t nThreads = 1, Autotune<T> *autotune = nullptr);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~EcaBatches();
+
+  /// @brief Implement the clutter filter.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples.
+  /// @param reference Unused, as the batches are transformed separately.
+  /// @return True if clutter filter successful for all batches.
+  bool process(IqData *x, IqData *y, const ReferenceSpectrum<T> *reference = nullptr) override;
+
+  /// @brief Get the number of batches per CPI.
+  /// @return Number of batches.
+  uint32_t get_n_batches() const;
+
+  /// @brief Get the weights of a batch in the last CPI.
+  /// @param index Batch index.
+  /// @return Weights from delayMin to delayMax - 1.
+  arma::Col<Complex> get_weights(uint32_t index) const;
+};
+
+#endif
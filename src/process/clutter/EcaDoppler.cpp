@@ -0,0 +1,268 @@
+#include "EcaDoppler.h"
+#include <complex>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+
+// constructor
+template <typename T>
+EcaDoppler<T>::EcaDoppler(int32_t _delayMin, int32_t _delayMax, uint32_t _nSamples,
+  uint32_t _fs, const std::vector<double> &_doppler)
+{
+  // input
+  delayMin = _delayMin;
+  delayMax = _delayMax;
+  nBins = delayMax - delayMin;
+  nSamples = _nSamples;
+  if (nBins == 0)
+  {
+    throw std::invalid_argument("Clutter filter requires at least 1 bin");
+  }
+  cost = {0, 0, 0, 0};
+
+  // round Doppler shifts to CPI bins
+  shift.push_back(0);
+  for (double doppler : _doppler)
+  {
+    shift.push_back((int32_t)std::lround(doppler * nSamples / _fs));
+  }
+  std::sort(shift.begin(), shift.end());
+  shift.erase(std::unique(shift.begin(), shift.end()), shift.end());
+  if (shift.front() <= -(int64_t)nSamples / 2 || shift.back() >= (int64_t)nSamples / 2)
+  {
+    throw std::invalid_argument("Clutter Doppler shifts must be within half the sampling frequency");
+  }
+  for (int32_t s1 : shift)
+  {
+    for (int32_t s2 : shift)
+    {
+      difference.push_back(s2 - s1);
+    }
+  }
+  std::sort(difference.begin(), difference.end());
+  difference.erase(std::unique(difference.begin(), difference.end()), difference.end());
+  lag.assign(difference.size(), std::vector<Complex>(nBins));
+  phase.assign(shift.size(), std::vector<Complex>(nBins));
+  for (size_t d = 0; d < shift.size(); d++)
+  {
+    for (uint32_t k = 0; k < nBins; k++)
+    {
+      double angle = -2.0 * M_PI * (((int64_t)shift[d] * k) % (int64_t)nSamples) / nSamples;
+      phase[d][k] = Complex(std::polar(1.0, angle));
+    }
+  }
+
+  // initialise data
+  uint32_t nShifts = shift.size();
+  r.assign(nBins, arma::Mat<Complex>(nShifts, nShifts));
+  b = arma::Col<Complex>(nBins * nShifts);
+  w = arma::Col<Complex>(nBins * nShifts);
+  levinson = std::make_unique<BlockLevinson<T>>(nBins, nShifts);
+  dataX.resize(nSamples);
+  dataY.resize(nSamples);
+  specX.resize(nSamples);
+  specY.resize(nSamples);
+  work.resize(nSamples);
+  clutter.resize(nSamples);
+  filt.resize(nSamples);
+  dataRaw.resize(nSamples);
+  wShift = arma::Col<Complex>(nBins);
+  convolution = std::make_unique<OverlapSave<T>>(nBins, nSamples);
+
+  // compute FFTW plans in constructor, executed in place on each buffer
+  fftForward = Fftw<T>::plan_dft_1d(nSamples, work.data(), work.data(),
+    FFTW_FORWARD, FFTW_ESTIMATE);
+  fftBackward = Fftw<T>::plan_dft_1d(nSamples, work.data(), work.data(),
+    FFTW_BACKWARD, FFTW_ESTIMATE);
+}
+
+template <typename T>
+EcaDoppler<T>::~EcaDoppler()
+{
+  Fftw<T>::destroy_plan(fftForward);
+  Fftw<T>::destroy_plan(fftBackward);
+}
+
+template <typename T>
+uint32_t EcaDoppler<T>::rotate(uint32_t f, int32_t _shift) const
+{
+  // shifts are rounded from small Doppler, so within a CPI of bins
+  int64_t index = (int64_t)f - _shift;
+  if (index < 0)
+  {
+    index += nSamples;
+  }
+  else if (index >= nSamples)
+  {
+    index -= nSamples;
+  }
+  return (uint32_t)index;
+}
+
+template <typename T>
+bool EcaDoppler<T>::process(IqData *x, IqData *y, const ReferenceSpectrum<T> *reference)
+{
+  uint32_t i, k, d, e;
+  uint32_t nShifts = shift.size();
+  auto t0 = std::chrono::steady_clock::now();
+  cost.nFft = 0;
+
+  // shift reference by delayMin as in WienerHopf
+  x->copy(dataRaw.data(), nSamples);
+  for (i = 0; i < nSamples; i++)
+  {
+    dataX[i] = Complex(dataRaw[((((int64_t)i - delayMin) % nSamples) + nSamples) % nSamples]);
+  }
+  y->copy(dataRaw.data(), nSamples);
+  for (i = 0; i < nSamples; i++)
+  {
+    dataY[i] = Complex(dataRaw[i]);
+  }
+
+  // spectrum of signals, shifting the cached reference spectrum if available
+  if (reference != nullptr && reference->get_n() == nSamples)
+  {
+    if (shiftX.empty())
+    {
+      shiftX.resize(nSamples);
+      for (i = 0; i < nSamples; i++)
+      {
+        double angle = -2.0 * M_PI * (((int64_t)i * delayMin) % (int64_t)nSamples) / nSamples;
+        shiftX[i] = Complex(std::polar(1.0, angle));
+      }
+    }
+    const Complex *spectrumX = reference->get_spectrum();
+    for (i = 0; i < nSamples; i++)
+    {
+      specX[i] = spectrumX[i] * shiftX[i];
+    }
+  }
+  else
+  {
+    std::copy(dataX.begin(), dataX.end(), specX.begin());
+    Fftw<T>::execute_dft(fftForward, specX.data(), specX.data());
+    cost.nFft++;
+  }
+  std::copy(dataY.begin(), dataY.end(), specY.begin());
+  Fftw<T>::execute_dft(fftForward, specY.data(), specY.data());
+  cost.nFft++;
+
+  // correlation lags of the reference with itself per shift difference
+  for (size_t j = 0; j < difference.size(); j++)
+  {
+    for (i = 0; i < nSamples; i++)
+    {
+      work[i] = std::conj(specX[i]) * specX[rotate(i, difference[j])];
+    }
+    Fftw<T>::execute(fftForward);
+    cost.nFft++;
+    for (k = 0; k < nBins; k++)
+    {
+      lag[j][k] = work[k] / (T)nSamples;
+    }
+  }
+
+  // block k holds the correlation of shift d with shift e at lag k
+  for (d = 0; d < nShifts; d++)
+  {
+    for (e = 0; e < nShifts; e++)
+    {
+      size_t j = std::lower_bound(difference.begin(), difference.end(),
+        shift[e] - shift[d]) - difference.begin();
+      for (k = 0; k < nBins; k++)
+      {
+        r[k](d, e) = phase[d][k] * lag[j][k];
+      }
+    }
+  }
+
+  // cross-correlation of each shifted reference with the surveillance
+  for (d = 0; d < nShifts; d++)
+  {
+    for (i = 0; i < nSamples; i++)
+    {
+      work[i] = std::conj(specX[rotate(i, shift[d])]) * specY[i];
+    }
+    Fftw<T>::execute(fftBackward);
+    cost.nFft++;
+    for (k = 0; k < nBins; k++)
+    {
+      b[k * nShifts + d] = work[k] / (T)nSamples;
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  // compute weights by block Levinson recursion
+  if (!levinson->solve(r, b, w))
+  {
+    std::cerr << "Block Levinson failed, skip clutter filter" << std::endl;
+    return false;
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  // clutter estimate is the sum of each shifted reference filtered by its weights,
+  // by linear convolution so the end of the CPI does not wrap into the start
+  std::fill(clutter.begin(), clutter.end(), Complex(0, 0));
+  for (d = 0; d < nShifts; d++)
+  {
+    // shifted reference in time, the zero shift is the reference itself
+    const Complex *shiftedX = dataX.data();
+    if (shift[d] != 0)
+    {
+      for (i = 0; i < nSamples; i++)
+      {
+        work[i] = specX[rotate(i, shift[d])] / (T)nSamples;
+      }
+      Fftw<T>::execute(fftBackward);
+      cost.nFft++;
+      shiftedX = work.data();
+    }
+    for (k = 0; k < nBins; k++)
+    {
+      wShift[k] = w[k * nShifts + d];
+    }
+    convolution->set_weights(wShift);
+    convolution->apply(shiftedX, filt.data());
+    for (i = 0; i < nSamples; i++)
+    {
+      clutter[i] += filt[i];
+    }
+  }
+
+  y->clear();
+  for (i = 0; i < nSamples; i++)
+  {
+    y->push_back(std::complex<double>(dataY[i] - clutter[i]));
+  }
+  auto t3 = std::chrono::steady_clock::now();
+
+  cost.correlation = std::chrono::duration<double, std::milli>(t1 - t0).count();
+  cost.solve = std::chrono::duration<double, std::milli>(t2 - t1).count();
+  cost.filter = std::chrono::duration<double, std::milli>(t3 - t2).count();
+
+  return true;
+}
+
+template <typename T>
+std::vector<int32_t> EcaDoppler<T>::get_shift() const
+{
+  return shift;
+}
+
+template <typename T>
+arma::Col<typename EcaDoppler<T>::Complex> EcaDoppler<T>::get_weights() const
+{
+  return w;
+}
+
+template <typename T>
+typename EcaDoppler<T>::Cost EcaDoppler<T>::get_cost() const
+{
+  return cost;
+}
+
+// allowed types
+template class EcaDoppler<double>;
+template class EcaDoppler<float>;
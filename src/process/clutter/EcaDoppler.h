@@ -0,0 +1,170 @@
+/// @file EcaDoppler.h
+/// @class EcaDoppler
+/// @brief A class to implement a Doppler-extended Extensive Cancellation Algorithm (ECA-CD) clutter filter.
+/// @details Cancels each delay of the clutter filter at a set of small Doppler shifts as well as zero Doppler, for sea clutter and rotating or moving scatterers.
+/// Doppler shifts are rounded to CPI bins, so each shifted reference spectrum is a rotation of a single reference FFT.
+/// The correlations of the shifted copies only depend on the difference of shifts, so one FFT is computed per difference.
+/// The normal equations are Hermitian block Toeplitz with a block per delay, solved by block Levinson recursion.
+/// The clutter estimate is applied by linear convolution of each shifted reference with its weights, as in WienerHopf.
+/// @author 30hours
+
+#ifndef ECADOPPLER_H
+#define ECADOPPLER_H
+
+#include "ClutterFilter.h"
+#include "data/IqData.h"
+#include "data/meta/AlignedAllocator.h"
+#include "process/meta/Fftw.h"
+#include "process/spectrum/ReferenceSpectrum.h"
+#include "BlockLevinson.h"
+#include "OverlapSave.h"
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <armadillo>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class EcaDoppler : public ClutterFilter<T>
+{
+public:
+
+  using Complex = std::complex<T>;
+
+  /// @brief Processing cost of the last CPI.
+  struct Cost
+  {
+    /// @brief Time to compute the correlations (ms).
+    double correlation;
+
+    /// @brief Time to solve the weights (ms).
+    double solve;
+
+    /// @brief Time to subtract the clutter estimate (ms).
+    double filter;
+
+    /// @brief Number of FFTs of nSamples.
+    uint32_t nFft;
+  };
+
+private:
+
+  using AlignedVector = std::vector<Complex, AlignedAllocator<Complex>>;
+
+  /// @brief Minimum clutter filter delay (bins).
+  int32_t delayMin;
+
+  /// @brief Maximum clutter filter delay (bins).
+  int32_t delayMax;
+
+  /// @brief Number of bins (delayMax - delayMin).
+  uint32_t nBins;
+
+  /// @brief Number of samples per CPI.
+  uint32_t nSamples;
+
+  /// @brief Doppler shifts of the reference (CPI bins), including 0.
+  std::vector<int32_t> shift;
+
+  /// @brief Unique differences between Doppler shifts (CPI bins).
+  std::vector<int32_t> difference;
+
+  /// @brief Correlation lags of the reference with itself shifted by each difference.
+  std::vector<std::vector<Complex>> lag;
+
+  /// @brief Phase of each Doppler shift at each lag, exp(-j 2 pi shift lag / nSamples).
+  std::vector<std::vector<Complex>> phase;
+
+  /// @brief FFTW plans, executed in place on the CPI storage.
+  /// @{
+  typename Fftw<T>::Plan fftForward, fftBackward;
+  /// @}
+
+  /// @brief Shifted reference and surveillance for the CPI.
+  /// @{
+  AlignedVector dataX, dataY;
+  /// @}
+
+  /// @brief Spectrum of the shifted reference and surveillance.
+  /// @{
+  AlignedVector specX, specY;
+  /// @}
+
+  /// @brief FFT storage for correlations and weights.
+  AlignedVector work;
+
+  /// @brief Clutter estimate, and one shifted reference filtered by its weights.
+  /// @{
+  AlignedVector clutter, filt;
+  /// @}
+
+  /// @brief Weights of one Doppler shift.
+  arma::Col<Complex> wShift;
+
+  /// @brief Convolution of a shifted reference with its weights.
+  std::unique_ptr<OverlapSave<T>> convolution;
+
+  /// @brief Staging buffer for samples copied from IqData.
+  std::vector<std::complex<double>, AlignedAllocator<std::complex<double>>> dataRaw;
+
+  /// @brief Phase ramp to shift the cached reference spectrum by delayMin.
+  /// @details Computed on first use of a cached reference spectrum.
+  std::vector<Complex> shiftX;
+
+  /// @brief First block row of the normal equations, a block of shifts per delay.
+  std::vector<arma::Mat<Complex>> r;
+
+  /// @brief Cross-correlation vector, indexed delay * nShifts + shift.
+  arma::Col<Complex> b;
+
+  /// @brief Weights vector, indexed delay * nShifts + shift.
+  arma::Col<Complex> w;
+
+  /// @brief Block Toeplitz solver for the weights.
+  std::unique_ptr<BlockLevinson<T>> levinson;
+
+  /// @brief Processing cost of the last CPI.
+  Cost cost;
+
+  /// @brief Index of the reference spectrum rotated by a Doppler shift.
+  /// @param f Frequency bin.
+  /// @param shift Doppler shift (CPI bins).
+  /// @return Index of bin f - shift.
+  uint32_t rotate(uint32_t f, int32_t shift) const;
+
+public:
+  /// @brief Constructor.
+  /// @param delayMin Minimum clutter filter delay (bins).
+  /// @param delayMax Maximum clutter filter delay (bins).
+  /// @param nSamples Number of samples per CPI.
+  /// @param fs Sampling frequency (Hz).
+  /// @param doppler Doppler shifts to cancel besides zero (Hz), rounded to CPI bins.
+  /// @return The object.
+  /// @throws std::invalid_argument If there are no filter bins or a Doppler shift is out of range.
+  EcaDoppler(int32_t delayMin, int32_t delayMax, uint32_t nSamples, uint32_t fs, const std::vector<double> &doppler);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~EcaDoppler();
+
+  /// @brief Implement the clutter filter.
+  /// @param x Reference samples.
+  /// @param y Surveillance samples.
+  /// @param reference Cached reference spectrum of this CPI, used if the FFT length matches.
+  /// @return True if clutter filter successful.
+  bool process(IqData *x, IqData *y, const ReferenceSpectrum<T> *reference = nullptr) override;
+
+  /// @brief Get the Doppler shifts cancelled per delay.
+  /// @return Doppler shifts (CPI bins), including 0.
+  std::vector<int32_t> get_shift() const;
+
+  /// @brief Get the weights of the last CPI.
+  /// @return Weights, indexed delay * nShifts + shift.
+  arma::Col<Complex> get_weights() const;
+
+  /// @brief Get the processing cost of the last CPI.
+  /// @return Cost.
+  Cost get_cost() const;
+};
+
+#endif
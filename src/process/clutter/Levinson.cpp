@@ -0,0 +1,84 @@
+#include "Levinson.h"
+#include <cmath>
+
+// constructor
+template <typename T>
+Levinson<T>::Levinson(uint32_t _n)
+{
+  n = _n;
+  f.resize(n);
+  g.resize(n);
+  x.resize(n);
+}
+
+template <typename T>
+Levinson<T>::~Levinson()
+{
+}
+
+template <typename T>
+bool Levinson<T>::solve(const arma::Col<Complex> &a, const arma::Col<Complex> &b, arma::Col<Complex> &w)
+{
+  // element (i, j) of A is a[j-i] above the diagonal and conj(a[i-j]) below
+  double r0 = std::real(a[0]);
+  if (!(r0 > 0) || !std::isfinite(r0))
+  {
+    return false;
+  }
+  f[0] = 1.0 / r0;
+  g[0] = 1.0 / r0;
+  x[0] = std::complex<double>(b[0]) / r0;
+
+  for (uint32_t m = 1; m < n; m++)
+  {
+    // errors of extending the forward, backward and solution vectors
+    std::complex<double> errorF = 0, errorG = 0, errorX = 0;
+    for (uint32_t i = 0; i < m; i++)
+    {
+      std::complex<double> below = std::conj(std::complex<double>(a[m - i]));
+      errorF += below * f[i];
+      errorX += below * x[i];
+      errorG += std::complex<double>(a[i + 1]) * g[i];
+    }
+    std::complex<double> denominator = 1.0 - errorF * errorG;
+    if (!std::isfinite(std::abs(denominator)) || std::abs(denominator) < 1e-12)
+    {
+      return false;
+    }
+
+    // update in place from the end, as g[i-1] and f[i] are still required
+    f[m] = 0;
+    for (uint32_t i = m + 1; i-- > 0;)
+    {
+      std::complex<double> fi = f[i];
+      std::complex<double> gi = (i == 0) ? 0 : g[i - 1];
+      f[i] = (fi - errorF * gi) / denominator;
+      g[i] = (gi - errorG * fi) / denominator;
+    }
+
+    std::complex<double> scale = std::complex<double>(b[m]) - errorX;
+    x[m] = 0;
+    for (uint32_t i = 0; i <= m; i++)
+    {
+      x[i] += scale * g[i];
+    }
+  }
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    if (!std::isfinite(std::abs(x[i])))
+    {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < n; i++)
+  {
+    w[i] = Complex(x[i]);
+  }
+
+  return true;
+}
+
+// allowed types
+template class Levinson<double>;
+template class Levinson<float>;
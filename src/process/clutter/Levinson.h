@@ -0,0 +1,55 @@
+/// @file Levinson.h
+/// @class Levinson
+/// @brief A class to solve Hermitian Toeplitz systems by Levinson recursion.
+/// @details Implements the <a href="https://en.wikipedia.org/wiki/Levinson_recursion">Levinson recursion</a> in O(n^2) from the first row of the matrix, without forming it.
+/// The recursion is carried out in double precision for either processing precision.
+/// @author 30hours
+
+#ifndef LEVINSON_H
+#define LEVINSON_H
+
+#include <stdint.h>
+#include <complex>
+#include <vector>
+#include <armadillo>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class Levinson
+{
+public:
+
+  using Complex = std::complex<T>;
+
+private:
+  /// @brief Order of the system.
+  uint32_t n;
+
+  /// @brief Forward and backward vectors of the recursion.
+  /// @{
+  std::vector<std::complex<double>> f, g;
+  /// @}
+
+  /// @brief Solution of the leading subsystem.
+  std::vector<std::complex<double>> x;
+
+public:
+  /// @brief Constructor.
+  /// @param n Order of the system.
+  /// @return The object.
+  Levinson(uint32_t n);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~Levinson();
+
+  /// @brief Solve A w = b where A is Hermitian Toeplitz with first row a.
+  /// @details Fails if a leading submatrix is numerically singular, when a Cholesky solve should be used instead.
+  /// @param a First row of A, where a[0] is real.
+  /// @param b Right hand side.
+  /// @param w Solution, unchanged on failure.
+  /// @return True if successful.
+  bool solve(const arma::Col<Complex> &a, const arma::Col<Complex> &b, arma::Col<Complex> &w);
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "OverlapSave.h"
+#include "process/meta/HammingNumber.h"
+#include <complex>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// constructor
+template <typename T>
+OverlapSave<T>::OverlapSave(uint32_t _nTaps, uint32_t _nSamples, Autotune<T> *_autotune)
+{
+  nTaps = std::max<uint32_t>(1, _nTaps);
+  nSamples = _nSamples;
+  nBlock = 0;
+  nStep = nSamples;
+  taps.resize(nTaps);
+
+  if (nTaps > N_DIRECT_MAX)
+  {
+    nBlock = block_length(nTaps, nSamples);
+    if (_autotune != nullptr)
+    {
+      nBlock = _autotune->fft_length("clutter_block", nBlock);
+    }
+    nStep = nBlock - nTaps + 1;
+
+    // compute FFTW plans in constructor
+    weights.resize(nBlock);
+    block.resize(nBlock);
+    fftBlock = Fftw<T>::plan_dft_1d(nBlock, block.data(), block.data(),
+      FFTW_FORWARD, FFTW_ESTIMATE);
+    ifftBlock = Fftw<T>::plan_dft_1d(nBlock, block.data(), block.data(),
+      FFTW_BACKWARD, FFTW_ESTIMATE);
+  }
+}
+
+template <typename T>
+OverlapSave<T>::~OverlapSave()
+{
+  if (nBlock > 0)
+  {
+    Fftw<T>::destroy_plan(fftBlock);
+    Fftw<T>::destroy_plan(ifftBlock);
+  }
+}
+
+template <typename T>
+uint32_t OverlapSave<T>::block_length(uint32_t nTaps, uint32_t nSamples)
+{
+  // single block covers the full linear convolution
+  uint32_t nMax = next_hamming(nSamples + nTaps - 2);
+  uint32_t best = nMax;
+  double costBest = std::numeric_limits<double>::max();
+  for (uint32_t n = next_hamming(2 * nTaps - 1); n <= nMax; n = next_hamming(n))
+  {
+    // work of all blocks, 2 FFTs of n log n and the copy and multiply of n
+    uint32_t nBlocks = (nSamples + (n - nTaps)) / (n - nTaps + 1);
+    double cost = (double)nBlocks * n * (2 * std::log2((double)n) + 4);
+    if (cost < costBest)
+    {
+      costBest = cost;
+      best = n;
+    }
+  }
+  return best;
+}
+
+template <typename T>
+void OverlapSave<T>::set_weights(const arma::Col<Complex> &w)
+{
+  uint32_t i;
+  for (i = 0; i < nTaps; i++)
+  {
+    taps[i] = w[i];
+  }
+  if (nBlock == 0)
+  {
+    return;
+  }
+
+  // FFT of the padded taps, scaled for the inverse FFT
+  for (i = 0; i < nTaps; i++)
+  {
+    block[i] = taps[i] / (T)nBlock;
+  }
+  for (i = nTaps; i < nBlock; i++)
+  {
+    block[i] = {0, 0};
+  }
+  Fftw<T>::execute(fftBlock);
+  std::copy(block.begin(), block.end(), weights.begin());
+}
+
+template <typename T>
+void OverlapSave<T>::apply(const Complex *x, Complex *out)
+{
+  uint32_t i, k;
+
+  // direct form, split real and imaginary so the inner loop vectorises
+  if (nBlock == 0)
+  {
+    std::fill(out, out + nSamples, Complex(0, 0));
+    T *o = reinterpret_cast<T *>(out);
+    const T *s = reinterpret_cast<const T *>(x);
+    for (k = 0; k < nTaps && k < nSamples; k++)
+    {
+      T wr = taps[k].real();
+      T wi = taps[k].imag();
+      T *ok = o + 2 * k;
+      for (i = 0; i < nSamples - k; i++)
+      {
+        T xr = s[2 * i];
+        T xi = s[2 * i + 1];
+        ok[2 * i] += wr * xr - wi * xi;
+        ok[2 * i + 1] += wr * xi + wi * xr;
+      }
+    }
+    return;
+  }
+
+  // each block holds nTaps - 1 previous samples and nStep new samples
+  uint32_t nPre = nTaps - 1;
+  for (uint32_t start = 0; start < nSamples; start += nStep)
+  {
+    uint32_t length = std::min(nStep, nSamples - start);
+    for (i = 0; i < nBlock; i++)
+    {
+      int64_t index = (int64_t)start - nPre + i;
+      block[i] = (index >= 0 && index < (int64_t)nSamples) ? x[index] : Complex(0, 0);
+    }
+    Fftw<T>::execute(fftBlock);
+    for (i = 0; i < nBlock; i++)
+    {
+      block[i] *= weights[i];
+    }
+    Fftw<T>::execute(ifftBlock);
+    std::copy(block.begin() + nPre, block.begin() + nPre + length, out + start);
+  }
+}
+
+template <typename T>
+uint32_t OverlapSave<T>::get_n_block() const
+{
+  return nBlock;
+}
+
+// allowed types
+template class OverlapSave<double>;
+template class OverlapSave<float>;
@@ -0,0 +1,94 @@
+/// @file OverlapSave.h
+/// @class OverlapSave
+/// @brief A class to convolve a long signal with a short FIR filter.
+/// @details Implements <a href="https://en.wikipedia.org/wiki/Overlap%E2%80%93save_method">overlap-save</a> convolution with a fast FFT block length, sized once in the constructor.
+/// Short filters are applied directly in the time domain, as the FFTs cost more than the taps.
+/// The convolution is linear, so samples before the start of the signal are zero.
+/// @author 30hours
+
+#ifndef OVERLAPSAVE_H
+#define OVERLAPSAVE_H
+
+#include "data/meta/AlignedAllocator.h"
+#include "process/meta/Fftw.h"
+#include "process/meta/Autotune.h"
+#include <stdint.h>
+#include <vector>
+#include <armadillo>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class OverlapSave
+{
+public:
+
+  using Complex = std::complex<T>;
+
+  /// @brief Maximum number of taps to apply directly.
+  static const uint32_t N_DIRECT_MAX = 16;
+
+private:
+
+  using AlignedVector = std::vector<Complex, AlignedAllocator<Complex>>;
+
+  /// @brief Number of filter taps.
+  uint32_t nTaps;
+
+  /// @brief Number of samples of the signal.
+  uint32_t nSamples;
+
+  /// @brief FFT block length, 0 if applied directly.
+  uint32_t nBlock;
+
+  /// @brief Number of output samples per block (nBlock - nTaps + 1).
+  uint32_t nStep;
+
+  /// @brief Filter taps.
+  AlignedVector taps;
+
+  /// @brief Scaled FFT of the padded filter taps.
+  AlignedVector weights;
+
+  /// @brief Block storage.
+  AlignedVector block;
+
+  /// @brief FFTW plans for block processing.
+  /// @{
+  typename Fftw<T>::Plan fftBlock, ifftBlock;
+  /// @}
+
+  /// @brief Select the block length with the least FFT work over the signal.
+  /// @param nTaps Number of filter taps.
+  /// @param nSamples Number of samples of the signal.
+  /// @return Block length.
+  static uint32_t block_length(uint32_t nTaps, uint32_t nSamples);
+
+public:
+  /// @brief Constructor.
+  /// @param nTaps Number of filter taps.
+  /// @param nSamples Number of samples of the signal.
+  /// @param autotune Autotuner to select the block length, modelled on FFT work if not set.
+  /// @return The object.
+  OverlapSave(uint32_t nTaps, uint32_t nSamples, Autotune<T> *autotune = nullptr);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~OverlapSave();
+
+  /// @brief Set the filter taps.
+  /// @param w Filter taps, nTaps long.
+  /// @return Void.
+  void set_weights(const arma::Col<Complex> &w);
+
+  /// @brief Convolve a signal with the filter taps.
+  /// @param x Signal, nSamples long.
+  /// @param out Filtered signal, nSamples long, out[i] = sum_k w[k] x[i - k].
+  /// @return Void.
+  void apply(const Complex *x, Complex *out);
+
+  /// @brief Get the FFT block length.
+  /// @return Block length, 0 if applied directly.
+  uint32_t get_n_block() const;
+};
+
+#endif
@@ -2,60 +2,61 @@
 #include <complex>
 #include <iostream>
 #include <vector>
+#include <math.h>
+#include <limits>
+#include <algorithm>
 
 // constructor
-WienerHopf::WienerHopf(int32_t _delayMin, int32_t _delayMax, uint32_t _nSamples)
+template <typename T>
+WienerHopf<T>::WienerHopf(int32_t _delayMin, int32_t _delayMax, uint32_t _nSamples,
+  Autotune<T> *_autotune, double _threshold, double _forget)
 {
   // input
   delayMin = _delayMin;
   delayMax = _delayMax;
   nBins = delayMax - delayMin;
   nSamples = _nSamples;
+  threshold = _threshold;
+  forget = _forget;
+  cancellation = 0;
+  hasWeights = false;
+  isSolved = false;
 
   // initialise data
-  A = arma::cx_mat(nBins, nBins);
-  a = arma::cx_vec(nBins);
-  b = arma::cx_vec(nBins);
-  w = arma::cx_vec(nBins);
+  A = arma::Mat<Complex>(nBins, nBins);
+  a = arma::Col<Complex>(nBins);
+  b = arma::Col<Complex>(nBins);
+  w = arma::Col<Complex>(nBins);
+  aPrev = arma::Col<Complex>(nBins);
+  bPrev = arma::Col<Complex>(nBins);
+  levinson = std::make_unique<Levinson<T>>(nBins);
+  convolution = std::make_unique<OverlapSave<T>>(nBins, nSamples, _autotune);
 
   // compute FFTW plans in constructor
-  dataX = new std::complex<double>[nSamples];
-  dataY = new std::complex<double>[nSamples];
-  dataOutX = new std::complex<double>[nSamples];
-  dataOutY = new std::complex<double>[nSamples];
-  dataA = new std::complex<double>[nSamples];
-  dataB = new std::complex<double>[nSamples];
-  filtX = new std::complex<double>[nBins + nSamples + 1];
-  filtW = new std::complex<double>[nBins + nSamples + 1];
-  filt = new std::complex<double>[nBins + nSamples + 1];
-  fftX = fftw_plan_dft_1d(nSamples, reinterpret_cast<fftw_complex *>(dataX),
-                          reinterpret_cast<fftw_complex *>(dataOutX), FFTW_FORWARD, FFTW_ESTIMATE);
-  fftY = fftw_plan_dft_1d(nSamples, reinterpret_cast<fftw_complex *>(dataY),
-                          reinterpret_cast<fftw_complex *>(dataOutY), FFTW_FORWARD, FFTW_ESTIMATE);
-  fftA = fftw_plan_dft_1d(nSamples, reinterpret_cast<fftw_complex *>(dataA),
-                          reinterpret_cast<fftw_complex *>(dataA), FFTW_BACKWARD, FFTW_ESTIMATE);
-  fftB = fftw_plan_dft_1d(nSamples, reinterpret_cast<fftw_complex *>(dataB),
-                          reinterpret_cast<fftw_complex *>(dataB), FFTW_BACKWARD, FFTW_ESTIMATE);
-  fftFiltX = fftw_plan_dft_1d(nBins + nSamples + 1, reinterpret_cast<fftw_complex *>(filtX),
-                              reinterpret_cast<fftw_complex *>(filtX), FFTW_FORWARD, FFTW_ESTIMATE);
-  fftFiltW = fftw_plan_dft_1d(nBins + nSamples + 1, reinterpret_cast<fftw_complex *>(filtW),
-                              reinterpret_cast<fftw_complex *>(filtW), FFTW_FORWARD, FFTW_ESTIMATE);
-  fftFilt = fftw_plan_dft_1d(nBins + nSamples + 1, reinterpret_cast<fftw_complex *>(filt),
-                             reinterpret_cast<fftw_complex *>(filt), FFTW_BACKWARD, FFTW_ESTIMATE);
+  dataX = new Complex[nSamples];
+  dataY = new Complex[nSamples];
+  dataOutX = new Complex[nSamples];
+  dataOutY = new Complex[nSamples];
+  dataA = new Complex[nSamples];
+  dataB = new Complex[nSamples];
+  filt = new Complex[nSamples];
+  fftX = Fftw<T>::plan_dft_1d(nSamples, dataX, dataOutX, FFTW_FORWARD, FFTW_ESTIMATE);
+  fftY = Fftw<T>::plan_dft_1d(nSamples, dataY, dataOutY, FFTW_FORWARD, FFTW_ESTIMATE);
+  fftA = Fftw<T>::plan_dft_1d(nSamples, dataA, dataA, FFTW_BACKWARD, FFTW_ESTIMATE);
+  fftB = Fftw<T>::plan_dft_1d(nSamples, dataB, dataB, FFTW_BACKWARD, FFTW_ESTIMATE);
 }
 
-WienerHopf::~WienerHopf()
+template <typename T>
+WienerHopf<T>::~WienerHopf()
 {
-  fftw_destroy_plan(fftX);
-  fftw_destroy_plan(fftY);
-  fftw_destroy_plan(fftA);
-  fftw_destroy_plan(fftB);
-  fftw_destroy_plan(fftFiltX);
-  fftw_destroy_plan(fftFiltW);
-  fftw_destroy_plan(fftFilt);
+  Fftw<T>::destroy_plan(fftX);
+  Fftw<T>::destroy_plan(fftY);
+  Fftw<T>::destroy_plan(fftA);
+  Fftw<T>::destroy_plan(fftB);
 }
 
-bool WienerHopf::process(IqData *x, IqData *y)
+template <typename T>
+bool WienerHopf<T>::process(IqData *x, IqData *y, const ReferenceSpectrum<T> *reference)
 {
   uint32_t i, j;
   xData = x->get_data();
@@ -64,100 +65,161 @@ bool WienerHopf::process(IqData *x, IqData *y)
   // change deque to std::complex
   for (i = 0; i < nSamples; i++)
   {
-    dataX[i] = xData[(((i - delayMin) % nSamples) + nSamples) % nSamples];
-    dataY[i] = yData[i];
+    dataX[i] = Complex(xData[(((i - delayMin) % nSamples) + nSamples) % nSamples]);
+    dataY[i] = Complex(yData[i]);
   }
 
-  // pre-compute FFT of signals
-  fftw_execute(fftX);
-  fftw_execute(fftY);
-
-  // auto-correlation matrix A
-  for (i = 0; i < nSamples; i++)
+  // reuse the previous weights unless cancellation degrades past the threshold
+  isSolved = false;
+  if (threshold > 0 && hasWeights && filter(false) >= cancellation - threshold)
   {
-    dataA[i] = (dataOutX[i] * std::conj(dataOutX[i]));
+    update(y);
+    return true;
   }
-  fftw_execute(fftA);
-  for (i = 0; i < nBins; i++)
-  {
-    a[i] = std::conj(dataA[i]) / (double)nSamples;
-  }
-  A = arma::toeplitz(a);
 
-  // conjugate upper diagonal as arma does not
-  for (i = 0; i < nBins; i++)
+  // pre-compute FFT of signals, shifting the cached reference spectrum if available
+  if (reference != nullptr && reference->get_n() == nSamples)
   {
-    for (j = 0; j < nBins; j++)
+    if (shiftX.empty())
     {
-      if (i > j)
+      shiftX.resize(nSamples);
+      for (i = 0; i < nSamples; i++)
       {
-        A(i, j) = std::conj(A(i, j));
+        double phase = -2.0 * M_PI * (((int64_t)i * delayMin) % (int64_t)nSamples) / nSamples;
+        shiftX[i] = Complex(std::polar(1.0, phase));
       }
     }
+    const Complex *spectrumX = reference->get_spectrum();
+    for (i = 0; i < nSamples; i++)
+    {
+      dataOutX[i] = spectrumX[i] * shiftX[i];
+    }
+  }
+  else
+  {
+    Fftw<T>::execute(fftX);
   }
+  Fftw<T>::execute(fftY);
 
-  // cross-correlation vector b
+  // auto-correlation vector a
   for (i = 0; i < nSamples; i++)
   {
-    dataB[i] = (dataOutY[i] * std::conj(dataOutX[i]));
+    dataA[i] = (dataOutX[i] * std::conj(dataOutX[i]));
   }
-  fftw_execute(fftB);
+  Fftw<T>::execute(fftA);
   for (i = 0; i < nBins; i++)
   {
-    b[i] = dataB[i] / (double)nSamples;
+    a[i] = std::conj(dataA[i]) / (T)nSamples;
   }
 
-  // compute weights
-  success = arma::chol(A, A);
-  if (!success)
+  // cross-correlation vector b
+  for (i = 0; i < nSamples; i++)
   {
-    std::cerr << "Chol decomposition failed, skip clutter filter" << std::endl;
-    return false;
+    dataB[i] = (dataOutY[i] * std::conj(dataOutX[i]));
   }
-  success = arma::solve(w, arma::trimatu(A), arma::solve(arma::trimatl(arma::trans(A)), b));
-  if (!success)
+  Fftw<T>::execute(fftB);
+  for (i = 0; i < nBins; i++)
   {
-    std::cerr << "Solve failed, skip clutter filter" << std::endl;
-    return false;
+    b[i] = dataB[i] / (T)nSamples;
   }
 
-  // assign and pad x
-  for (i = 0; i < nSamples; i++)
-  {
-    filtX[i] = dataX[i];
-  }
-  for (i = nSamples; i < nBins + nSamples + 1; i++)
+  // exponentially weighted correlations over CPIs
+  if (forget > 0 && hasWeights)
   {
-    filtX[i] = {0, 0};
+    for (i = 0; i < nBins; i++)
+    {
+      a[i] = (T)forget * aPrev[i] + (T)(1 - forget) * a[i];
+      b[i] = (T)forget * bPrev[i] + (T)(1 - forget) * b[i];
+    }
   }
+  aPrev = a;
+  bPrev = b;
 
-  // assign and pad w
-  for (i = 0; i < nBins; i++)
+  // compute weights by Levinson recursion, Cholesky if numerically unstable
+  if (!levinson->solve(a, b, w))
   {
-    filtW[i] = w[i];
+    A = arma::toeplitz(a);
+
+    // conjugate upper diagonal as arma does not
+    for (i = 0; i < nBins; i++)
+    {
+      for (j = 0; j < nBins; j++)
+      {
+        if (i > j)
+        {
+          A(i, j) = std::conj(A(i, j));
+        }
+      }
+    }
+
+    // compute weights by Cholesky decomposition
+    success = arma::chol(A, A);
+    if (!success)
+    {
+      std::cerr << "Chol decomposition failed, skip clutter filter" << std::endl;
+      return false;
+    }
+    success = arma::solve(w, arma::trimatu(A), arma::solve(arma::trimatl(arma::trans(A)), b));
+    if (!success)
+    {
+      std::cerr << "Solve failed, skip clutter filter" << std::endl;
+      return false;
+    }
   }
-  for (i = nBins; i < nBins + nSamples + 1; i++)
+
+  // filter with the new weights
+  cancellation = filter(true);
+  hasWeights = true;
+  isSolved = true;
+  update(y);
+
+  return true;
+}
+
+template <typename T>
+double WienerHopf<T>::filter(bool isNewWeights)
+{
+  // keep the previous weights unless changed
+  if (isNewWeights)
   {
-    filtW[i] = {0, 0};
+    convolution->set_weights(w);
   }
+  convolution->apply(dataX, filt);
 
-  // compute fft
-  fftw_execute(fftFiltX);
-  fftw_execute(fftFiltW);
-
-  // compute convolution/filter
-  for (i = 0; i < nBins + nSamples + 1; i++)
+  // residual surveillance signal and clutter cancellation
+  double powerIn = 0, powerOut = 0;
+  for (uint32_t i = 0; i < nSamples; i++)
   {
-    filt[i] = (filtW[i] * filtX[i]);
+    filt[i] = dataY[i] - filt[i];
+    powerIn += std::norm(dataY[i]);
+    powerOut += std::norm(filt[i]);
   }
-  fftw_execute(fftFilt);
 
-  // update surveillance signal
+  return 10 * std::log10(powerIn / std::max(powerOut, std::numeric_limits<double>::min()));
+}
+
+template <typename T>
+void WienerHopf<T>::update(IqData *y)
+{
   y->clear();
-  for (i = 0; i < nSamples; i++)
+  for (uint32_t i = 0; i < nSamples; i++)
   {
-    y->push_back(dataY[i] - (filt[i] / (double)(nBins + nSamples + 1)));
+    y->push_back(std::complex<double>(filt[i]));
   }
+}
 
-  return true;
-}
\ No newline at end of file
+template <typename T>
+bool WienerHopf<T>::is_solved() const
+{
+  return isSolved;
+}
+
+template <typename T>
+double WienerHopf<T>::get_cancellation() const
+{
+  return cancellation;
+}
+
+// allowed types
+template class WienerHopf<double>;
+template class WienerHopf<float>;
@@ -2,20 +2,34 @@
 /// @class WienerHopf
 /// @brief A class to implement a Wiener-Hopf clutter filter.
 /// @details Implements a <a href="https://en.wikipedia.org/wiki/Wiener_filter#Finite_impulse_response_Wiener_filter_for_discrete_series">Wiener-Hopf filter</a>.
-/// Uses <a href="https://en.wikipedia.org/wiki/Cholesky_decomposition">Cholesky decomposition</a> to speed up matrix inversion, as the Toeplitz matrix is positive-definite and Hermitian.
+/// Solves for the weights by Levinson recursion in O(n^2), as the autocorrelation matrix is Hermitian Toeplitz.
+/// Falls back to <a href="https://en.wikipedia.org/wiki/Cholesky_decomposition">Cholesky decomposition</a> if the recursion is numerically unstable.
 /// @author 30hours
 /// @todo Fix the segmentation fault from clutter filter numerical instability.
 
 #ifndef WIENERHOPF_H
 #define WIENERHOPF_H
 
+#include "ClutterFilter.h"
 #include "data/IqData.h"
+#include "process/meta/Fftw.h"
+#include "process/spectrum/ReferenceSpectrum.h"
+#include "process/meta/Autotune.h"
+#include "Levinson.h"
+#include "OverlapSave.h"
 #include <stdint.h>
-#include <fftw3.h>
+#include <vector>
+#include <memory>
 #include <armadillo>
 
-class WienerHopf
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class WienerHopf : public ClutterFilter<T>
 {
+public:
+
+  using Complex = std::complex<T>;
+
 private:
   /// @brief Minimum clutter filter delay (bins).
   int32_t delayMin;
@@ -32,40 +46,73 @@ private:
   /// @brief True if clutter filter processing is successful.
   bool success;
 
+  /// @brief Cancellation degradation to re-solve the weights (dB), 0 to solve every CPI.
+  double threshold;
+
+  /// @brief Weight of the previous correlations when re-solving (0 to 1), 0 for this CPI only.
+  double forget;
+
+  /// @brief Clutter cancellation when the weights were last solved (dB).
+  double cancellation;
+
+  /// @brief True if weights have been solved.
+  bool hasWeights;
+
+  /// @brief True if the weights were solved on the last call.
+  bool isSolved;
+
   /// @brief FFTW plans for clutter filter processing.
   /// @{
-  fftw_plan fftX, fftY, fftA, fftB, fftFiltX, fftFiltW, fftFilt;
+  typename Fftw<T>::Plan fftX, fftY, fftA, fftB;
   /// @}
 
   /// @brief FFTW storage for clutter filter processing.
   /// @{
-  std::complex<double> *dataX, *dataY, *dataOutX, *dataOutY, *dataA, *dataB, *filtX, *filtW, *filt;
+  Complex *dataX, *dataY, *dataOutX, *dataOutY, *dataA, *dataB, *filt;
   /// @}
 
+  /// @brief Phase ramp to shift the cached reference spectrum by delayMin.
+  /// @details Computed on first use of a cached reference spectrum.
+  std::vector<Complex> shiftX;
+
   /// @brief Deque storage for clutter filter processing.
   /// @{
   std::deque<std::complex<double>> xData, yData;
   /// @}
 
   /// @brief Autocorrelation toeplitz matrix.
-  arma::cx_mat A;
+  arma::Mat<Complex> A;
 
   /// @brief Autocorrelation vector.
-  arma::cx_vec a;
+  arma::Col<Complex> a;
 
   /// @brief Cross-correlation vector.
-  arma::cx_vec b;
+  arma::Col<Complex> b;
 
   /// @brief Weights vector.
-  arma::cx_vec w;
+  arma::Col<Complex> w;
+
+  /// @brief Correlation vectors of the last solve.
+  /// @{
+  arma::Col<Complex> aPrev, bPrev;
+  /// @}
+
+  /// @brief Toeplitz solver for the weights.
+  std::unique_ptr<Levinson<T>> levinson;
+
+  /// @brief Convolution of the reference with the weights.
+  std::unique_ptr<OverlapSave<T>> convolution;
 
 public:
   /// @brief Constructor.
   /// @param delayMin Minimum clutter filter delay (bins).
   /// @param delayMax Maximum clutter filter delay (bins).
   /// @param nSamples Number of samples per CPI.
+  /// @param autotune Autotuner to select the filter convolution block length, modelled if not set.
+  /// @param threshold Cancellation degradation to re-solve the weights (dB), 0 to solve every CPI.
+  /// @param forget Weight of the previous correlations when re-solving (0 to 1), 0 for this CPI only.
   /// @return The object.
-  WienerHopf(int32_t delayMin, int32_t delayMax, uint32_t nSamples);
+  WienerHopf(int32_t delayMin, int32_t delayMax, uint32_t nSamples, Autotune<T> *autotune = nullptr, double threshold = 0, double forget = 0);
 
   /// @brief Destructor.
   /// @return Void.
@@ -74,8 +121,28 @@ public:
   /// @brief Implement the clutter filter.
   /// @param x Reference samples.
   /// @param y Surveillance samples.
+  /// @param reference Cached reference spectrum of this CPI, used if the FFT length matches.
   /// @return True if clutter filter successful.
-  bool process(IqData *x, IqData *y);
+  bool process(IqData *x, IqData *y, const ReferenceSpectrum<T> *reference = nullptr) override;
+
+  /// @brief Check if the weights were solved on the last call, or reused.
+  /// @return True if solved.
+  bool is_solved() const;
+
+  /// @brief Get the clutter cancellation when the weights were last solved.
+  /// @return Ratio of input to output surveillance power (dB).
+  double get_cancellation() const;
+
+private:
+  /// @brief Filter the surveillance signal with the current weights into filt.
+  /// @param isNewWeights True if the weights changed since the last call.
+  /// @return Clutter cancellation (dB).
+  double filter(bool isNewWeights);
+
+  /// @brief Write the filtered surveillance signal.
+  /// @param y Surveillance samples.
+  /// @return Void.
+  void update(IqData *y);
 };
 
 #endif
\ No newline at end of file
@@ -1,73 +1,189 @@
 #include "Centroid.h"
+#include "process/meta/GridKey.h"
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <numeric>
+#include <unordered_map>
 
 // constructor
-Centroid::Centroid(uint16_t _nDelay, uint16_t _nDoppler, double _resolutionDoppler)
+Centroid::Centroid(uint16_t _nDelay, uint16_t _nDoppler, double _resolutionDoppler, 
+  Mode _mode)
 {
   // input
   nDelay = _nDelay;
   nDoppler = _nDoppler;
   resolutionDoppler = _resolutionDoppler;
+  mode = _mode;
 }
 
 Centroid::~Centroid()
 {
 }
 
-std::unique_ptr<Detection> Centroid::process(Detection *x)
+void Centroid::process(Detection *x, Detection *detection)
 { 
-  // store detections temporarily
-  std::vector<double> delay, doppler, snr;
-  delay = x->get_delay();
-  doppler = x->get_doppler();
-  snr = x->get_snr();
-
-  // centroid data
-  uint16_t delayMin, delayMax;
-  double dopplerMin, dopplerMax;
-  bool isCentroid;
-  std::vector<double> delay2, doppler2, snr2;
+  // read detections in place
+  const std::vector<double> &delay = x->get_delay();
+  const std::vector<double> &doppler = x->get_doppler();
+  const std::vector<double> &snr = x->get_snr();
+
+  std::vector<bool> isCentroid = (mode == Mode::Window) ? 
+    process_window(delay, doppler, snr) : 
+    process_component(delay, doppler, snr);
+
+  // store centroided detections, with map indices if known
+  bool hasBin = x->has_bin();
+  detection->clear();
+  for (size_t i = 0; i < snr.size(); i++)
+  {
+    if (!isCentroid[i])
+    {
+      continue;
+    }
+    if (hasBin)
+    {
+      detection->push_back(delay[i], doppler[i], snr[i], 
+        x->get_delay_bin()[i], x->get_doppler_bin()[i]);
+    }
+    else
+    {
+      detection->push_back(delay[i], doppler[i], snr[i]);
+    }
+  }
+}
+
+std::vector<bool> Centroid::process_window(const std::vector<double> &delay, 
+  const std::vector<double> &doppler, const std::vector<double> &snr)
+{
+  std::vector<bool> isCentroid(snr.size(), true);
+  double widthDoppler = nDoppler * resolutionDoppler;
+
+  // an empty window has no neighbours
+  if (nDelay == 0 || !(widthDoppler > 0))
+  {
+    return isCentroid;
+  }
+
+  // bucket detections into a grid of the window size
+  std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+  grid.reserve(snr.size());
+  for (size_t j = 0; j < snr.size(); j++)
+  {
+    grid[grid_key((int64_t)std::floor(delay[j] / nDelay), 
+      (int64_t)std::floor(doppler[j] / widthDoppler))].push_back(j);
+  }
 
   // loop over every detection
   for (size_t i = 0; i < snr.size(); i++)
   {
-    delayMin = (int)(delay[i]) - nDelay;
-    delayMax = (int)(delay[i]) + nDelay;
-    dopplerMin = doppler[i] - (nDoppler * resolutionDoppler);
-    dopplerMax = doppler[i] + (nDoppler * resolutionDoppler);
-    isCentroid = true;
+    int32_t delayMin = (int)(delay[i]) - nDelay;
+    int32_t delayMax = (int)(delay[i]) + nDelay;
+    double dopplerMin = doppler[i] - (nDoppler * resolutionDoppler);
+    double dopplerMax = doppler[i] + (nDoppler * resolutionDoppler);
+
+    // division is monotonic, so the buckets of the window bounds cover it
+    int64_t delayBucket0 = (int64_t)std::floor((double)delayMin / nDelay);
+    int64_t delayBucket1 = (int64_t)std::floor((double)delayMax / nDelay);
+    int64_t dopplerBucket0 = (int64_t)std::floor(dopplerMin / widthDoppler);
+    int64_t dopplerBucket1 = (int64_t)std::floor(dopplerMax / widthDoppler);
     
     // find detections to keep
-    for (size_t j = 0; j < snr.size(); j++)
+    for (int64_t p = delayBucket0; p <= delayBucket1 && isCentroid[i]; p++)
     {
-      // skip same detection
-      if (j == i)
+      for (int64_t q = dopplerBucket0; q <= dopplerBucket1 && isCentroid[i]; q++)
       {
-        continue;
-      }
-      // search detections close by
-      if (delay[j] > delayMin && delay[j] < delayMax &&
-        doppler[j] > dopplerMin && doppler[j] < dopplerMax)
+        auto bucket = grid.find(grid_key(p, q));
+        if (bucket == grid.end())
+        {
+          continue;
+        }
+        for (uint32_t j : bucket->second)
         {
-          // remove if SNR is lower
-          if (snr[i] < snr[j])
+          // search detections close by, remove if SNR is lower
+          if (j != i && delay[j] > delayMin && delay[j] < delayMax &&
+            doppler[j] > dopplerMin && doppler[j] < dopplerMax && snr[i] < snr[j])
           {
-            isCentroid = false;
+            isCentroid[i] = false;
             break;
           }
         }
+      }
     }
-    // store centroided detections
-    if (isCentroid)
+  }
+
+  return isCentroid;
+}
+
+std::vector<bool> Centroid::process_component(const std::vector<double> &delay, 
+  const std::vector<double> &doppler, const std::vector<double> &snr)
+{
+  size_t n = snr.size();
+  std::vector<bool> isCentroid(n, false);
+
+  // without a Doppler resolution there are no cells to connect
+  if (!(resolutionDoppler > 0))
+  {
+    isCentroid.assign(n, true);
+    return isCentroid;
+  }
+
+  // index detections by cell
+  std::vector<int64_t> cellDelay(n), cellDoppler(n);
+  std::unordered_map<uint64_t, uint32_t> cell;
+  cell.reserve(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    cellDelay[i] = (int64_t)std::lround(delay[i]);
+    cellDoppler[i] = (int64_t)std::lround(doppler[i] / resolutionDoppler);
+    cell.emplace(grid_key(cellDelay[i], cellDoppler[i]), i);
+  }
+
+  // union-find of adjacent cells
+  std::vector<uint32_t> parent(n);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](uint32_t i) {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  for (size_t i = 0; i < n; i++)
+  {
+    for (int64_t p = -1; p <= 1; p++)
+    {
+      for (int64_t q = -1; q <= 1; q++)
+      {
+        auto neighbour = cell.find(grid_key(cellDelay[i] + p, cellDoppler[i] + q));
+        if (neighbour != cell.end())
+        {
+          uint32_t a = find(i);
+          uint32_t b = find(neighbour->second);
+          parent[std::max(a, b)] = std::min(a, b);
+        }
+      }
+    }
+  }
+
+  // keep the first detection with the highest SNR of each component
+  std::vector<uint32_t> peak(n, n);
+  for (size_t i = 0; i < n; i++)
+  {
+    uint32_t root = find(i);
+    if (peak[root] == n || snr[i] > snr[peak[root]])
+    {
+      peak[root] = i;
+    }
+  }
+  for (size_t i = 0; i < n; i++)
+  {
+    if (peak[i] < n)
     {
-      delay2.push_back(delay[i]);
-      doppler2.push_back(doppler[i]);
-      snr2.push_back(snr[i]);  
+      isCentroid[peak[i]] = true;
     }
   }
 
-  // create detection
-  return std::make_unique<Detection>(delay2, doppler2, snr2);
+  return isCentroid;
 }
@@ -2,6 +2,7 @@
 /// @class Centroid
 /// @brief A class to remove duplicate target detections.
 /// @details If detection SNR is larger than neighbours, then remove.
+/// Detections are bucketed into a delay/Doppler grid the size of the centroid window, so only neighbouring buckets are checked.
 /// @author 30hours
 
 #ifndef CENTROID_H
@@ -13,6 +14,15 @@
 
 class Centroid
 {
+public:
+
+  /// @brief Method to group detections of the same target.
+  enum class Mode
+  {
+    Window,    ///< Keep detections with the highest SNR within the centroid window.
+    Component  ///< Keep the highest SNR detection of each group of adjacent cells.
+  };
+
 private:
   /// @brief Number of delay bins to check.
   uint16_t nDelay;
@@ -23,16 +33,35 @@ private:
   /// @brief Doppler resolution to convert Hz to bins (Hz).
   double resolutionDoppler;
 
-  /// @brief Pointer to detection data to store result.
-  Detection *detection;
+  /// @brief Method to group detections of the same target.
+  Mode mode;
+
+  /// @brief Keep detections with the highest SNR within the centroid window.
+  /// @param delay Detections in delay (bins).
+  /// @param doppler Detections in Doppler (Hz).
+  /// @param snr Detections in SNR.
+  /// @return True for each detection to keep.
+  std::vector<bool> process_window(const std::vector<double> &delay, 
+    const std::vector<double> &doppler, const std::vector<double> &snr);
+
+  /// @brief Keep the highest SNR detection of each connected component of detected cells.
+  /// @details Cells are connected if adjacent in delay and Doppler bins, including diagonals.
+  /// @param delay Detections in delay (bins).
+  /// @param doppler Detections in Doppler (Hz).
+  /// @param snr Detections in SNR.
+  /// @return True for each detection to keep.
+  std::vector<bool> process_component(const std::vector<double> &delay, 
+    const std::vector<double> &doppler, const std::vector<double> &snr);
 
 public:
   /// @brief Constructor.
   /// @param nDelay Number of delay bins to check.
   /// @param nDoppler Number of Doppler bins to check.
   /// @param resolutionDoppler Doppler resolution to convert Hz to bins (Hz).
+  /// @param mode Method to group detections of the same target.
   /// @return The object.
-  Centroid(uint16_t nDelay, uint16_t nDoppler, double resolutionDoppler);
+  Centroid(uint16_t nDelay, uint16_t nDoppler, double resolutionDoppler, 
+    Mode mode = Mode::Window);
 
   /// @brief Destructor.
   /// @return Void.
@@ -40,8 +69,9 @@ public:
 
   /// @brief Implement the 1D CFAR detector.
   /// @param x Detections from the 1D CFAR detector.
-  /// @return Centroided detections.
-  std::unique_ptr<Detection> process(Detection *x);
+  /// @param detection Centroided detections to overwrite, storage is reused. Must not be x.
+  /// @return Void.
+  void process(Detection *x, Detection *detection);
 };
 
 #endif
@@ -0,0 +1,34 @@
+/// @file CfarDetector.h
+/// @class CfarDetector
+/// @brief An abstract class for CFAR detectors.
+/// @details CFAR detectors convert an ambiguity map to detections, comparing each cell against a threshold scaled from its training cells.
+/// @author 30hours
+
+#ifndef CFARDETECTOR_H
+#define CFARDETECTOR_H
+
+#include "data/Map.h"
+#include "data/Detection.h"
+#include <complex>
+
+class CfarDetector
+{
+public:
+  /// @brief Destructor.
+  /// @return Void.
+  virtual ~CfarDetector() = default;
+
+  /// @brief Implement the CFAR detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  virtual void process(Map<std::complex<double>> *x, Detection *detection) = 0;
+
+  /// @brief Implement the CFAR detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  virtual void process(Map<std::complex<float>> *x, Detection *detection) = 0;
+};
+
+#endif
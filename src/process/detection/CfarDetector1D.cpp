@@ -4,9 +4,12 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <limits>
+#include <algorithm>
 
 // constructor
-CfarDetector1D::CfarDetector1D(double _pfa, int8_t _nGuard, int8_t _nTrain, int8_t _minDelay, double _minDoppler)
+CfarDetector1D::CfarDetector1D(double _pfa, int8_t _nGuard, int8_t _nTrain, 
+  int8_t _minDelay, double _minDoppler, uint32_t _nThreads)
 {
   // input
   pfa = _pfa;
@@ -14,87 +17,145 @@ CfarDetector1D::CfarDetector1D(double _pfa, int8_t _nGuard, int8_t _nTrain, int8
   nTrain = _nTrain;
   minDelay = _minDelay;
   minDoppler = _minDoppler;
+
+  // threshold factor only varies with training cells at the edges
+  alpha.resize(2 * std::max<int>(nTrain, 0) + 1, 0);
+  for (size_t nCells = 1; nCells < alpha.size(); nCells++)
+  {
+    alpha[nCells] = nCells * (pow(pfa, -1.0 / nCells) - 1);
+  }
+
+  pool = std::make_unique<ThreadPool>(std::max<uint32_t>(1, _nThreads));
+  prefix.resize(pool->get_n_threads());
 }
 
 CfarDetector1D::~CfarDetector1D()
 {
 }
 
-std::unique_ptr<Detection> CfarDetector1D::process(Map<std::complex<double>> *x)
-{ 
-  int32_t nDelayBins = x->get_nCols();
-  int32_t nDopplerBins = x->get_nRows();
+void CfarDetector1D::process(Map<std::complex<double>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
 
-  std::vector<std::complex<double>> mapRow;
-  std::vector<double> mapRowSquare, mapRowSnr;
+void CfarDetector1D::process(Map<std::complex<float>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
 
-  // store detections temporarily
-  std::vector<double> delay;
-  std::vector<double> doppler;
-  std::vector<double> snr;
+template <typename T>
+void CfarDetector1D::threshold_row(const T *power, const std::deque<int> &delay, 
+  int32_t nDelayBins, std::vector<double> &prefix, std::vector<int32_t> &cols) const
+{
+  prefix.resize(nDelayBins + 1);
+  prefix[0] = 0;
+  for (int j = 0; j < nDelayBins; j++)
+  {
+    prefix[j + 1] = prefix[j] + power[j];
+  }
 
-  // loop over every cell
-  for (int i = 0; i < nDopplerBins; i++)
-  { 
-    // skip if less than min Doppler
-    if (std::abs(x->doppler[i]) < minDoppler)
+  // bound on rounding of prefix differences, all terms are positive
+  double bound = 4.0 * (nDelayBins + nTrain + 2) * 
+    std::numeric_limits<double>::epsilon() * prefix[nDelayBins];
+  bool isExact = !std::isfinite(bound);
+
+  for (int j = 0; j < nDelayBins; j++)
+  {
+    // skip if less than min delay
+    if (delay[j] < minDelay)
     {
       continue;
     } 
-    mapRow = x->get_row(i);
-    for (int j = 0; j < nDelayBins; j++)
+
+    // train cells either side of the guard cells, cell 0 is never trained on
+    int left0 = std::max(j - nGuard - nTrain, 1);
+    int left1 = std::min(j - nGuard, nDelayBins);
+    int right0 = std::max(j + nGuard + 1, 0);
+    int right1 = std::min(j + nGuard + nTrain + 1, nDelayBins);
+    int nLeft = std::max(left1 - left0, 0);
+    int nRight = std::max(right1 - right0, 0);
+    int nCells = nLeft + nRight;
+    if (nCells == 0)
     {
-      mapRowSquare.push_back((double) std::abs(mapRow[j]*mapRow[j]));
-      mapRowSnr.push_back((double)10 * std::log10(std::abs(mapRow[j])) - x->noisePower);
+      continue;
     }
-    for (int j = 0; j < nDelayBins; j++)
+
+    // compute threshold
+    double trainNoise = (nLeft > 0 ? prefix[left1] - prefix[left0] : 0) + 
+      (nRight > 0 ? prefix[right1] - prefix[right0] : 0);
+    double threshold = alpha[nCells] * (trainNoise / nCells);
+
+    // sum the cells in order if too close to call from the prefix sum
+    if (isExact || std::abs(power[j] - threshold) <= alpha[nCells] * bound / nCells + 
+      8 * std::numeric_limits<double>::epsilon() * threshold)
     {
-      // skip if less than min delay
-      if (x->delay[j] < minDelay)
-      {
-        continue;
-      } 
-      // get train cell indices
-      std::vector<int> iTrain;
-      for (int k = j-nGuard-nTrain; k < j-nGuard; k++)
-      {
-        if (k > 0 && k < nDelayBins)
-        {
-          iTrain.push_back(k);
-        }
-      }
-      for (int k = j+nGuard+1; k < j+nGuard+nTrain+1; k++)
+      trainNoise = 0.0;
+      for (int k = left0; k < left1; k++)
       {
-        if (k >= 0 && k < nDelayBins)
-        {
-          iTrain.push_back(k);
-        }
+        trainNoise += power[k];
       }
-
-      // compute threshold
-      int nCells = iTrain.size();
-      double alpha = nCells * (pow(pfa, -1.0 / nCells) - 1);
-      double trainNoise = 0.0;
-      for (int k = 0; k < nCells; k++)
+      for (int k = right0; k < right1; k++)
       {
-        trainNoise += mapRowSquare[iTrain[k]];
+        trainNoise += power[k];
       }
       trainNoise /= nCells;
-      double threshold = alpha * trainNoise;
+      threshold = alpha[nCells] * trainNoise;
+    }
 
-      // detection if over threshold
-      if (mapRowSquare[j] > threshold)
-      {
-        delay.push_back(j + x->delay[0]);
-        doppler.push_back(x->doppler[i]);
-        snr.push_back(mapRowSnr[j]);
-      }
-      iTrain.clear();
+    // detection if over threshold
+    if (power[j] > threshold)
+    {
+      cols.push_back(j);
     }
-    mapRowSquare.clear();
-    mapRowSnr.clear();
   }
+}
+
+template <typename T>
+void CfarDetector1D::detect(Map<std::complex<T>> *x, Detection *detection)
+{ 
+  int32_t nDelayBins = x->get_nCols();
+  int32_t nDopplerBins = x->get_nRows();
+  if (!x->has_planes())
+  {
+    x->set_metrics();
+  }
+
+  // store detections temporarily per row, merged in row order
+  rowBin.resize(nDopplerBins);
 
-  // create detection
-  return std::make_unique<Detection>(delay, doppler, snr);
+  pool->parallel_for(nDopplerBins, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    for (int i = start; i < (int)end; i++)
+    { 
+      rowBin[i].clear();
+
+      // skip if less than min Doppler
+      if (std::abs(x->doppler[i]) < minDoppler)
+      {
+        continue;
+      } 
+      threshold_row(x->power.data() + (size_t)i * nDelayBins, x->delay, 
+        nDelayBins, prefix[thread], rowBin[i]);
+    }
+  });
+
+  // store detections in row order
+  detection->clear();
+  for (int i = 0; i < nDopplerBins; i++)
+  {
+    const T *levelRow = x->level.data() + (size_t)i * nDelayBins;
+    for (int32_t j : rowBin[i])
+    {
+      detection->push_back(j + x->delay[0], x->doppler[i], 
+        levelRow[j] - x->noisePower, j, i);
+    }
+  }
 }
+
+// allowed types
+template void CfarDetector1D::detect<double>(Map<std::complex<double>> *x, Detection *detection);
+template void CfarDetector1D::detect<float>(Map<std::complex<float>> *x, Detection *detection);
+template void CfarDetector1D::threshold_row<double>(const double *power, const std::deque<int> &delay, 
+  int32_t nDelayBins, std::vector<double> &prefix, std::vector<int32_t> &cols) const;
+template void CfarDetector1D::threshold_row<float>(const float *power, const std::deque<int> &delay, 
+  int32_t nDelayBins, std::vector<double> &prefix, std::vector<int32_t> &cols) const;
@@ -2,19 +2,24 @@
 /// @class CfarDetector1D
 /// @brief A class to implement a 1D CFAR detector.
 /// @details Converts an AmbiguityMap to DetectionData. 1D CFAR operates across delay, to minimise detections from the zero-Doppler line.
+/// Training sums are differences of a prefix sum over each power row, so each cell costs O(1). Doppler rows are processed in parallel.
 /// @author 30hours
 /// @todo Actually implement the min delay and Doppler.
 
 #ifndef CFARDETECTOR1D_H
 #define CFARDETECTOR1D_H
 
+#include "CfarDetector.h"
 #include "data/Map.h"
 #include "data/Detection.h"
+#include "process/utility/ThreadPool.h"
 #include <stdint.h>
 #include <complex>
 #include <memory>
+#include <vector>
+#include <deque>
 
-class CfarDetector1D
+class CfarDetector1D : public CfarDetector
 {
 private:
   /// @brief Probability of false alarm, numeric in [0,1]
@@ -32,8 +37,25 @@ private:
   /// @brief Minimum absolute Doppler to process detections (Hz).
   double minDoppler;
 
-  /// @brief Pointer to detection data to store result.
-  Detection *detection;
+  /// @brief Threshold factor by number of training cells.
+  std::vector<double> alpha;
+
+  /// @brief Worker pool for processing rows.
+  std::unique_ptr<ThreadPool> pool;
+
+  /// @brief Prefix sum storage per thread.
+  std::vector<std::vector<double>> prefix;
+
+  /// @brief Detected columns per row, merged in row order.
+  std::vector<std::vector<int32_t>> rowBin;
+
+  /// @brief Implement the 1D CFAR detector.
+  /// @tparam T Map precision (float or double).
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite.
+  /// @return Void.
+  template <typename T>
+  void detect(Map<std::complex<T>> *x, Detection *detection);
 
 public:
   /// @brief Constructor.
@@ -42,8 +64,9 @@ public:
   /// @param nTrain Number of single-sided training cells.
   /// @param minDelay Minimum delay to process detections (bins).
   /// @param minDoppler Minimum absolute Doppler to process detections (Hz).
+  /// @param nThreads Number of threads to process rows.
   /// @return The object.
-  CfarDetector1D(double pfa, int8_t nGuard, int8_t nTrain, int8_t minDelay, double minDoppler);
+  CfarDetector1D(double pfa, int8_t nGuard, int8_t nTrain, int8_t minDelay, double minDoppler, uint32_t nThreads = 1);
 
   /// @brief Destructor.
   /// @return Void.
@@ -51,8 +74,28 @@ public:
 
   /// @brief Implement the 1D CFAR detector.
   /// @param x Ambiguity map data of IQ samples.
-  /// @return Detections from the 1D CFAR detector.
-  std::unique_ptr<Detection> process(Map<std::complex<double>> *x);
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<double>> *x, Detection *detection) override;
+
+  /// @brief Implement the 1D CFAR detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<float>> *x, Detection *detection) override;
+
+  /// @brief Threshold one row of the power map.
+  /// @details Shared with PeakExtractor so the fused pass detects the same cells.
+  /// @tparam T Map precision (float or double).
+  /// @param power Power of each cell in the row.
+  /// @param delay Delay units of map data (bins).
+  /// @param nDelayBins Number of cells in the row.
+  /// @param prefix Storage for the prefix sum, resized to nDelayBins + 1.
+  /// @param cols Column index of each cell over threshold, appended in order.
+  /// @return Void.
+  template <typename T>
+  void threshold_row(const T *power, const std::deque<int> &delay, 
+    int32_t nDelayBins, std::vector<double> &prefix, std::vector<int32_t> &cols) const;
 };
 
 #endif
@@ -0,0 +1,212 @@
+#include "CfarDetector2D.h"
+#include "data/Map.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+// constructor
+CfarDetector2D::CfarDetector2D(double _pfa, int32_t _nGuardDelay, 
+  int32_t _nGuardDoppler, int32_t _nTrainDelay, int32_t _nTrainDoppler, 
+  Mode _mode, Window _window, int32_t _minDelay, double _minDoppler, 
+  uint32_t _nThreads)
+{
+  // input
+  pfa = _pfa;
+  nGuardDelay = _nGuardDelay;
+  nGuardDoppler = _nGuardDoppler;
+  nTrainDelay = _nTrainDelay;
+  nTrainDoppler = _nTrainDoppler;
+  mode = _mode;
+  window = _window;
+  minDelay = _minDelay;
+  minDoppler = _minDoppler;
+  if (nGuardDelay < 0 || nGuardDoppler < 0 || nTrainDelay < 0 || nTrainDoppler < 0)
+  {
+    throw std::invalid_argument("CFAR guard and training cells must be non-negative");
+  }
+  if (nTrainDelay == 0 && nTrainDoppler == 0)
+  {
+    throw std::invalid_argument("CFAR requires training cells");
+  }
+
+  // threshold factor up to the full outer window
+  size_t nMax = (size_t)(2 * (nGuardDelay + nTrainDelay) + 1) * 
+    (2 * (nGuardDoppler + nTrainDoppler) + 1);
+  alpha.resize(nMax + 1, 0);
+  for (size_t nCells = 1; nCells <= nMax; nCells++)
+  {
+    alpha[nCells] = nCells * (pow(pfa, -1.0 / nCells) - 1);
+  }
+
+  pool = std::make_unique<ThreadPool>(std::max<uint32_t>(1, _nThreads));
+}
+
+CfarDetector2D::~CfarDetector2D()
+{
+}
+
+double CfarDetector2D::box(int32_t row0, int32_t row1, int32_t col0, 
+  int32_t col1, int32_t nRows, int32_t nCols, int32_t &nCells) const
+{
+  row0 = std::max(row0, 0);
+  row1 = std::min(row1, nRows - 1);
+  col0 = std::max(col0, 0);
+  col1 = std::min(col1, nCols - 1);
+  if (row0 > row1 || col0 > col1)
+  {
+    return 0;
+  }
+  nCells += (row1 - row0 + 1) * (col1 - col0 + 1);
+  size_t width = nCols + 1;
+  return table[(row1 + 1) * width + col1 + 1] - table[row0 * width + col1 + 1] - 
+    table[(row1 + 1) * width + col0] + table[row0 * width + col0];
+}
+
+void CfarDetector2D::process(Map<std::complex<double>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
+
+void CfarDetector2D::process(Map<std::complex<float>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
+
+template <typename T>
+void CfarDetector2D::detect(Map<std::complex<T>> *x, Detection *detection)
+{
+  int32_t nDelayBins = x->get_nCols();
+  int32_t nDopplerBins = x->get_nRows();
+  size_t width = nDelayBins + 1;
+  if (!x->has_planes())
+  {
+    x->set_metrics();
+  }
+  table.resize((nDopplerBins + 1) * width);
+
+  // summed-area table, prefix sum along each row then down each column
+  std::fill(table.begin(), table.begin() + width, 0);
+  pool->parallel_for(nDopplerBins, [&](uint32_t start, uint32_t end, uint32_t)
+  {
+    for (uint32_t i = start; i < end; i++)
+    {
+      const T *powerRow = x->power.data() + (size_t)i * nDelayBins;
+      double *tableRow = &table[(i + 1) * width];
+      tableRow[0] = 0;
+      for (int32_t j = 0; j < nDelayBins; j++)
+      {
+        tableRow[j + 1] = tableRow[j] + powerRow[j];
+      }
+    }
+  });
+  pool->parallel_for(width, [&](uint32_t start, uint32_t end, uint32_t)
+  {
+    for (int32_t i = 1; i <= nDopplerBins; i++)
+    {
+      double *tableRow = &table[i * width];
+      const double *tablePrev = &table[(i - 1) * width];
+      for (uint32_t j = start; j < end; j++)
+      {
+        tableRow[j] += tablePrev[j];
+      }
+    }
+  });
+
+  // side boxes span the outer rows for a rectangle, the guard rows for a cross
+  int32_t nRowSide = (window == Window::Rectangle) ? 
+    nGuardDoppler + nTrainDoppler : nGuardDoppler;
+
+  // store detections temporarily per row, merged in row order
+  rowBin.resize(nDopplerBins);
+
+  pool->parallel_for(nDopplerBins, [&](uint32_t start, uint32_t end, uint32_t)
+  {
+    for (int32_t i = start; i < (int32_t)end; i++)
+    {
+      rowBin[i].clear();
+
+      // skip if less than min Doppler
+      if (std::abs(x->doppler[i]) < minDoppler)
+      {
+        continue;
+      }
+      const T *powerRow = x->power.data() + (size_t)i * nDelayBins;
+      for (int32_t j = 0; j < nDelayBins; j++)
+      {
+        // skip if less than min delay
+        if (x->delay[j] < minDelay)
+        {
+          continue;
+        }
+
+        // leading and lagging delay sides, and the Doppler cells between them
+        int32_t nLead = 0, nLag = 0, nCentre = 0, nGuard = 0;
+        double lead = box(i - nRowSide, i + nRowSide, 
+          j - nGuardDelay - nTrainDelay, j - nGuardDelay - 1, 
+          nDopplerBins, nDelayBins, nLead);
+        double lag = box(i - nRowSide, i + nRowSide, 
+          j + nGuardDelay + 1, j + nGuardDelay + nTrainDelay, 
+          nDopplerBins, nDelayBins, nLag);
+        double centre = box(i - nGuardDoppler - nTrainDoppler, 
+          i + nGuardDoppler + nTrainDoppler, j - nGuardDelay, j + nGuardDelay, 
+          nDopplerBins, nDelayBins, nCentre) - 
+          box(i - nGuardDoppler, i + nGuardDoppler, j - nGuardDelay, 
+          j + nGuardDelay, nDopplerBins, nDelayBins, nGuard);
+        nCentre -= nGuard;
+
+        // estimate noise, each delay half includes the Doppler cells
+        int32_t nCells = 0;
+        double trainNoise = 0;
+        if (mode == Mode::Ca)
+        {
+          nCells = nLead + nLag + nCentre;
+          trainNoise = lead + lag + centre;
+        }
+        else
+        {
+          int32_t nLeadHalf = nLead + nCentre;
+          int32_t nLagHalf = nLag + nCentre;
+          double leadHalf = nLeadHalf > 0 ? (lead + centre) / nLeadHalf : 0;
+          double lagHalf = nLagHalf > 0 ? (lag + centre) / nLagHalf : 0;
+          bool isLead = (nLagHalf == 0) || (nLeadHalf > 0 && 
+            ((mode == Mode::Go) == (leadHalf >= lagHalf)));
+          nCells = isLead ? nLeadHalf : nLagHalf;
+          trainNoise = (isLead ? leadHalf : lagHalf) * nCells;
+        }
+        if (nCells == 0)
+        {
+          continue;
+        }
+
+        // rounding of the table can leave a small negative sum
+        trainNoise = std::max(trainNoise, 0.0) / nCells;
+        double threshold = alpha[nCells] * trainNoise;
+
+        // detection if over threshold
+        if (powerRow[j] > threshold)
+        {
+          rowBin[i].push_back(j);
+        }
+      }
+    }
+  });
+
+  // store detections in row order
+  detection->clear();
+  for (int32_t i = 0; i < nDopplerBins; i++)
+  {
+    const T *levelRow = x->level.data() + (size_t)i * nDelayBins;
+    for (int32_t j : rowBin[i])
+    {
+      detection->push_back(j + x->delay[0], x->doppler[i], 
+        levelRow[j] - x->noisePower, j, i);
+    }
+  }
+}
+
+// allowed types
+template void CfarDetector2D::detect<double>(Map<std::complex<double>> *x, Detection *detection);
+template void CfarDetector2D::detect<float>(Map<std::complex<float>> *x, Detection *detection);
@@ -0,0 +1,136 @@
+/// @file CfarDetector2D.h
+/// @class CfarDetector2D
+/// @brief A class to implement a 2D CFAR detector.
+/// @details Converts an AmbiguityMap to DetectionData. 2D CFAR trains over delay and Doppler, to suppress false alarms from Doppler-spread clutter.
+/// Training sums are box sums of a summed-area table of the power map, so each cell costs O(1) regardless of window size.
+/// The summed-area table and the detection pass are split across threads.
+/// @author 30hours
+
+#ifndef CFARDETECTOR2D_H
+#define CFARDETECTOR2D_H
+
+#include "CfarDetector.h"
+#include "data/Map.h"
+#include "data/Detection.h"
+#include "process/utility/ThreadPool.h"
+#include <stdint.h>
+#include <complex>
+#include <memory>
+#include <vector>
+
+class CfarDetector2D : public CfarDetector
+{
+public:
+
+  /// @brief Estimate of the noise from the training cells.
+  enum class Mode
+  {
+    Ca,  ///< Cell averaging, mean of all training cells.
+    Go,  ///< Greatest of the leading and lagging delay halves.
+    So   ///< Smallest of the leading and lagging delay halves.
+  };
+
+  /// @brief Shape of the training window around the guard cells.
+  enum class Window
+  {
+    Rectangle,  ///< All cells of the outer rectangle.
+    Cross       ///< Only the delay and Doppler arms through the cell.
+  };
+
+private:
+  /// @brief Probability of false alarm, numeric in [0,1]
+  double pfa;
+
+  /// @brief Number of single-sided guard cells in delay.
+  int32_t nGuardDelay;
+
+  /// @brief Number of single-sided guard cells in Doppler.
+  int32_t nGuardDoppler;
+
+  /// @brief Number of single-sided training cells in delay.
+  int32_t nTrainDelay;
+
+  /// @brief Number of single-sided training cells in Doppler.
+  int32_t nTrainDoppler;
+
+  /// @brief Estimate of the noise from the training cells.
+  Mode mode;
+
+  /// @brief Shape of the training window.
+  Window window;
+
+  /// @brief Minimum delay to process detections (bins).
+  int32_t minDelay;
+
+  /// @brief Minimum absolute Doppler to process detections (Hz).
+  double minDoppler;
+
+  /// @brief Threshold factor by number of training cells.
+  std::vector<double> alpha;
+
+  /// @brief Summed-area table of power, (nRows + 1) x (nCols + 1) with a zero first row and column.
+  std::vector<double> table;
+
+  /// @brief Worker pool for the table and detection pass.
+  std::unique_ptr<ThreadPool> pool;
+
+  /// @brief Detected columns per row, merged in row order.
+  std::vector<std::vector<int32_t>> rowBin;
+
+  /// @brief Sum of power over a box of cells, clipped to the map.
+  /// @param row0 First row.
+  /// @param row1 Last row (inclusive).
+  /// @param col0 First column.
+  /// @param col1 Last column (inclusive).
+  /// @param nRows Number of rows.
+  /// @param nCols Number of columns.
+  /// @param nCells Incremented by the number of cells in the box.
+  /// @return Sum of power.
+  double box(int32_t row0, int32_t row1, int32_t col0, int32_t col1, 
+    int32_t nRows, int32_t nCols, int32_t &nCells) const;
+
+  /// @brief Implement the 2D CFAR detector.
+  /// @tparam T Map precision (float or double).
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite.
+  /// @return Void.
+  template <typename T>
+  void detect(Map<std::complex<T>> *x, Detection *detection);
+
+public:
+  /// @brief Constructor.
+  /// @param pfa Probability of false alarm, numeric in [0,1].
+  /// @param nGuardDelay Number of single-sided guard cells in delay.
+  /// @param nGuardDoppler Number of single-sided guard cells in Doppler.
+  /// @param nTrainDelay Number of single-sided training cells in delay.
+  /// @param nTrainDoppler Number of single-sided training cells in Doppler.
+  /// @param mode Estimate of the noise from the training cells.
+  /// @param window Shape of the training window.
+  /// @param minDelay Minimum delay to process detections (bins).
+  /// @param minDoppler Minimum absolute Doppler to process detections (Hz).
+  /// @param nThreads Number of threads for the table and detection pass.
+  /// @return The object.
+  /// @throws std::invalid_argument If a window size is negative or there are no training cells.
+  CfarDetector2D(double pfa, int32_t nGuardDelay, int32_t nGuardDoppler, 
+    int32_t nTrainDelay, int32_t nTrainDoppler, Mode mode = Mode::Ca, 
+    Window window = Window::Rectangle, int32_t minDelay = 0, 
+    double minDoppler = 0, uint32_t nThreads = 1);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~CfarDetector2D();
+
+  /// @brief Implement the 2D CFAR detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<double>> *x, Detection *detection) override;
+
+  /// @brief Implement the 2D CFAR detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<float>> *x, Detection *detection) override;
+};
+
+#endif
@@ -0,0 +1,226 @@
+#include "CfarDetectorClutterMap.h"
+#include "data/Map.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+
+/// @brief Identifier at the start of a background file.
+static const uint32_t BACKGROUND_MAGIC = 0x424d4150;
+
+// constructor
+CfarDetectorClutterMap::CfarDetectorClutterMap(double _pfa, double _forget, 
+  int32_t _minDelay, double _minDoppler, std::string _path)
+{
+  // input
+  pfa = _pfa;
+  forget = _forget;
+  minDelay = _minDelay;
+  minDoppler = _minDoppler;
+  path = _path;
+  if (!(_forget > 0 && _forget <= 1))
+  {
+    throw std::invalid_argument("Clutter map forget must be in (0,1]");
+  }
+  alpha = threshold_factor(pfa, _forget);
+  nWarmup = (uint32_t)std::ceil(1.0 / _forget);
+  nRows = 0;
+  nCols = 0;
+  nUpdate = 0;
+
+  if (!path.empty() && load())
+  {
+    std::cout << "Loaded clutter map background " << path << "\n";
+  }
+}
+
+CfarDetectorClutterMap::~CfarDetectorClutterMap()
+{
+  if (!path.empty() && nUpdate > 0 && !save())
+  {
+    std::cerr << "Failed to save clutter map background " << path << "\n";
+  }
+}
+
+double CfarDetectorClutterMap::threshold_factor(double pfa, double forget)
+{
+  // log of Pfa, decreasing in alpha, truncated once terms are negligible
+  auto logPfa = [forget](double alpha) {
+    double sum = 0;
+    double weight = forget;
+    while (alpha * weight > 1e-12)
+    {
+      sum -= std::log1p(alpha * weight);
+      weight *= 1 - forget;
+    }
+    return sum;
+  };
+  double target = std::log(pfa);
+  double low = 0, high = 1;
+  while (logPfa(high) > target && high < 1e300)
+  {
+    low = high;
+    high *= 2;
+  }
+  for (int i = 0; i < 200 && high - low > 1e-12 * high; i++)
+  {
+    double mid = 0.5 * (low + high);
+    (logPfa(mid) > target ? low : high) = mid;
+  }
+  return high;
+}
+
+void CfarDetectorClutterMap::process(Map<std::complex<double>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
+
+void CfarDetectorClutterMap::process(Map<std::complex<float>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
+
+template <typename T>
+void CfarDetectorClutterMap::detect(Map<std::complex<T>> *x, Detection *detection)
+{
+  uint32_t nDopplerBins = x->get_nRows();
+  uint32_t nDelayBins = x->get_nCols();
+  size_t n = (size_t)nDopplerBins * nDelayBins;
+
+  // reset the background if the map size changes
+  if (nDopplerBins != nRows || nDelayBins != nCols || background.size() != n)
+  {
+    nRows = nDopplerBins;
+    nCols = nDelayBins;
+    nUpdate = 0;
+    background.assign(n, 0);
+  }
+  isDetection.resize(n);
+  if (!x->has_planes())
+  {
+    x->set_metrics();
+  }
+
+  // power of each cell from the map
+  const T *p = x->power.data();
+
+  // threshold against the previous background, then update it
+  float *b = background.data();
+  uint8_t *d = isDetection.data();
+  if (nUpdate == 0)
+  {
+    std::copy(p, p + n, b);
+    std::fill(d, d + n, 0);
+  }
+  else
+  {
+    float a = alpha;
+    float w = forget;
+    for (size_t i = 0; i < n; i++)
+    {
+      float power = p[i];
+      d[i] = power > a * b[i];
+      b[i] += w * (power - b[i]);
+    }
+  }
+  nUpdate++;
+
+  // persist once per time constant of the background
+  if (!path.empty() && nUpdate % nWarmup == 0 && !save())
+  {
+    std::cerr << "Failed to save clutter map background " << path << "\n";
+  }
+
+  // store detections after the warm-up
+  detection->clear();
+  if (nUpdate <= nWarmup)
+  {
+    return;
+  }
+  for (uint32_t i = 0; i < nDopplerBins; i++)
+  {
+    // skip if less than min Doppler
+    if (std::abs(x->doppler[i]) < minDoppler)
+    {
+      continue;
+    }
+    const uint8_t *row = d + (size_t)i * nDelayBins;
+    for (uint32_t j = 0; j < nDelayBins; j++)
+    {
+      // skip if not detected or less than min delay
+      if (!row[j] || x->delay[j] < minDelay)
+      {
+        continue;
+      }
+      detection->push_back(j + x->delay[0], x->doppler[i], 
+        x->level[(size_t)i * nDelayBins + j] - x->noisePower, j, i);
+    }
+  }
+}
+
+bool CfarDetectorClutterMap::save() const
+{
+  std::string pathTemp = path + ".tmp";
+  {
+    std::ofstream file(pathTemp, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      return false;
+    }
+    file.write(reinterpret_cast<const char *>(&BACKGROUND_MAGIC), sizeof(BACKGROUND_MAGIC));
+    file.write(reinterpret_cast<const char *>(&nRows), sizeof(nRows));
+    file.write(reinterpret_cast<const char *>(&nCols), sizeof(nCols));
+    file.write(reinterpret_cast<const char *>(&nUpdate), sizeof(nUpdate));
+    file.write(reinterpret_cast<const char *>(background.data()), 
+      background.size() * sizeof(float));
+    if (!file.good())
+    {
+      return false;
+    }
+  }
+  return std::rename(pathTemp.c_str(), path.c_str()) == 0;
+}
+
+bool CfarDetectorClutterMap::load()
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+  uint32_t magic, rows, cols;
+  uint64_t update;
+  file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+  file.read(reinterpret_cast<char *>(&rows), sizeof(rows));
+  file.read(reinterpret_cast<char *>(&cols), sizeof(cols));
+  file.read(reinterpret_cast<char *>(&update), sizeof(update));
+  if (!file.good() || magic != BACKGROUND_MAGIC)
+  {
+    return false;
+  }
+  std::vector<float, AlignedAllocator<float>> data((size_t)rows * cols);
+  file.read(reinterpret_cast<char *>(data.data()), data.size() * sizeof(float));
+  if (!file.good())
+  {
+    return false;
+  }
+  nRows = rows;
+  nCols = cols;
+  nUpdate = update;
+  background = std::move(data);
+  return true;
+}
+
+uint64_t CfarDetectorClutterMap::get_n_update() const
+{
+  return nUpdate;
+}
+
+// allowed types
+template void CfarDetectorClutterMap::detect<double>(Map<std::complex<double>> *x, Detection *detection);
+template void CfarDetectorClutterMap::detect<float>(Map<std::complex<float>> *x, Detection *detection);
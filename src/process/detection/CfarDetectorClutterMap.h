@@ -0,0 +1,119 @@
+/// @file CfarDetectorClutterMap.h
+/// @class CfarDetectorClutterMap
+/// @brief A class to implement a clutter map CFAR detector.
+/// @details Converts an AmbiguityMap to DetectionData. Keeps an exponentially averaged power per map cell across CPIs, and thresholds each cell against its own background, for static and slowly varying clutter residue.
+/// Thresholding and the background update are one branch-free pass over contiguous float arrays per CPI.
+/// The background can persist to a file, so detection resumes on restart without a warm-up period.
+/// @author 30hours
+
+#ifndef CFARDETECTORCLUTTERMAP_H
+#define CFARDETECTORCLUTTERMAP_H
+
+#include "CfarDetector.h"
+#include "data/Map.h"
+#include "data/Detection.h"
+#include "data/meta/AlignedAllocator.h"
+#include <stdint.h>
+#include <complex>
+#include <memory>
+#include <vector>
+#include <string>
+
+class CfarDetectorClutterMap : public CfarDetector
+{
+private:
+  /// @brief Probability of false alarm, numeric in [0,1]
+  double pfa;
+
+  /// @brief Weight of each new CPI in the background, numeric in (0,1].
+  float forget;
+
+  /// @brief Threshold factor on the background.
+  float alpha;
+
+  /// @brief Minimum delay to process detections (bins).
+  int32_t minDelay;
+
+  /// @brief Minimum absolute Doppler to process detections (Hz).
+  double minDoppler;
+
+  /// @brief Path to persist the background, empty to disable.
+  std::string path;
+
+  /// @brief Number of CPIs to average before detecting, and between saves.
+  uint32_t nWarmup;
+
+  /// @brief Number of rows and columns of the background.
+  /// @{
+  uint32_t nRows, nCols;
+  /// @}
+
+  /// @brief Number of CPIs averaged into the background.
+  uint64_t nUpdate;
+
+  /// @brief Background power per cell, row-major.
+  std::vector<float, AlignedAllocator<float>> background;
+
+  /// @brief True if the cell is over threshold, row-major.
+  std::vector<uint8_t> isDetection;
+
+  /// @brief Solve the clutter map threshold factor.
+  /// @details Pfa = prod_{k>=0} 1 / (1 + alpha forget (1 - forget)^k) for exponential cell power, solved by bisection.
+  /// @param pfa Probability of false alarm.
+  /// @param forget Weight of each new CPI in the background.
+  /// @return Threshold factor.
+  static double threshold_factor(double pfa, double forget);
+
+  /// @brief Implement the clutter map detector.
+  /// @tparam T Map precision (float or double).
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite.
+  /// @return Void.
+  template <typename T>
+  void detect(Map<std::complex<T>> *x, Detection *detection);
+
+public:
+  /// @brief Constructor.
+  /// @details Loads the background from path if it exists and matches a later map size.
+  /// @param pfa Probability of false alarm, numeric in [0,1].
+  /// @param forget Weight of each new CPI in the background, numeric in (0,1].
+  /// @param minDelay Minimum delay to process detections (bins).
+  /// @param minDoppler Minimum absolute Doppler to process detections (Hz).
+  /// @param path Path to persist the background, empty to disable.
+  /// @return The object.
+  /// @throws std::invalid_argument If forget is out of range.
+  CfarDetectorClutterMap(double pfa, double forget, int32_t minDelay = 0, 
+    double minDoppler = 0, std::string path = "");
+
+  /// @brief Destructor.
+  /// @details Saves the background if a path is set.
+  /// @return Void.
+  ~CfarDetectorClutterMap();
+
+  /// @brief Implement the clutter map detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<double>> *x, Detection *detection) override;
+
+  /// @brief Implement the clutter map detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<float>> *x, Detection *detection) override;
+
+  /// @brief Save the background to path.
+  /// @details Written to a temporary file then renamed, so a restart never reads a partial file.
+  /// @return True if saved.
+  bool save() const;
+
+  /// @brief Load the background from path.
+  /// @return True if loaded.
+  bool load();
+
+  /// @brief Get the number of CPIs averaged into the background.
+  /// @return Number of CPIs.
+  uint64_t get_n_update() const;
+};
+
+#endif
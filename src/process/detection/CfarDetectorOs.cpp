@@ -0,0 +1,226 @@
+#include "CfarDetectorOs.h"
+#include "data/Map.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+// constructor
+CfarDetectorOs::CfarDetectorOs(double _pfa, int32_t _nGuard, int32_t _nTrain, 
+  double _rank, int32_t _minDelay, double _minDoppler, uint32_t _nThreads)
+{
+  // input
+  pfa = _pfa;
+  nGuard = _nGuard;
+  nTrain = _nTrain;
+  rank = _rank;
+  minDelay = _minDelay;
+  minDoppler = _minDoppler;
+  if (nGuard < 0 || nTrain <= 0)
+  {
+    throw std::invalid_argument("OS-CFAR requires training cells and non-negative guard cells");
+  }
+  if (!(rank > 0 && rank <= 1))
+  {
+    throw std::invalid_argument("OS-CFAR rank must be in (0,1]");
+  }
+
+  // order statistic and threshold factor only vary with training cells at the edges
+  order.resize(2 * nTrain + 1, 0);
+  alpha.resize(2 * nTrain + 1, 0);
+  for (uint32_t nCells = 1; nCells < order.size(); nCells++)
+  {
+    uint32_t k = std::clamp<uint32_t>((uint32_t)std::lround(rank * nCells), 1, nCells);
+    order[nCells] = k - 1;
+    alpha[nCells] = threshold_factor(nCells, k, pfa);
+  }
+
+  pool = std::make_unique<ThreadPool>(std::max<uint32_t>(1, _nThreads));
+  threadPower.resize(pool->get_n_threads());
+  threadWindow.resize(pool->get_n_threads());
+}
+
+CfarDetectorOs::~CfarDetectorOs()
+{
+}
+
+double CfarDetectorOs::threshold_factor(uint32_t n, uint32_t k, double pfa)
+{
+  // log of Pfa, decreasing in alpha
+  auto logPfa = [n, k](double alpha) {
+    double sum = 0;
+    for (uint32_t i = 0; i < k; i++)
+    {
+      sum += std::log((double)(n - i)) - std::log(n - i + alpha);
+    }
+    return sum;
+  };
+  double target = std::log(pfa);
+  double low = 0, high = 1;
+  while (logPfa(high) > target && high < 1e300)
+  {
+    low = high;
+    high *= 2;
+  }
+  for (int i = 0; i < 200 && high - low > 1e-12 * high; i++)
+  {
+    double mid = 0.5 * (low + high);
+    (logPfa(mid) > target ? low : high) = mid;
+  }
+  return high;
+}
+
+void CfarDetectorOs::process(Map<std::complex<double>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
+
+void CfarDetectorOs::process(Map<std::complex<float>> *x, Detection *detection)
+{
+  detect(x, detection);
+}
+
+template <typename T>
+void CfarDetectorOs::detect(Map<std::complex<T>> *x, Detection *detection)
+{
+  int32_t nDelayBins = x->get_nCols();
+  int32_t nDopplerBins = x->get_nRows();
+  if (!x->has_planes())
+  {
+    x->set_metrics();
+  }
+
+  // store detections temporarily per row, merged in row order
+  rowBin.resize(nDopplerBins);
+
+  pool->parallel_for(nDopplerBins, [&](uint32_t start, uint32_t end, uint32_t thread)
+  {
+    std::vector<double> &power = threadPower[thread];
+    std::vector<double> &window = threadWindow[thread];
+    power.resize(nDelayBins);
+    window.reserve(2 * nTrain);
+
+    // keep the training window sorted as cells enter and leave
+    auto insert = [&](int32_t k) {
+      window.insert(std::upper_bound(window.begin(), window.end(), power[k]), power[k]);
+    };
+    auto remove = [&](int32_t k) {
+      window.erase(std::lower_bound(window.begin(), window.end(), power[k]));
+    };
+    // a cell leaving and a cell entering only shifts the cells between them,
+    // ranks are counted branch-free for short windows
+    auto replace = [&](int32_t kOut, int32_t kIn) {
+      double out = power[kOut];
+      double in = power[kIn];
+      size_t n = window.size();
+      size_t pOut = 0, pIn = 0;
+      if (n <= 32)
+      {
+        for (size_t q = 0; q < n; q++)
+        {
+          pOut += window[q] < out;
+          pIn += window[q] < in;
+        }
+      }
+      else
+      {
+        pOut = std::lower_bound(window.begin(), window.end(), out) - window.begin();
+        pIn = std::lower_bound(window.begin(), window.end(), in) - window.begin();
+      }
+      if (pIn > pOut)
+      {
+        std::copy(window.begin() + pOut + 1, window.begin() + pIn, window.begin() + pOut);
+        window[pIn - 1] = in;
+      }
+      else
+      {
+        std::copy_backward(window.begin() + pIn, window.begin() + pOut, window.begin() + pOut + 1);
+        window[pIn] = in;
+      }
+    };
+
+    for (int32_t i = start; i < (int32_t)end; i++)
+    {
+      rowBin[i].clear();
+
+      // skip if less than min Doppler
+      if (std::abs(x->doppler[i]) < minDoppler)
+      {
+        continue;
+      }
+      const T *powerRow = x->power.data() + (size_t)i * nDelayBins;
+      for (int32_t j = 0; j < nDelayBins; j++)
+      {
+        power[j] = powerRow[j];
+        // NaN has no order, treat as the largest cell
+        if (std::isnan(power[j]))
+        {
+          power[j] = std::numeric_limits<double>::infinity();
+        }
+      }
+
+      // windows [left0, left1) and [right0, right1), clipped to the row
+      window.clear();
+      int32_t left0 = 0, left1 = 0, right0 = 0, right1 = 0;
+      for (int32_t j = 0; j < nDelayBins; j++)
+      {
+        int32_t nextLeft0 = std::clamp(j - nGuard - nTrain, 0, nDelayBins);
+        int32_t nextLeft1 = std::clamp(j - nGuard, 0, nDelayBins);
+        int32_t nextRight0 = std::clamp(j + nGuard + 1, 0, nDelayBins);
+        int32_t nextRight1 = std::clamp(j + nGuard + nTrain + 1, 0, nDelayBins);
+        for (; left0 < nextLeft0 && left1 < nextLeft1; left0++, left1++) { replace(left0, left1); }
+        for (; left0 < nextLeft0; left0++) { remove(left0); }
+        for (; left1 < nextLeft1; left1++) { insert(left1); }
+        for (; right0 < nextRight0 && right0 < right1 && right1 < nextRight1; right0++, right1++)
+        {
+          replace(right0, right1);
+        }
+        for (; right0 < nextRight0; right0++)
+        {
+          if (right0 < right1) { remove(right0); }
+        }
+        for (; right1 < nextRight1; right1++)
+        {
+          if (right1 >= right0) { insert(right1); }
+        }
+
+        // skip if less than min delay
+        if (x->delay[j] < minDelay)
+        {
+          continue;
+        }
+
+        // detection if over the scaled order statistic
+        uint32_t nCells = window.size();
+        if (nCells == 0)
+        {
+          continue;
+        }
+        double threshold = alpha[nCells] * window[order[nCells]];
+        if (power[j] > threshold)
+        {
+          rowBin[i].push_back(j);
+        }
+      }
+    }
+  });
+
+  // store detections in row order
+  detection->clear();
+  for (int32_t i = 0; i < nDopplerBins; i++)
+  {
+    const T *levelRow = x->level.data() + (size_t)i * nDelayBins;
+    for (int32_t j : rowBin[i])
+    {
+      detection->push_back(j + x->delay[0], x->doppler[i], 
+        levelRow[j] - x->noisePower, j, i);
+    }
+  }
+}
+
+// allowed types
+template void CfarDetectorOs::detect<double>(Map<std::complex<double>> *x, Detection *detection);
+template void CfarDetectorOs::detect<float>(Map<std::complex<float>> *x, Detection *detection);
@@ -0,0 +1,107 @@
+/// @file CfarDetectorOs.h
+/// @class CfarDetectorOs
+/// @brief A class to implement a 1D ordered-statistic CFAR detector.
+/// @details Converts an AmbiguityMap to DetectionData. OS-CFAR takes the k-th smallest training cell as the noise estimate, so strong neighbouring targets do not mask weaker ones.
+/// The training cells of each Doppler row are kept sorted as the window slides along delay, so each step inserts and removes cells rather than re-sorting.
+/// Doppler rows are processed in parallel.
+/// @author 30hours
+
+#ifndef CFARDETECTOROS_H
+#define CFARDETECTOROS_H
+
+#include "CfarDetector.h"
+#include "data/Map.h"
+#include "data/Detection.h"
+#include "process/utility/ThreadPool.h"
+#include <stdint.h>
+#include <complex>
+#include <memory>
+#include <vector>
+
+class CfarDetectorOs : public CfarDetector
+{
+private:
+  /// @brief Probability of false alarm, numeric in [0,1]
+  double pfa;
+
+  /// @brief Number of single-sided guard cells.
+  int32_t nGuard;
+
+  /// @brief Number of single-sided training cells.
+  int32_t nTrain;
+
+  /// @brief Rank of the order statistic as a fraction of training cells, numeric in (0,1].
+  double rank;
+
+  /// @brief Minimum delay to process detections (bins).
+  int32_t minDelay;
+
+  /// @brief Minimum absolute Doppler to process detections (Hz).
+  double minDoppler;
+
+  /// @brief Index of the order statistic by number of training cells.
+  std::vector<uint32_t> order;
+
+  /// @brief Threshold factor by number of training cells.
+  std::vector<double> alpha;
+
+  /// @brief Worker pool for processing rows.
+  std::unique_ptr<ThreadPool> pool;
+
+  /// @brief Power of the current row per thread.
+  std::vector<std::vector<double>> threadPower;
+
+  /// @brief Sorted training window per thread.
+  std::vector<std::vector<double>> threadWindow;
+
+  /// @brief Detected columns per row, merged in row order.
+  std::vector<std::vector<int32_t>> rowBin;
+
+  /// @brief Solve the OS-CFAR threshold factor.
+  /// @details Pfa = prod_{i=0}^{k-1} (n - i) / (n - i + alpha) for exponential cell power, solved by bisection.
+  /// @param n Number of training cells.
+  /// @param k Rank of the order statistic (1 is the smallest).
+  /// @param pfa Probability of false alarm.
+  /// @return Threshold factor.
+  static double threshold_factor(uint32_t n, uint32_t k, double pfa);
+
+  /// @brief Implement the OS-CFAR detector.
+  /// @tparam T Map precision (float or double).
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite.
+  /// @return Void.
+  template <typename T>
+  void detect(Map<std::complex<T>> *x, Detection *detection);
+
+public:
+  /// @brief Constructor.
+  /// @param pfa Probability of false alarm, numeric in [0,1].
+  /// @param nGuard Number of single-sided guard cells.
+  /// @param nTrain Number of single-sided training cells.
+  /// @param rank Rank of the order statistic as a fraction of training cells, numeric in (0,1].
+  /// @param minDelay Minimum delay to process detections (bins).
+  /// @param minDoppler Minimum absolute Doppler to process detections (Hz).
+  /// @param nThreads Number of threads to process rows.
+  /// @return The object.
+  /// @throws std::invalid_argument If there are no training cells or the rank is out of range.
+  CfarDetectorOs(double pfa, int32_t nGuard, int32_t nTrain, double rank, 
+    int32_t minDelay = 0, double minDoppler = 0, uint32_t nThreads = 1);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~CfarDetectorOs();
+
+  /// @brief Implement the OS-CFAR detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<double>> *x, Detection *detection) override;
+
+  /// @brief Implement the OS-CFAR detector.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<float>> *x, Detection *detection) override;
+};
+
+#endif
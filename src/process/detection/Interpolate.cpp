@@ -17,19 +17,24 @@ Interpolate::~Interpolate()
 {
 }
 
-std::unique_ptr<Detection> Interpolate::process(Detection *x, Map<std::complex<double>> *y)
+template <typename T>
+void Interpolate::process(Detection *x, Map<std::complex<T>> *y, Detection *detection)
 { 
-  // store detections temporarily
-  std::vector<double> delay, doppler, snr;
-  delay = x->get_delay();
-  doppler = x->get_doppler();
-  snr = x->get_snr();
+  // read detections in place
+  const std::vector<double> &delay = x->get_delay();
+  const std::vector<double> &doppler = x->get_doppler();
+  const std::vector<double> &snr = x->get_snr();
 
   // interpolate data
   double intDelay, intDoppler, intSnrDelay, intSnrDoppler, intSnr[3];
-  std::vector<double> delay2, doppler2, snr2;
-  std::deque<int> indexDelay = y->delay;
-  std::deque<double> indexDoppler = y->doppler;
+  detection->clear();
+  int32_t nDelayBins = y->get_nCols();
+  int32_t nDopplerBins = y->get_nRows();
+  bool hasBin = x->has_bin();
+  if (!y->has_planes())
+  {
+    y->set_metrics();
+  }
 
   // loop over every detection
   for (size_t i = 0; i < snr.size(); i++)
@@ -39,17 +44,28 @@ std::unique_ptr<Detection> Interpolate::process(Detection *x, Map<std::complex<d
     intDoppler = doppler[i];
     intSnrDelay = snr[i];
     intSnrDoppler = snr[i];
+    // map indices from the detector, or from the regular map axes
+    int32_t col = hasBin ? x->get_delay_bin()[i] : y->delay_to_bin(delay[i]);
+    int32_t row = hasBin ? x->get_doppler_bin()[i] : y->doppler_hz_to_bin(doppler[i]);
+    if (col < 0 || row < 0 || col >= nDelayBins || row >= nDopplerBins)
+    {
+      std::cout << "Detection dropped (outside map)" << std::endl;
+      continue;
+    }
+    const T *level = y->level.data();
+    size_t cell = (size_t)row * nDelayBins + col;
+    double snrPeak = level[cell]-y->noisePower;
     // interpolate in delay
     if (doDelay)
     {
       // check not on boundary
-      if (delay[i] == indexDelay[0] || delay[i] == indexDelay.back())
+      if (col == 0 || col == nDelayBins - 1)
       {
         continue;
       }
-      intSnr[0] = (double)10*std::log10(std::abs(y->data[y->doppler_hz_to_bin(doppler[i])][delay[i]-1-indexDelay[0]]))-y->noisePower;
-      intSnr[1] = (double)10*std::log10(std::abs(y->data[y->doppler_hz_to_bin(doppler[i])][delay[i]-indexDelay[0]]))-y->noisePower;
-      intSnr[2] = (double)10*std::log10(std::abs(y->data[y->doppler_hz_to_bin(doppler[i])][delay[i]+1-indexDelay[0]]))-y->noisePower;
+      intSnr[0] = level[cell-1]-y->noisePower;
+      intSnr[1] = snrPeak;
+      intSnr[2] = level[cell+1]-y->noisePower;
       // check detection has peak SNR of neighbours
       if (intSnr[1] < intSnr[0] || intSnr[1] < intSnr[2])
       {
@@ -64,13 +80,13 @@ std::unique_ptr<Detection> Interpolate::process(Detection *x, Map<std::complex<d
     if (doDoppler)
     {
       // check not on boundary
-      if (doppler[i] == indexDoppler[0] || doppler[i] == indexDoppler.back())
+      if (row == 0 || row == nDopplerBins - 1)
       {
         continue;
       }
-      intSnr[0] = (double)10*std::log10(std::abs(y->data[y->doppler_hz_to_bin(doppler[i])-1][delay[i]-indexDelay[0]]))-y->noisePower;
-      intSnr[1] = (double)10*std::log10(std::abs(y->data[y->doppler_hz_to_bin(doppler[i])][delay[i]-indexDelay[0]]))-y->noisePower;
-      intSnr[2] = (double)10*std::log10(std::abs(y->data[y->doppler_hz_to_bin(doppler[i])+1][delay[i]-indexDelay[0]]))-y->noisePower;
+      intSnr[0] = level[cell-nDelayBins]-y->noisePower;
+      intSnr[1] = snrPeak;
+      intSnr[2] = level[cell+nDelayBins]-y->noisePower;
       // check detection has peak SNR of neighbours
       if (intSnr[1] < intSnr[0] || intSnr[1] < intSnr[2])
       {
@@ -78,14 +94,14 @@ std::unique_ptr<Detection> Interpolate::process(Detection *x, Map<std::complex<d
       }
       intDoppler = (intSnr[0]-intSnr[2])/(2*(intSnr[0]-(2*intSnr[1])+intSnr[2]));
       intSnrDelay = intSnr[1] - (((intSnr[0]-intSnr[2])*intDoppler)/4);
-      intDoppler = doppler[i] + ((indexDoppler[1]-indexDoppler[0])*intDoppler);
+      intDoppler = doppler[i] + ((y->doppler[1]-y->doppler[0])*intDoppler);
     }
     // store interpolated detections
-    delay2.push_back(intDelay);
-    doppler2.push_back(intDoppler);
-    snr2.push_back(std::max(std::max(intSnrDelay, intSnrDoppler), snr[i]));
+    detection->push_back(intDelay, intDoppler, 
+      std::max(std::max(intSnrDelay, intSnrDoppler), snr[i]), col, row);
   }
-
-  // create detection
-  return std::make_unique<Detection>(delay2, doppler2, snr2);
 }
+
+// allowed types
+template void Interpolate::process<double>(Detection *x, Map<std::complex<double>> *y, Detection *detection);
+template void Interpolate::process<float>(Detection *x, Map<std::complex<float>> *y, Detection *detection);
@@ -6,7 +6,6 @@
 /// - https://ccrma.stanford.edu/~jos/sasp/Quadratic_Interpolation_Spectral_Peaks.html
 /// - Fundamentals of Signal Processing (2nd), Richards, Section 5.3.6
 /// @author 30hours
-/// @todo Should I remove the detection pointer? Also on Centroid.
 
 #ifndef INTERPOLATE_H
 #define INTERPOLATE_H
@@ -25,9 +24,6 @@ private:
   /// @brief True if interpolating over Doppler.
   bool doDoppler;
 
-  /// @brief Pointer to detection data to store result.
-  Detection *detection;
-
 public:
   /// @brief Constructor.
   /// @param doDelay True if interpolating over delay.
@@ -40,9 +36,13 @@ public:
   ~Interpolate();
 
   /// @brief Implement the 1D CFAR detector.
+  /// @tparam T Map precision (float or double).
   /// @param x Detections from the 1D CFAR detector.
-  /// @return Interpolated detections.
-  std::unique_ptr<Detection> process(Detection *x, Map<std::complex<double>> *y);
+  /// @param y Ambiguity map the detections are from.
+  /// @param detection Interpolated detections to overwrite, storage is reused. Must not be x.
+  /// @return Void.
+  template <typename T>
+  void process(Detection *x, Map<std::complex<T>> *y, Detection *detection);
 };
 
 #endif
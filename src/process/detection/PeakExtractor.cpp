@@ -0,0 +1,170 @@
+#include "PeakExtractor.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// constructor
+PeakExtractor::PeakExtractor(double _pfa, int8_t _nGuard, int8_t _nTrain,
+  int8_t _minDelay, double _minDoppler, uint16_t _nDelay, uint16_t _nDoppler,
+  double _resolutionDoppler, uint32_t _nThreads)
+{
+  // input
+  minDoppler = _minDoppler;
+  nDelay = _nDelay;
+  nDoppler = _nDoppler;
+  resolutionDoppler = _resolutionDoppler;
+
+  // rows are thresholded by the sweep, so the detector needs no threads
+  cfar = std::make_unique<CfarDetector1D>(_pfa, _nGuard, _nTrain,
+    _minDelay, _minDoppler, 1);
+  pool = std::make_unique<ThreadPool>(std::max<uint32_t>(1, _nThreads));
+  ring.resize(pool->get_n_threads());
+  prefix.resize(pool->get_n_threads());
+}
+
+PeakExtractor::~PeakExtractor()
+{
+}
+
+void PeakExtractor::process(Map<std::complex<double>> *x, Detection *detection)
+{
+  extract(x, detection);
+}
+
+void PeakExtractor::process(Map<std::complex<float>> *x, Detection *detection)
+{
+  extract(x, detection);
+}
+
+template <typename T>
+void PeakExtractor::extract(Map<std::complex<T>> *x, Detection *detection)
+{
+  int32_t nDelayBins = x->get_nCols();
+  int32_t nDopplerBins = x->get_nRows();
+  if (!x->has_planes())
+  {
+    x->set_metrics();
+  }
+  const T *level = x->level.data();
+  double noisePower = x->noisePower;
+  double widthDoppler = nDoppler * resolutionDoppler;
+  bool isWindow = nDelay > 0 && widthDoppler > 0;
+
+  // rows either side that can be within the centroid window on the regular Doppler axis
+  int32_t nHalf = 0;
+  if (isWindow && nDopplerBins > 1)
+  {
+    double step = std::abs(x->doppler[1] - x->doppler[0]);
+    nHalf = (step > 0) ? (int32_t)std::min<double>(
+      std::floor(widthDoppler / step) + 1, nDopplerBins - 1) : nDopplerBins - 1;
+  }
+  uint32_t nRing = 2 * nHalf + 1;
+  rowPeak.resize(nDopplerBins);
+
+  pool->parallel_for(nDopplerBins, [&](uint32_t start, uint32_t end, uint32_t threadIndex)
+  {
+    std::vector<std::vector<int32_t>> &rows = ring[threadIndex];
+    rows.resize(nRing);
+    int32_t next = std::max((int32_t)start - nHalf, 0);
+    for (int32_t i = start; i < (int32_t)end; i++)
+    {
+      // threshold rows up to the far side of the window
+      for (; next <= std::min(i + nHalf, nDopplerBins - 1); next++)
+      {
+        std::vector<int32_t> &cols = rows[next % nRing];
+        cols.clear();
+        if (std::abs(x->doppler[next]) < minDoppler)
+        {
+          continue;
+        }
+        cfar->threshold_row(x->power.data() + (size_t)next * nDelayBins,
+          x->delay, nDelayBins, prefix[threadIndex], cols);
+      }
+
+      std::vector<Peak> &peaks = rowPeak[i];
+      peaks.clear();
+      double dopplerMin = x->doppler[i] - (nDoppler * resolutionDoppler);
+      double dopplerMax = x->doppler[i] + (nDoppler * resolutionDoppler);
+      for (int32_t col : rows[i % nRing])
+      {
+        size_t cell = (size_t)i * nDelayBins + col;
+        double snr = level[cell] - noisePower;
+
+        // centroid, remove if a detection in the window has higher SNR
+        bool isCentroid = true;
+        for (int32_t r = std::max(i - nHalf, 0); isWindow && isCentroid &&
+          r <= std::min(i + nHalf, nDopplerBins - 1); r++)
+        {
+          if (!(x->doppler[r] > dopplerMin && x->doppler[r] < dopplerMax))
+          {
+            continue;
+          }
+          const std::vector<int32_t> &cols = rows[r % nRing];
+          auto it = std::lower_bound(cols.begin(), cols.end(), col - nDelay + 1);
+          for (; it != cols.end() && *it < col + nDelay; ++it)
+          {
+            if ((r != i || *it != col) &&
+              snr < level[(size_t)r * nDelayBins + *it] - noisePower)
+            {
+              isCentroid = false;
+              break;
+            }
+          }
+        }
+        if (!isCentroid)
+        {
+          continue;
+        }
+
+        // interpolate in delay, dropped on the boundary or if not a peak
+        if (col == 0 || col == nDelayBins - 1)
+        {
+          continue;
+        }
+        double intSnr[3];
+        intSnr[0] = level[cell - 1] - noisePower;
+        intSnr[1] = snr;
+        intSnr[2] = level[cell + 1] - noisePower;
+        if (intSnr[1] < intSnr[0] || intSnr[1] < intSnr[2])
+        {
+          continue;
+        }
+        double intDelay = (intSnr[0]-intSnr[2])/(2*(intSnr[0]-(2*intSnr[1])+intSnr[2]));
+        double intSnrDelay = intSnr[1] - (((intSnr[0]-intSnr[2])*intDelay)/4);
+        intDelay = (col + x->delay[0]) + intDelay;
+
+        // interpolate in Doppler, replacing the delay SNR as Interpolate does
+        if (i == 0 || i == nDopplerBins - 1)
+        {
+          continue;
+        }
+        intSnr[0] = level[cell - nDelayBins] - noisePower;
+        intSnr[2] = level[cell + nDelayBins] - noisePower;
+        if (intSnr[1] < intSnr[0] || intSnr[1] < intSnr[2])
+        {
+          continue;
+        }
+        double intDoppler = (intSnr[0]-intSnr[2])/(2*(intSnr[0]-(2*intSnr[1])+intSnr[2]));
+        intSnrDelay = intSnr[1] - (((intSnr[0]-intSnr[2])*intDoppler)/4);
+        intDoppler = x->doppler[i] + ((x->doppler[1]-x->doppler[0])*intDoppler);
+
+        peaks.push_back({intDelay, intDoppler, std::max(intSnrDelay, snr), col});
+      }
+    }
+  });
+
+  // store detections in row order
+  detection->clear();
+  for (int32_t i = 0; i < nDopplerBins; i++)
+  {
+    for (const Peak &peak : rowPeak[i])
+    {
+      detection->push_back(peak.delay, peak.doppler, peak.snr, peak.delayBin, i);
+    }
+  }
+}
+
+// allowed types
+template void PeakExtractor::extract<double>(Map<std::complex<double>> *x, Detection *detection);
+template void PeakExtractor::extract<float>(Map<std::complex<float>> *x, Detection *detection);
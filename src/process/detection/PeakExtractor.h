@@ -0,0 +1,108 @@
+/// @file PeakExtractor.h
+/// @class PeakExtractor
+/// @brief A class to extract target peaks from an ambiguity map in one pass.
+/// @details Fuses the 1D CFAR detector, window centroid and quadratic interpolation with the same result as CfarDetector1D, Centroid and Interpolate in turn.
+/// Each thread sweeps a contiguous block of rows once, thresholding rows into a ring the height of the centroid window, and resolves a row as soon as the rows either side are thresholded.
+/// Detections are written into a reused Detection, so the steady state does not allocate.
+/// @author 30hours
+
+#ifndef PEAKEXTRACTOR_H
+#define PEAKEXTRACTOR_H
+
+#include "CfarDetector1D.h"
+#include "data/Map.h"
+#include "data/Detection.h"
+#include "process/utility/ThreadPool.h"
+#include <stdint.h>
+#include <complex>
+#include <memory>
+#include <vector>
+
+class PeakExtractor
+{
+private:
+  /// @brief A detection resolved in a row.
+  struct Peak
+  {
+    /// @brief Interpolated delay (bins).
+    double delay;
+
+    /// @brief Interpolated Doppler (Hz).
+    double doppler;
+
+    /// @brief Interpolated SNR (dB).
+    double snr;
+
+    /// @brief Map column index.
+    int32_t delayBin;
+  };
+
+  /// @brief 1D CFAR detector to threshold each row.
+  std::unique_ptr<CfarDetector1D> cfar;
+
+  /// @brief Minimum absolute Doppler to process detections (Hz).
+  double minDoppler;
+
+  /// @brief Number of delay bins to check for the centroid.
+  uint16_t nDelay;
+
+  /// @brief Number of Doppler bins to check for the centroid.
+  uint16_t nDoppler;
+
+  /// @brief Doppler resolution to convert Hz to bins (Hz).
+  double resolutionDoppler;
+
+  /// @brief Worker pool for processing blocks of rows.
+  std::unique_ptr<ThreadPool> pool;
+
+  /// @brief Thresholded column indices per thread, a ring of rows indexed by row.
+  std::vector<std::vector<std::vector<int32_t>>> ring;
+
+  /// @brief Prefix sum storage per thread.
+  std::vector<std::vector<double>> prefix;
+
+  /// @brief Resolved detections per row, merged in row order.
+  std::vector<std::vector<Peak>> rowPeak;
+
+  /// @brief Extract peaks from the map.
+  /// @tparam T Map precision (float or double).
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite.
+  /// @return Void.
+  template <typename T>
+  void extract(Map<std::complex<T>> *x, Detection *detection);
+
+public:
+  /// @brief Constructor.
+  /// @param pfa Probability of false alarm, numeric in [0,1].
+  /// @param nGuard Number of single-sided guard cells.
+  /// @param nTrain Number of single-sided training cells.
+  /// @param minDelay Minimum delay to process detections (bins).
+  /// @param minDoppler Minimum absolute Doppler to process detections (Hz).
+  /// @param nDelay Number of delay bins to check for the centroid.
+  /// @param nDoppler Number of Doppler bins to check for the centroid.
+  /// @param resolutionDoppler Doppler resolution to convert Hz to bins (Hz).
+  /// @param nThreads Number of threads to process rows.
+  /// @return The object.
+  PeakExtractor(double pfa, int8_t nGuard, int8_t nTrain, int8_t minDelay,
+    double minDoppler, uint16_t nDelay, uint16_t nDoppler,
+    double resolutionDoppler, uint32_t nThreads = 1);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~PeakExtractor();
+
+  /// @brief Extract peaks from the map.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<double>> *x, Detection *detection);
+
+  /// @brief Extract peaks from the map.
+  /// @param x Ambiguity map data of IQ samples.
+  /// @param detection Detections to overwrite, storage is reused.
+  /// @return Void.
+  void process(Map<std::complex<float>> *x, Detection *detection);
+};
+
+#endif
@@ -0,0 +1,211 @@
+#include "Autotune.h"
+#include <complex>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <limits>
+#include <cctype>
+
+// constructor
+template <typename T>
+Autotune<T>::Autotune(std::string _path, std::string _config,
+  uint32_t _nThreads, uint32_t _nRepeat)
+{
+  path = _path;
+  key = sanitise(cpu_key()) + " " + sanitise(_config);
+  nRepeat = std::max<uint32_t>(1, _nRepeat);
+  nThreads = std::max<uint32_t>(1, _nThreads);
+
+  // load profile, each line is "cpu config name value"
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    std::istringstream fields(line);
+    std::string cpu, config, name;
+    uint32_t value;
+    if (!(fields >> cpu >> config >> name >> value))
+    {
+      continue;
+    }
+    if (cpu + " " + config == key)
+    {
+      choice[name] = value;
+      isCached[name] = true;
+    }
+    else
+    {
+      other.push_back(line);
+    }
+  }
+}
+
+template <typename T>
+Autotune<T>::~Autotune()
+{
+}
+
+template <typename T>
+double Autotune<T>::time_fft(uint32_t n, uint32_t _nThreads)
+{
+  std::vector<Complex, AlignedAllocator<Complex>> data(n);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    data[i] = Complex((T)((i * 7919) % 1021), (T)((i * 104729) % 1031));
+  }
+
+  Fftw<T>::plan_with_nthreads(_nThreads);
+  typename Fftw<T>::Plan plan = Fftw<T>::plan_dft_1d(n, data.data(),
+    data.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+
+  // warm up caches before timing
+  Fftw<T>::execute(plan);
+  double best = std::numeric_limits<double>::max();
+  for (uint32_t i = 0; i < nRepeat; i++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    Fftw<T>::execute(plan);
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - start).count());
+  }
+  Fftw<T>::destroy_plan(plan);
+  Fftw<T>::plan_with_nthreads(nThreads);
+
+  return best;
+}
+
+template <typename T>
+uint32_t Autotune<T>::fft_length(const std::string &name, uint32_t nMin)
+{
+  if (choice.count(name) && choice[name] >= nMin)
+  {
+    return choice[name];
+  }
+
+  // no padding, 5-smooth, 7-smooth and power of 2
+  std::vector<uint32_t> candidate = {nMin, next_hamming(nMin - 1),
+    next_smooth(nMin - 1, {2, 3, 5, 7})};
+  uint32_t pow2 = 1;
+  while (pow2 < nMin)
+  {
+    pow2 *= 2;
+  }
+  candidate.push_back(pow2);
+  std::sort(candidate.begin(), candidate.end());
+  candidate.erase(std::unique(candidate.begin(), candidate.end()), candidate.end());
+
+  uint32_t best = nMin;
+  double timeBest = std::numeric_limits<double>::max();
+  for (uint32_t n : candidate)
+  {
+    double time = time_fft(n, nThreads);
+    if (time < timeBest)
+    {
+      timeBest = time;
+      best = n;
+    }
+  }
+
+  choice[name] = best;
+  isCached[name] = false;
+  return best;
+}
+
+template <typename T>
+uint32_t Autotune<T>::fft_threads(const std::string &name, uint32_t n, uint32_t nMax)
+{
+  nMax = std::max<uint32_t>(1, nMax);
+  if (choice.count(name) && choice[name] <= nMax)
+  {
+    nThreads = choice[name];
+    Fftw<T>::plan_with_nthreads(nThreads);
+    return nThreads;
+  }
+
+  uint32_t best = 1;
+  double timeBest = std::numeric_limits<double>::max();
+  for (uint32_t i = 1; i <= nMax; i *= 2)
+  {
+    double time = time_fft(n, i);
+    if (time < timeBest)
+    {
+      timeBest = time;
+      best = i;
+    }
+  }
+
+  choice[name] = best;
+  isCached[name] = false;
+  nThreads = best;
+  Fftw<T>::plan_with_nthreads(nThreads);
+  return best;
+}
+
+template <typename T>
+bool Autotune<T>::is_cached(const std::string &name) const
+{
+  auto it = isCached.find(name);
+  return it != isCached.end() && it->second;
+}
+
+template <typename T>
+bool Autotune<T>::save()
+{
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open())
+  {
+    return false;
+  }
+  for (const auto &line : other)
+  {
+    file << line << "\n";
+  }
+  for (const auto &[name, value] : choice)
+  {
+    file << key << " " << name << " " << value << "\n";
+  }
+  return file.good();
+}
+
+template <typename T>
+std::string Autotune<T>::to_string() const
+{
+  std::ostringstream report;
+  for (const auto &[name, value] : choice)
+  {
+    report << "Autotune " << name << ": " << value
+      << (is_cached(name) ? " (profile)" : " (timed)") << "\n";
+  }
+  return report.str();
+}
+
+template <typename T>
+std::string Autotune<T>::cpu_key()
+{
+  std::string model = "unknown";
+  std::ifstream file("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.rfind("model name", 0) == 0 && line.find(':') != std::string::npos)
+    {
+      model = line.substr(line.find(':') + 1);
+      model.erase(0, model.find_first_not_of(' '));
+      break;
+    }
+  }
+  return model + " x" + std::to_string(std::thread::hardware_concurrency());
+}
+
+template <typename T>
+std::string Autotune<T>::sanitise(std::string s)
+{
+  std::replace_if(s.begin(), s.end(), [](char c) { return std::isspace((unsigned char)c); }, '_');
+  return s.empty() ? "_" : s;
+}
+
+// allowed types
+template class Autotune<double>;
+template class Autotune<float>;
@@ -0,0 +1,108 @@
+/// @file Autotune.h
+/// @class Autotune
+/// @brief A class to select FFT lengths and FFTW thread counts by timing them on the host.
+/// @details Candidate FFT lengths are the minimum length (no padding) and the next 5-smooth, 7-smooth and power of 2 lengths.
+/// Decisions are cached in a profile file keyed by the CPU and a config key, so tuning only runs once per machine and config.
+/// @author 30hours
+
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include "data/meta/AlignedAllocator.h"
+#include "process/meta/Fftw.h"
+#include "process/meta/HammingNumber.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class Autotune
+{
+public:
+
+  using Complex = std::complex<T>;
+
+private:
+  /// @brief Path to the profile file.
+  std::string path;
+
+  /// @brief Profile key of the CPU and config.
+  std::string key;
+
+  /// @brief Number of timed executions per candidate, the fastest is kept.
+  uint32_t nRepeat;
+
+  /// @brief Number of FFTW threads to plan with, restored after each timing.
+  uint32_t nThreads;
+
+  /// @brief Decisions for this key by name.
+  std::map<std::string, uint32_t> choice;
+
+  /// @brief True if the decision was read from the profile file.
+  std::map<std::string, bool> isCached;
+
+  /// @brief Profile lines for other keys, kept on save.
+  std::vector<std::string> other;
+
+  /// @brief Time the fastest execution of an FFT.
+  /// @param n FFT length.
+  /// @param nThreads Number of FFTW threads to plan with.
+  /// @return Execution time (s).
+  double time_fft(uint32_t n, uint32_t nThreads);
+
+  /// @brief Replace whitespace so a string can be a profile field.
+  /// @param s String to sanitise.
+  /// @return Sanitised string.
+  static std::string sanitise(std::string s);
+
+public:
+  /// @brief Constructor.
+  /// @details Loads existing decisions for the CPU and config from the profile file, if any.
+  /// @param path Path to the profile file.
+  /// @param config Key of the config parameters that affect tuning.
+  /// @param nThreads Number of FFTW threads currently planned with.
+  /// @param nRepeat Number of timed executions per candidate.
+  /// @return The object.
+  Autotune(std::string path, std::string config, uint32_t nThreads = 1, uint32_t nRepeat = 3);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~Autotune();
+
+  /// @brief Select the fastest FFT length not smaller than nMin.
+  /// @details Timed with the current number of FFTW threads.
+  /// @param name Name of the decision.
+  /// @param nMin Minimum FFT length.
+  /// @return FFT length.
+  uint32_t fft_length(const std::string &name, uint32_t nMin);
+
+  /// @brief Select the fastest FFTW thread count for an FFT length.
+  /// @details Candidates are powers of 2 up to nMax. FFTW plans with the selected count afterwards.
+  /// @param name Name of the decision.
+  /// @param n FFT length.
+  /// @param nMax Maximum number of threads.
+  /// @return Number of threads.
+  uint32_t fft_threads(const std::string &name, uint32_t n, uint32_t nMax);
+
+  /// @brief Check if a decision was read from the profile file.
+  /// @param name Name of the decision.
+  /// @return True if cached.
+  bool is_cached(const std::string &name) const;
+
+  /// @brief Write decisions to the profile file.
+  /// @return True if successful.
+  bool save();
+
+  /// @brief Describe the decisions, one per line.
+  /// @return Report string.
+  std::string to_string() const;
+
+  /// @brief Get an identifier of the host CPU.
+  /// @return CPU model name and hardware thread count.
+  static std::string cpu_key();
+
+};
+
+#endif
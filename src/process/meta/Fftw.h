@@ -0,0 +1,103 @@
+/// @file Fftw.h
+/// @class Fftw
+/// @brief A traits class to select the FFTW library by precision.
+/// @details Maps double to the fftw library and float to the fftwf library, so processing classes can be templated on precision.
+/// Only the subset of the FFTW API used by blah2 is wrapped.
+/// @author 30hours
+
+#ifndef FFTW_H
+#define FFTW_H
+
+#include <fftw3.h>
+#include <complex>
+
+template <typename T>
+struct Fftw;
+
+template <>
+struct Fftw<double>
+{
+  /// @brief FFTW plan type.
+  using Plan = fftw_plan;
+
+  /// @brief Complex type matching the FFTW storage.
+  using Complex = std::complex<double>;
+
+  static Plan plan_dft_1d(int n, Complex *in, Complex *out, int sign, unsigned flags)
+  {
+    return fftw_plan_dft_1d(n, reinterpret_cast<fftw_complex *>(in),
+      reinterpret_cast<fftw_complex *>(out), sign, flags);
+  }
+
+  static void execute(const Plan plan)
+  {
+    fftw_execute(plan);
+  }
+
+  /// @brief Execute a plan on new arrays with the same alignment as planned.
+  static void execute_dft(const Plan plan, Complex *in, Complex *out)
+  {
+    fftw_execute_dft(plan, reinterpret_cast<fftw_complex *>(in),
+      reinterpret_cast<fftw_complex *>(out));
+  }
+
+  static void destroy_plan(Plan plan)
+  {
+    fftw_destroy_plan(plan);
+  }
+
+  static int init_threads()
+  {
+    return fftw_init_threads();
+  }
+
+  static void plan_with_nthreads(int nThreads)
+  {
+    fftw_plan_with_nthreads(nThreads);
+  }
+};
+
+template <>
+struct Fftw<float>
+{
+  /// @brief FFTW plan type.
+  using Plan = fftwf_plan;
+
+  /// @brief Complex type matching the FFTW storage.
+  using Complex = std::complex<float>;
+
+  static Plan plan_dft_1d(int n, Complex *in, Complex *out, int sign, unsigned flags)
+  {
+    return fftwf_plan_dft_1d(n, reinterpret_cast<fftwf_complex *>(in),
+      reinterpret_cast<fftwf_complex *>(out), sign, flags);
+  }
+
+  static void execute(const Plan plan)
+  {
+    fftwf_execute(plan);
+  }
+
+  /// @brief Execute a plan on new arrays with the same alignment as planned.
+  static void execute_dft(const Plan plan, Complex *in, Complex *out)
+  {
+    fftwf_execute_dft(plan, reinterpret_cast<fftwf_complex *>(in),
+      reinterpret_cast<fftwf_complex *>(out));
+  }
+
+  static void destroy_plan(Plan plan)
+  {
+    fftwf_destroy_plan(plan);
+  }
+
+  static int init_threads()
+  {
+    return fftwf_init_threads();
+  }
+
+  static void plan_with_nthreads(int nThreads)
+  {
+    fftwf_plan_with_nthreads(nThreads);
+  }
+};
+
+#endif
@@ -0,0 +1,21 @@
+/// @file GridKey.h
+/// @brief Key of a cell in a sparse delay/Doppler grid.
+/// @details Packs signed delay and Doppler cell indices into one hash key, so a grid can be stored in an unordered map.
+/// @author 30hours
+
+#ifndef GRIDKEY_H
+#define GRIDKEY_H
+
+#include <stdint.h>
+
+/// @brief Key of a grid cell from its delay and Doppler index.
+/// @details Shifted as unsigned, as indices are often negative. Unique for indices within the int32 range.
+/// @param i Delay index.
+/// @param j Doppler index.
+/// @return Key.
+inline uint64_t grid_key(int64_t i, int64_t j)
+{
+  return ((uint64_t)i << 32) ^ ((uint64_t)j & 0xffffffff);
+}
+
+#endif
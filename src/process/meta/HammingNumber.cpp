@@ -37,7 +37,26 @@ const HammingNumber &HammingNumber::operator++()
 
 uint32_t next_hamming(uint32_t value)
 {
+  return next_smooth(value, {2, 3, 5});
+}
+
+uint32_t prev_hamming(uint32_t value)
+{
+  uint32_t prev = 1;
   for (auto i : HammingNumber({2, 3, 5}))
+  {
+    if (i > value)
+    {
+      return prev;
+    }
+    prev = i;
+  }
+  return 0;
+}
+
+uint32_t next_smooth(uint32_t value, const std::vector<unsigned int> &pfs)
+{
+  for (auto i : HammingNumber(pfs))
   {
     if (i > value)
     {
@@ -31,4 +31,15 @@ class HammingNumber
 /// @return value rounded to Hamming number
 uint32_t next_hamming(uint32_t value);
 
+/// @brief  Calculate the largest 5-smooth Hamming Number not larger than value
+/// @param value Value to round
+/// @return value rounded down to Hamming number
+uint32_t prev_hamming(uint32_t value);
+
+/// @brief  Calculate the next number larger than value with only the given prime factors
+/// @param value Value to round
+/// @param pfs Prime factors, e.g. {2, 3, 5, 7} for 7-smooth numbers
+/// @return value rounded to smooth number
+uint32_t next_smooth(uint32_t value, const std::vector<unsigned int> &pfs);
+
 #endif
\ No newline at end of file
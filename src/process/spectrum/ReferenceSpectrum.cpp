@@ -0,0 +1,45 @@
+#include "ReferenceSpectrum.h"
+#include <complex>
+#include <algorithm>
+
+// constructor
+template <typename T>
+ReferenceSpectrum<T>::ReferenceSpectrum(uint32_t _n)
+{
+  n = _n;
+  dataX.resize(n);
+  dataRaw.resize(n);
+
+  // compute FFTW plan in constructor
+  fftX = Fftw<T>::plan_dft_1d(n, dataX.data(), dataX.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+}
+
+template <typename T>
+ReferenceSpectrum<T>::~ReferenceSpectrum()
+{
+  Fftw<T>::destroy_plan(fftX);
+}
+
+template <typename T>
+void ReferenceSpectrum<T>::process(IqData *x)
+{
+  x->copy(dataRaw.data(), n);
+  std::copy(dataRaw.begin(), dataRaw.end(), dataX.begin());
+  Fftw<T>::execute(fftX);
+}
+
+template <typename T>
+const std::complex<T> *ReferenceSpectrum<T>::get_spectrum() const
+{
+  return dataX.data();
+}
+
+template <typename T>
+uint32_t ReferenceSpectrum<T>::get_n() const
+{
+  return n;
+}
+
+// allowed types
+template class ReferenceSpectrum<double>;
+template class ReferenceSpectrum<float>;
@@ -0,0 +1,63 @@
+/// @file ReferenceSpectrum.h
+/// @class ReferenceSpectrum
+/// @brief A class to cache the full-length spectrum of the reference signal.
+/// @details Computes one forward FFT of the reference per CPI, so stages needing the spectrum of the full CPI can share it.
+/// A circular time shift of the reference is a phase ramp on this spectrum.
+/// @author 30hours
+
+#ifndef REFERENCESPECTRUM_H
+#define REFERENCESPECTRUM_H
+
+#include "data/IqData.h"
+#include "data/meta/AlignedAllocator.h"
+#include "process/meta/Fftw.h"
+#include <stdint.h>
+#include <vector>
+
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
+class ReferenceSpectrum
+{
+public:
+
+  using Complex = std::complex<T>;
+
+private:
+  /// @brief Number of samples per CPI.
+  uint32_t n;
+
+  /// @brief FFTW plan for the reference spectrum.
+  typename Fftw<T>::Plan fftX;
+
+  /// @brief FFTW storage for the reference spectrum.
+  std::vector<Complex, AlignedAllocator<Complex>> dataX;
+
+  /// @brief Staging buffer for samples copied from IqData.
+  std::vector<std::complex<double>, AlignedAllocator<std::complex<double>>> dataRaw;
+
+public:
+  /// @brief Constructor.
+  /// @param n Number of samples per CPI.
+  /// @return The object.
+  ReferenceSpectrum(uint32_t n);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~ReferenceSpectrum();
+
+  /// @brief Compute the spectrum of the reference for this CPI.
+  /// @details Samples are copied from the input, which is left unchanged.
+  /// @param x Reference samples.
+  /// @return Void.
+  void process(IqData *x);
+
+  /// @brief Get the spectrum of the last processed CPI.
+  /// @return Pointer to n spectrum bins, unnormalised.
+  const Complex *get_spectrum() const;
+
+  /// @brief Get the FFT length.
+  /// @return Number of samples per CPI.
+  uint32_t get_n() const;
+};
+
+#endif
@@ -4,9 +4,11 @@
 #include <deque>
 #include <vector>
 #include <math.h>
+#include <algorithm>
 
 // constructor
-SpectrumAnalyser::SpectrumAnalyser(uint32_t _n, double _bandwidth)
+template <typename T>
+SpectrumAnalyser<T>::SpectrumAnalyser(uint32_t _n, double _bandwidth)
 {
   // input
   n = _n;
@@ -18,32 +20,40 @@ SpectrumAnalyser::SpectrumAnalyser(uint32_t _n, double _bandwidth)
   nfft = nSpectrum*decimation;
 
   // compute FFTW plans in constructor
-  dataX = new std::complex<double>[nfft];
-  fftX = fftw_plan_dft_1d(nfft, reinterpret_cast<fftw_complex *>(dataX),
-                           reinterpret_cast<fftw_complex *>(dataX), FFTW_FORWARD, FFTW_ESTIMATE);
+  dataX = new Complex[nfft];
+  fftX = Fftw<T>::plan_dft_1d(nfft, dataX, dataX, FFTW_FORWARD, FFTW_ESTIMATE);
 }
 
-SpectrumAnalyser::~SpectrumAnalyser()
+template <typename T>
+SpectrumAnalyser<T>::~SpectrumAnalyser()
 {
-  fftw_destroy_plan(fftX);
+  Fftw<T>::destroy_plan(fftX);
 }
 
-void SpectrumAnalyser::process(IqData *x)
+template <typename T>
+void SpectrumAnalyser<T>::process(IqData *x, const ReferenceSpectrum<T> *reference)
 {  
-  // load data and FFT
+  // load data and FFT, or reuse the cached spectrum
   uint32_t i;
-  std::deque<std::complex<double>> data = x->get_data();
-  for (i = 0; i < nfft; i++)
+  if (reference != nullptr && reference->get_n() == nfft)
+  {
+    std::copy(reference->get_spectrum(), reference->get_spectrum() + nfft, dataX);
+  }
+  else
   {
-    dataX[i] = data[i];
+    std::deque<std::complex<double>> data = x->get_data();
+    for (i = 0; i < nfft; i++)
+    {
+      dataX[i] = Complex(data[i]);
+    }
+    Fftw<T>::execute(fftX);
   }
-  fftw_execute(fftX);
 
   // fftshift
   std::vector<std::complex<double>> fftshift;
   for (i = 0; i < nfft; i++)
   {
-    fftshift.push_back(dataX[(i + int(nfft / 2) + 1) % nfft]);
+    fftshift.push_back(std::complex<double>(dataX[(i + int(nfft / 2) + 1) % nfft]));
   }
   
   // decimate
@@ -69,3 +79,7 @@ void SpectrumAnalyser::process(IqData *x)
 
   return;
 }
+
+// allowed types
+template class SpectrumAnalyser<double>;
+template class SpectrumAnalyser<float>;
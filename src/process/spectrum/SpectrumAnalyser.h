@@ -10,11 +10,18 @@
 #define SPECTRUMANALYSER_H
 
 #include "data/IqData.h"
+#include "process/meta/Fftw.h"
+#include "ReferenceSpectrum.h"
 #include <stdint.h>
-#include <fftw3.h>
 
+/// @tparam T Processing precision (float or double).
+template <typename T = double>
 class SpectrumAnalyser
 {
+public:
+
+  using Complex = std::complex<T>;
+
 private:
   /// @brief Number of samples on input.
   uint32_t n;
@@ -26,10 +33,10 @@ private:
   uint32_t decimation;
 
   /// @brief FFTW plans for ambiguity processing.
-  fftw_plan fftX;
+  typename Fftw<T>::Plan fftX;
 
   /// @brief FFTW storage for ambiguity processing.
-  std::complex<double> *dataX;
+  Complex *dataX;
 
   /// @brief Number of samples to perform FFT.
   uint32_t nfft;
@@ -53,8 +60,9 @@ public:
 
   /// @brief Process spectrum data.
   /// @param x Reference samples.
+  /// @param reference Cached reference spectrum of this CPI, used if the FFT length matches.
   /// @return Void.
-  void process(IqData *x);
+  void process(IqData *x, const ReferenceSpectrum<T> *reference = nullptr);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "Assignment.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+// constructor
+Assignment::Assignment()
+{
+  nRows = 0;
+  nCols = 0;
+}
+
+Assignment::~Assignment()
+{
+}
+
+void Assignment::reset(uint32_t _nRows, uint32_t _nCols)
+{
+  nRows = _nRows;
+  nCols = _nCols;
+  pair.clear();
+  pairCost.clear();
+}
+
+void Assignment::add(uint32_t row, uint32_t _col, double _cost)
+{
+  pair.push_back({row, _col});
+  pairCost.push_back(_cost);
+}
+
+size_t Assignment::get_nPairs() const
+{
+  return pair.size();
+}
+
+void Assignment::relax(uint32_t i, double costMiss, double minVal)
+{
+  auto update = [&](uint32_t j, double c)
+  {
+    if (isScanned[j])
+    {
+      return;
+    }
+    double r = minVal + c - u[i] - v[j];
+    if (r < pathCost[j])
+    {
+      if (pathCost[j] == std::numeric_limits<double>::infinity())
+      {
+        reachedCol.push_back(j);
+      }
+      pathCost[j] = r;
+      pathRow[j] = i;
+      heap.push_back({r, j});
+      std::push_heap(heap.begin(), heap.end(), std::greater<>());
+    }
+  };
+
+  for (uint32_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+  {
+    update(col[k], cost[k]);
+  }
+  // column for the row to be unassigned
+  update(nCols + i, costMiss);
+}
+
+double Assignment::solve(double costMiss, std::vector<int32_t> &col4row)
+{
+  uint32_t nTotal = nCols + nRows;
+
+  // group pairs by row
+  rowStart.assign(nRows + 1, 0);
+  for (const auto &p : pair)
+  {
+    rowStart[p.first + 1]++;
+  }
+  for (uint32_t i = 0; i < nRows; i++)
+  {
+    rowStart[i + 1] += rowStart[i];
+  }
+  col.resize(pair.size());
+  cost.resize(pair.size());
+  scannedRow.assign(rowStart.begin(), rowStart.end() - 1);
+  for (size_t k = 0; k < pair.size(); k++)
+  {
+    uint32_t index = scannedRow[pair[k].first]++;
+    col[index] = pair[k].second;
+    cost[index] = pairCost[k];
+  }
+
+  // init
+  u.assign(nRows, 0);
+  v.assign(nTotal, 0);
+  row4col.assign(nTotal, -1);
+  col4row.assign(nRows, -1);
+  pathCost.assign(nTotal, std::numeric_limits<double>::infinity());
+  pathRow.resize(nTotal);
+  isScanned.assign(nTotal, false);
+
+  // augment from each row in turn
+  for (uint32_t curRow = 0; curRow < nRows; curRow++)
+  {
+    scannedRow.clear();
+    scannedCol.clear();
+    reachedCol.clear();
+    heap.clear();
+
+    // shortest path to a free column, always found as the row's own column is free
+    double minVal = 0;
+    uint32_t i = curRow;
+    uint32_t sink;
+    while (true)
+    {
+      scannedRow.push_back(i);
+      relax(i, costMiss, minVal);
+      uint32_t j;
+      double r;
+      do
+      {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        r = heap.back().first;
+        j = heap.back().second;
+        heap.pop_back();
+      } while (isScanned[j] || r > pathCost[j]);
+      minVal = r;
+      isScanned[j] = true;
+      scannedCol.push_back(j);
+      if (row4col[j] == -1)
+      {
+        sink = j;
+        break;
+      }
+      i = row4col[j];
+    }
+
+    // update dual variables to keep reduced costs non-negative
+    u[curRow] += minVal;
+    for (size_t k = 1; k < scannedRow.size(); k++)
+    {
+      u[scannedRow[k]] += minVal - pathCost[col4row[scannedRow[k]]];
+    }
+    for (uint32_t j : scannedCol)
+    {
+      v[j] -= minVal - pathCost[j];
+    }
+
+    // augment along the path
+    int32_t j = sink;
+    while (true)
+    {
+      i = pathRow[j];
+      row4col[j] = i;
+      std::swap(j, col4row[i]);
+      if (i == curRow)
+      {
+        break;
+      }
+    }
+
+    // clear search state
+    for (uint32_t k : reachedCol)
+    {
+      pathCost[k] = std::numeric_limits<double>::infinity();
+      isScanned[k] = false;
+    }
+  }
+
+  // total cost, and mark rows on their own column as unassigned
+  double total = 0;
+  for (uint32_t i = 0; i < nRows; i++)
+  {
+    if (col4row[i] >= (int32_t)nCols)
+    {
+      col4row[i] = -1;
+      total += costMiss;
+      continue;
+    }
+    double best = std::numeric_limits<double>::infinity();
+    for (uint32_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+    {
+      if (col[k] == (uint32_t)col4row[i])
+      {
+        best = std::min(best, cost[k]);
+      }
+    }
+    total += best;
+  }
+  return total;
+}
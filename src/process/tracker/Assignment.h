@@ -0,0 +1,105 @@
+/// @file Assignment.h
+/// @class Assignment
+/// @brief A class to solve a sparse rectangular assignment problem.
+/// @details Finds the minimum cost assignment of rows to columns over a sparse set of allowed pairs, where a row may instead be left unassigned at a fixed cost.
+/// Solved by the shortest augmenting path form of the <a href="https://en.wikipedia.org/wiki/Hungarian_algorithm">Hungarian algorithm</a> (Jonker-Volgenant), with Dijkstra over the allowed pairs only.
+/// Each row has a private column for the unassigned cost, so a solution always exists and a row only searches the pairs connected to it.
+/// Storage is kept between solves.
+/// @author 30hours
+
+#ifndef ASSIGNMENT_H
+#define ASSIGNMENT_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+class Assignment
+{
+private:
+  /// @brief Number of rows.
+  uint32_t nRows;
+
+  /// @brief Number of columns, excluding the unassigned columns.
+  uint32_t nCols;
+
+  /// @brief Allowed pairs as (row, column) and cost, in order added.
+  /// @{
+  std::vector<std::pair<uint32_t, uint32_t>> pair;
+  std::vector<double> pairCost;
+  /// @}
+
+  /// @brief Allowed pairs grouped by row, the pairs of row i in [rowStart[i], rowStart[i+1]).
+  /// @{
+  std::vector<uint32_t> rowStart;
+  std::vector<uint32_t> col;
+  std::vector<double> cost;
+  /// @}
+
+  /// @brief Dual variables of rows and columns.
+  /// @{
+  std::vector<double> u, v;
+  /// @}
+
+  /// @brief Row assigned to each column, -1 if free.
+  std::vector<int32_t> row4col;
+
+  /// @brief Shortest path cost to each column, infinite if not reached.
+  std::vector<double> pathCost;
+
+  /// @brief Previous row on the shortest path to each column.
+  std::vector<uint32_t> pathRow;
+
+  /// @brief True if the shortest path to the column is final.
+  std::vector<bool> isScanned;
+
+  /// @brief Rows and columns reached by the current search.
+  /// @{
+  std::vector<uint32_t> scannedRow, scannedCol, reachedCol;
+  /// @}
+
+  /// @brief Min-heap of (path cost, column) for the search.
+  std::vector<std::pair<double, uint32_t>> heap;
+
+  /// @brief Relax the pairs of a row in the search.
+  /// @param i Row index.
+  /// @param costMiss Cost of leaving the row unassigned.
+  /// @param minVal Path cost to the row.
+  /// @return Void.
+  void relax(uint32_t i, double costMiss, double minVal);
+
+public:
+  /// @brief Constructor.
+  /// @return The object.
+  Assignment();
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~Assignment();
+
+  /// @brief Start a new problem, removing all pairs.
+  /// @param nRows Number of rows.
+  /// @param nCols Number of columns.
+  /// @return Void.
+  void reset(uint32_t nRows, uint32_t nCols);
+
+  /// @brief Allow a row to be assigned to a column.
+  /// @param row Row index.
+  /// @param col Column index.
+  /// @param cost Cost of the assignment.
+  /// @return Void.
+  void add(uint32_t row, uint32_t col, double cost);
+
+  /// @brief Get number of allowed pairs.
+  /// @return Number of allowed pairs.
+  size_t get_nPairs() const;
+
+  /// @brief Solve for the minimum total cost assignment.
+  /// @param costMiss Cost of leaving a row unassigned.
+  /// @param col4row Column assigned to each row, -1 if unassigned.
+  /// @return Total cost including unassigned rows.
+  double solve(double costMiss, std::vector<int32_t> &col4row);
+};
+
+#endif
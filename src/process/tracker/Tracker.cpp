@@ -1,5 +1,9 @@
 #include "Tracker.h"
+#include "process/meta/GridKey.h"
 #include <iostream>
+#include <cmath>
+
+const double Tracker::GATE_DELAY = 1;
 
 // constructor
 Tracker::Tracker(uint32_t _m, uint32_t _n, uint32_t _nDelete, 
@@ -51,53 +55,82 @@ std::unique_ptr<Track> Tracker::process(Detection *detection, uint64_t currentTi
 
 void Tracker::update(Detection *detection, uint64_t current)
 {
-  std::vector<double> delay = detection->get_delay();
-  std::vector<double> doppler = detection->get_doppler();
-  std::vector<double> snr = detection->get_snr();
-
-  // init
-  double delayPredict = 0.0;
-  double dopplerPredict = 0.0;
-  double acc = 0.0;
-  uint32_t nRemove = 0;
+  const std::vector<double> &delay = detection->get_delay();
+  const std::vector<double> &doppler = detection->get_doppler();
+  size_t nDetections = detection->get_nDetections();
+  uint64_t nTracks = track.get_n();
   std::string state;
 
   // get time between detections
   double T = ((double)(current - timestamp))/1000;
   timestamp = current;
 
-  // loop over each track
-  for (uint64_t i = 0; i < track.get_n(); i++)
+  // bucket detections into a grid of the gate size
+  double gateDoppler = 1/cpi;
+  grid.clear();
+  for (size_t j = 0; j < nDetections; j++)
+  {
+    grid[grid_key((int64_t)std::floor(delay[j] / GATE_DELAY), 
+      (int64_t)std::floor(doppler[j] / gateDoppler))].push_back(j);
+  }
+
+  // gate detections around the predicted position of each track
+  prediction.resize(nTracks);
+  assignment.reset(nTracks, nDetections);
+  for (uint64_t i = 0; i < nTracks; i++)
   {
-    // predict next position
-    Detection detectionCurrent = track.get_current(i);
-    acc = track.get_acceleration(i);
-    Detection prediction = predict(detectionCurrent, acc, T);
-    
-    // loop over detections to associate
-    for (size_t j = 0; j < detection->get_nDetections(); j++)
+    prediction[i] = predict(track.get_current(i), track.get_acceleration(i), T);
+    int64_t delayBucket0 = (int64_t)std::floor((prediction[i].delay - GATE_DELAY) / GATE_DELAY);
+    int64_t delayBucket1 = (int64_t)std::floor((prediction[i].delay + GATE_DELAY) / GATE_DELAY);
+    int64_t dopplerBucket0 = (int64_t)std::floor((prediction[i].doppler - gateDoppler) / gateDoppler);
+    int64_t dopplerBucket1 = (int64_t)std::floor((prediction[i].doppler + gateDoppler) / gateDoppler);
+    for (int64_t p = delayBucket0; p <= delayBucket1; p++)
     {
-      // associate detections
-      if (delay[j] > delayPredict-1 &&
-        delay[j] < delayPredict+1 &&
-        doppler[j] > dopplerPredict-1*(1/cpi) &&
-        doppler[j] < dopplerPredict+1*(1/cpi))
+      for (int64_t q = dopplerBucket0; q <= dopplerBucket1; q++)
       {
-        Detection associated(delay[j], doppler[j], snr[j]);
-        track.set_current(i, associated);
-        track.set_acceleration(i, (doppler[j]-detectionCurrent.get_doppler().front())/T);
-        track.set_nInactive(i, 0);
-        doNotInitiate[j] = true;
-        state = "ASSOCIATED";
-        track.set_state(i, state);
-        // promote track if passes threshold
-        track.promote(i, m, n);
-        break;
+        auto bucket = grid.find(grid_key(p, q));
+        if (bucket == grid.end())
+        {
+          continue;
+        }
+        for (uint32_t j : bucket->second)
+        {
+          // normalised distance, gated inside the ellipse
+          double dDelay = (delay[j] - prediction[i].delay) / GATE_DELAY;
+          double dDoppler = (doppler[j] - prediction[i].doppler) / gateDoppler;
+          double distance = dDelay*dDelay + dDoppler*dDoppler;
+          if (distance < 1)
+          {
+            assignment.add(i, j, distance);
+          }
+        }
       }
     }
+  }
+
+  // global nearest neighbour, a track left unassigned costs the gate
+  assignment.solve(1, col4row);
+
+  for (uint64_t i = 0; i < nTracks; i++)
+  {
+    int32_t j = col4row[i];
+    if (j >= 0)
+    {
+      // associate detection
+      double dopplerTrack = track.get_current(i).doppler;
+      track.set_current(i, detection->get_plot(j));
+      track.set_acceleration(i, (doppler[j]-dopplerTrack)/T);
+      track.set_nInactive(i, 0);
+      doNotInitiate[j] = true;
+      state = "ASSOCIATED";
+      track.set_state(i, state);
+      // promote track if passes threshold
+      track.promote(i, m, n);
+      continue;
+    }
 
     // update state if no detections associated
-    track.set_current(i, prediction);
+    track.set_current(i, prediction[i]);
     if (track.get_state(i) == "ACTIVE")
     {
       state = "COASTING";
@@ -113,32 +146,30 @@ void Tracker::update(Detection *detection, uint64_t current)
       track.set_state(i, track.get_state(i));
     }
     track.set_nInactive(i, track.get_nInactive(i)+1);
+  }
 
-    // remove if tentative or coasting too long
+  // remove if tentative or coasting too long
+  for (uint64_t i = nTracks; i-- > 0;)
+  {
     if (track.get_nInactive(i) > nDelete)
     {
-      track.remove(i-nRemove);
-      nRemove++;
+      track.remove(i);
     }
   }
 }
 
-Detection Tracker::predict(Detection current, double acc, double T)
+Plot Tracker::predict(const Plot &current, double acc, double T)
 {
-  double delayTrack = current.get_delay().front();
-  double dopplerTrack = current.get_doppler().front();
+  double delayTrack = current.delay;
+  double dopplerTrack = current.doppler;
   double delayPredict = delayTrack+((dopplerTrack*T*lambda)+
     (0.5*acc*T*T))/rangeRes;
   double dopplerPredict = dopplerTrack+(acc*T);
-  Detection prediction(delayPredict, dopplerPredict, 0);
-  return prediction;
+  return {delayPredict, dopplerPredict, 0};
 }
 
 void Tracker::initiate(Detection *detection)
 {  
-  std::vector<double> delay = detection->get_delay();
-  std::vector<double> doppler = detection->get_doppler();
-  std::vector<double> snr = detection->get_snr();
   uint64_t index;
 
   // loop over new detections
@@ -150,10 +181,10 @@ void Tracker::initiate(Detection *detection)
       continue;
     }
     // add tentative detection for each acc
+    Plot plot = detection->get_plot(i);
     for (size_t j = 0; j < accInit.size(); j++)
     {
-      Detection detectionCurrent(delay[i], doppler[i], snr[i]);
-      index = track.add(detectionCurrent);
+      index = track.add(plot);
       track.set_acceleration(index, accInit[j]);
     }
   }
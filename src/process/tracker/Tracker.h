@@ -3,6 +3,7 @@
 /// @brief A class to implement a bistatic tracker.
 /// @details Key functions are update, initiate, smooth and remove.
 /// @details Update before initiate to avoid duplicate tracks.
+/// @details Detections are gated around the predicted position of each track through a grid of the gate size, and assigned by global nearest neighbour over the gated pairs.
 /// @author 30hours
 /// @todo Add smoothing capability.
 /// @todo Fix units up.
@@ -13,9 +14,13 @@
 
 #include "data/Detection.h"
 #include "data/Track.h"
+#include "data/Plot.h"
+#include "process/tracker/Assignment.h"
 
 #include <stdint.h>
 #include <memory>
+#include <vector>
+#include <unordered_map>
 
 class Tracker
 {
@@ -53,6 +58,22 @@ private:
   /// @brief Track data.
   Track track;
 
+  /// @brief Gate half-width in delay (bins).
+  /// @details The Doppler half-width is one Doppler bin (1/cpi Hz).
+  static const double GATE_DELAY;
+
+  /// @brief Detections bucketed into a grid of the gate size.
+  std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+
+  /// @brief Predicted position of each track.
+  std::vector<Plot> prediction;
+
+  /// @brief Gated pairs of tracks and detections to assign.
+  Assignment assignment;
+
+  /// @brief Detection assigned to each track, -1 if unassigned.
+  std::vector<int32_t> col4row;
+
 public:
   /// @brief Constructor.
   /// @param m Track initiation constant for M of N detections.
@@ -87,7 +108,7 @@ public:
   /// @param acc Acceleration hypothesis of track.
   /// @param T Time elapsed from previous CPI.
   /// @return Predicted position of track.
-  Detection predict(Detection current, double acc, double T);
+  Plot predict(const Plot &current, double acc, double T);
 
   /// @brief Initiate new tentative tracks from detections.
   /// @param detection Detection data for last CPI.
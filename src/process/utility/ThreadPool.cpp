@@ -0,0 +1,97 @@
+#include "ThreadPool.h"
+
+// constructor
+ThreadPool::ThreadPool(uint32_t _nThreads)
+{
+  nThreads = _nThreads < 1 ? 1 : _nThreads;
+  nJob = 0;
+  generation = 0;
+  nRemaining = 0;
+  stop = false;
+  for (uint32_t i = 1; i < nThreads; i++)
+  {
+    workers.emplace_back(&ThreadPool::worker, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cvStart.notify_all();
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+}
+
+void ThreadPool::worker(uint32_t index)
+{
+  uint64_t seen = 0;
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvStart.wait(lock, [&]{ return stop || generation != seen; });
+    if (stop)
+    {
+      return;
+    }
+    seen = generation;
+    uint32_t n = nJob;
+    lock.unlock();
+
+    // run chunk for this thread
+    uint32_t start = (uint64_t)n * index / nThreads;
+    uint32_t end = (uint64_t)n * (index + 1) / nThreads;
+    if (start < end)
+    {
+      job(start, end, index);
+    }
+
+    lock.lock();
+    if (--nRemaining == 0)
+    {
+      cvDone.notify_one();
+    }
+  }
+}
+
+void ThreadPool::parallel_for(uint32_t n, 
+  const std::function<void(uint32_t, uint32_t, uint32_t)> &fn)
+{
+  // run inline if no workers
+  if (nThreads == 1 || n < 2)
+  {
+    if (n > 0)
+    {
+      fn(0, n, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = fn;
+    nJob = n;
+    nRemaining = nThreads - 1;
+    generation++;
+  }
+  cvStart.notify_all();
+
+  // calling thread runs the first chunk
+  uint32_t end = (uint64_t)n / nThreads;
+  if (end > 0)
+  {
+    fn(0, end, 0);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  cvDone.wait(lock, [&]{ return nRemaining == 0; });
+}
+
+uint32_t ThreadPool::get_n_threads() const
+{
+  return nThreads;
+}
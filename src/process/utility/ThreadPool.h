@@ -0,0 +1,77 @@
+/// @file ThreadPool.h
+/// @class ThreadPool
+/// @brief A class to implement a fixed pool of worker threads.
+/// @details Splits a loop into contiguous chunks, one per thread. The calling thread runs the first chunk and blocks until all chunks are done.
+/// The thread index passed to the loop body can be used to select per-thread buffers.
+/// @author 30hours
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stdint.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class ThreadPool
+{
+private:
+  /// @brief Number of threads including the calling thread.
+  uint32_t nThreads;
+
+  /// @brief Worker threads.
+  std::vector<std::thread> workers;
+
+  /// @brief Mutex for job state.
+  std::mutex mutex;
+
+  /// @brief Signal workers a new job is available.
+  std::condition_variable cvStart;
+
+  /// @brief Signal caller all chunks are complete.
+  std::condition_variable cvDone;
+
+  /// @brief Current loop body.
+  std::function<void(uint32_t, uint32_t, uint32_t)> job;
+
+  /// @brief Current loop length.
+  uint32_t nJob;
+
+  /// @brief Incremented for each new job.
+  uint64_t generation;
+
+  /// @brief Number of worker chunks still running.
+  uint32_t nRemaining;
+
+  /// @brief True if workers should exit.
+  bool stop;
+
+  /// @brief Worker thread loop.
+  /// @param index Thread index (1 to nThreads-1).
+  /// @return Void.
+  void worker(uint32_t index);
+
+public:
+  /// @brief Constructor.
+  /// @param nThreads Number of threads including the calling thread.
+  /// @return The object.
+  ThreadPool(uint32_t nThreads);
+
+  /// @brief Destructor.
+  /// @return Void.
+  ~ThreadPool();
+
+  /// @brief Run a loop across the pool.
+  /// @param n Number of loop iterations.
+  /// @param fn Loop body taking (start, end, thread index) for the range [start, end).
+  /// @return Void.
+  void parallel_for(uint32_t n, const std::function<void(uint32_t, uint32_t, uint32_t)> &fn);
+
+  /// @brief Get the number of threads.
+  /// @return Number of threads including the calling thread.
+  uint32_t get_n_threads() const;
+};
+
+#endif
@@ -0,0 +1,152 @@
+/// @file TestAmbiguityAlgorithm.cpp
+/// @brief Comparison test for ambiguity processing algorithms.
+/// @details Times the batches and direct engines at several CPI lengths, and measures integration loss of a simulated target at 0 Doppler and near the Doppler window edge.
+/// Loss is relative to the coherent gain of the full CPI.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+#include "process/ambiguity/AmbiguityDirect.h"
+
+#include <random>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <complex>
+#include <cmath>
+#include <memory>
+#include <iostream>
+
+/// @brief Number of CPIs to average over.
+const uint32_t N_RUNS = 3;
+
+/// @brief Simulated target delay (samples).
+const uint32_t DELAY = 50;
+
+/// @brief Simulated target amplitude relative to the reference.
+const double AMPLITUDE = 0.05;
+
+/// @brief Fill reference and surveillance with a delayed, Doppler shifted echo.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @param doppler Target Doppler (Hz).
+/// @param fs Sampling frequency (Hz).
+/// @param gen Random number generator.
+/// @return Reference samples.
+std::vector<std::complex<double>> simulate_target(IqData& x, IqData& y,
+  double doppler, uint32_t fs, std::mt19937& gen)
+{
+  std::normal_distribution<> dist(0.0, 100.0);
+  std::vector<std::complex<double>> ref(x.get_n());
+  for (uint32_t i = 0; i < x.get_n(); i++)
+  {
+    ref[i] = {dist(gen), dist(gen)};
+    x.push_back(ref[i]);
+  }
+  for (uint32_t i = 0; i < y.get_n(); i++)
+  {
+    std::complex<double> echo = (i >= DELAY) ? ref[i-DELAY] : 0;
+    echo *= AMPLITUDE * std::exp(std::complex<double>(0, 2 * M_PI * doppler * i / fs));
+    y.push_back(echo + 0.1 * std::complex<double>(dist(gen), dist(gen)));
+  }
+  return ref;
+}
+
+/// @brief Measure integration loss of a target.
+/// @param ambiguity Ambiguity engine.
+/// @param doppler Target Doppler (Hz).
+/// @param fs Sampling frequency (Hz).
+/// @param nSamples Number of samples.
+/// @return Loss of the peak cell relative to full coherent gain (dB).
+template <typename T>
+double integration_loss(AmbiguityEngine<T> *ambiguity, double doppler,
+  uint32_t fs, uint32_t nSamples)
+{
+  IqData x{nSamples};
+  IqData y{nSamples};
+  std::mt19937 gen(0);
+  std::vector<std::complex<double>> ref = simulate_target(x, y, doppler, fs, gen);
+
+  // ideal gain over the samples used by the engine
+  double energy = 0;
+  for (uint32_t i = 0; i + DELAY < ambiguity->get_n_samples(); i++)
+  {
+    energy += std::norm(ref[i]);
+  }
+
+  Map<std::complex<T>> *map = ambiguity->process(&x, &y);
+  double peak = 0;
+  for (auto cell : map->data)
+  {
+    peak = std::max(peak, (double)std::abs(cell));
+  }
+  return 20 * std::log10(AMPLITUDE * energy / peak);
+}
+
+/// @brief Time ambiguity processing.
+/// @param ambiguity Ambiguity engine.
+/// @param nSamples Number of samples.
+/// @return Mean time per CPI (ms).
+template <typename T>
+double time_ambiguity(AmbiguityEngine<T> *ambiguity, uint32_t nSamples)
+{
+  IqData x{nSamples};
+  IqData y{nSamples};
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<> dist(-100.0, 100.0);
+
+  double total = 0;
+  for (uint32_t i = 0; i < N_RUNS; i++)
+  {
+    for (uint32_t j = 0; j < nSamples; j++)
+    {
+      x.push_back({dist(gen), dist(gen)});
+      y.push_back({dist(gen), dist(gen)});
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    ambiguity->process(&x, &y);
+    auto t1 = std::chrono::steady_clock::now();
+    total += std::chrono::duration<double, std::milli>(t1 - t0).count();
+  }
+  return total / N_RUNS;
+}
+
+/// @brief Compare cost and integration loss of each algorithm over CPI length.
+TEST_CASE("Ambiguity_Algorithm", "[algorithm]")
+{
+  int32_t delayMin{-10};
+  int32_t delayMax{400};
+  int32_t dopplerMin{-200};
+  int32_t dopplerMax{200};
+  uint32_t fs{2'000'000};
+  double dopplerEdge = 0.95 * dopplerMax;
+
+  std::cout << "cpi (s), algorithm, time (ms), loss 0 Hz (dB), loss "
+    << dopplerEdge << " Hz (dB)" << std::endl;
+  for (double tCpi : {0.1, 0.25, 0.5})
+  {
+    uint32_t nSamples = tCpi * fs;
+    std::vector<std::pair<std::string, std::unique_ptr<AmbiguityEngine<double>>>> engines;
+    engines.emplace_back("batches", std::make_unique<Ambiguity<double>>(
+      delayMin, delayMax, dopplerMin, dopplerMax, fs, nSamples, true));
+    for (uint32_t oversample : {1, 2, 4, 8})
+    {
+      engines.emplace_back("direct x" + std::to_string(oversample),
+        std::make_unique<AmbiguityDirect<double>>(delayMin, delayMax,
+        dopplerMin, dopplerMax, fs, nSamples, oversample, true));
+    }
+    engines.emplace_back("direct fft", std::make_unique<AmbiguityDirect<double>>(
+      delayMin, delayMax, dopplerMin, dopplerMax, fs, nSamples, nSamples));
+
+    for (auto &engine : engines)
+    {
+      double time = time_ambiguity(engine.second.get(), nSamples);
+      double loss0 = integration_loss(engine.second.get(), 0, fs, nSamples);
+      double lossEdge = integration_loss(engine.second.get(), dopplerEdge, fs, nSamples);
+      std::cout << tCpi << ", " << engine.first << ", " << time << ", "
+        << loss0 << ", " << lossEdge << std::endl;
+      CHECK(time > 0);
+    }
+  }
+}
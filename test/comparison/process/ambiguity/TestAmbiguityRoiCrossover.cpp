@@ -0,0 +1,99 @@
+/// @file TestAmbiguityRoiCrossover.cpp
+/// @brief Comparison test for region of interest ambiguity processing.
+/// @details Times the pruned FFT and direct methods of AmbiguityRoi against the full batches map over ROI size, to find the crossover.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+#include "process/ambiguity/AmbiguityRoi.h"
+
+#include <random>
+#include <chrono>
+#include <iostream>
+
+/// @brief Number of CPIs to average over.
+const uint32_t N_RUNS = 3;
+
+/// @brief Full window of the ambiguity map.
+/// @{
+const int32_t DELAY_MIN = -10;
+const int32_t DELAY_MAX = 400;
+const int32_t DOPPLER_MIN = -200;
+const int32_t DOPPLER_MAX = 200;
+const uint32_t FS = 2'000'000;
+const uint32_t N_SAMPLES = 0.5 * FS;
+/// @}
+
+/// @brief Time ambiguity processing.
+/// @param ambiguity Ambiguity engine.
+/// @return Mean time per CPI (ms).
+template <typename T>
+double time_ambiguity(AmbiguityEngine<T> *ambiguity)
+{
+  IqData x{N_SAMPLES};
+  IqData y{N_SAMPLES};
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<> dist(-100.0, 100.0);
+
+  double total = 0;
+  for (uint32_t i = 0; i < N_RUNS; i++)
+  {
+    for (uint32_t j = 0; j < N_SAMPLES; j++)
+    {
+      x.push_back({dist(gen), dist(gen)});
+      y.push_back({dist(gen), dist(gen)});
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    ambiguity->process(&x, &y);
+    auto t1 = std::chrono::steady_clock::now();
+    total += std::chrono::duration<double, std::milli>(t1 - t0).count();
+  }
+  return total / N_RUNS;
+}
+
+/// @brief Time each ROI method for a ROI size.
+/// @param nDelay Number of ROI delay bins.
+/// @param dopplerSpan ROI Doppler span (Hz).
+/// @param tFull Time of the full map (ms).
+/// @return Void.
+void compare_roi(int32_t nDelay, double dopplerSpan, double tFull)
+{
+  using Roi = AmbiguityRoi<double>;
+  int32_t delayMax = DELAY_MIN + nDelay - 1;
+  double dopplerMin = -dopplerSpan / 2;
+  double dopplerMax = dopplerSpan / 2;
+
+  Roi fft(DELAY_MIN, DELAY_MAX, DOPPLER_MIN, DOPPLER_MAX, FS, N_SAMPLES,
+    DELAY_MIN, delayMax, dopplerMin, dopplerMax, true, 1, Roi::Method::Fft);
+  Roi direct(DELAY_MIN, DELAY_MAX, DOPPLER_MIN, DOPPLER_MAX, FS, N_SAMPLES,
+    DELAY_MIN, delayMax, dopplerMin, dopplerMax, true, 1, Roi::Method::Direct);
+  Roi automatic(DELAY_MIN, DELAY_MAX, DOPPLER_MIN, DOPPLER_MAX, FS, N_SAMPLES,
+    DELAY_MIN, delayMax, dopplerMin, dopplerMax, true, 1);
+
+  std::cout << fft.get_n_delay_bins() << ", " << fft.get_n_doppler_bins()
+    << ", " << tFull << ", " << time_ambiguity(&fft) << ", "
+    << time_ambiguity(&direct) << ", "
+    << (automatic.is_direct_range() ? "direct" : "fft") << "/"
+    << (automatic.is_direct_doppler() ? "direct" : "fft") << std::endl;
+}
+
+/// @brief Compare ROI processing time over delay and Doppler span.
+TEST_CASE("Ambiguity_Roi", "[roi]")
+{
+  Ambiguity<double> full(DELAY_MIN, DELAY_MAX, DOPPLER_MIN, DOPPLER_MAX,
+    FS, N_SAMPLES, true, 1);
+  double tFull = time_ambiguity(&full);
+  CHECK(tFull > 0);
+
+  std::cout << "delay bins, doppler bins, full (ms), fft (ms), direct (ms), "
+    "auto range/doppler" << std::endl;
+  for (int32_t nDelay : {1, 4, 16, 32, 64, 128, 411})
+  {
+    compare_roi(nDelay, DOPPLER_MAX - DOPPLER_MIN, tFull);
+  }
+  for (double dopplerSpan : {0.0, 4.0, 8.0, 16.0, 64.0})
+  {
+    compare_roi(16, dopplerSpan, tFull);
+  }
+}
@@ -0,0 +1,82 @@
+/// @file TestAmbiguityThreads.cpp
+/// @brief Comparison test for multithreaded ambiguity processing.
+/// @details Times Ambiguity::process from 1 thread up to the number of hardware threads.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+
+#include <random>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+/// @brief Number of CPIs to average over.
+const uint32_t N_RUNS = 5;
+
+/// @brief Fill IQ data with random samples.
+/// @param iq_data Address of IqData object.
+/// @param gen Random number generator.
+/// @return Void.
+void random_iq(IqData& iq_data, std::mt19937& gen)
+{
+  std::uniform_real_distribution<> dist(-100.0, 100.0);
+  for (uint32_t i = 0; i < iq_data.get_n(); ++i) {
+    iq_data.push_back({dist(gen), dist(gen)});
+  }
+}
+
+/// @brief Time ambiguity processing for a thread count.
+/// @param nThreads Number of threads.
+/// @return Mean time per CPI (ms).
+template <typename T>
+double time_ambiguity(uint32_t nThreads)
+{
+  int32_t delayMin{-10};
+  int32_t delayMax{400};
+  int32_t dopplerMin{-200};
+  int32_t dopplerMax{200};
+  uint32_t fs{2'000'000};
+  uint32_t nSamples = 0.5 * fs;
+
+  Ambiguity<T> ambiguity(delayMin, delayMax, dopplerMin, 
+    dopplerMax, fs, nSamples, true, nThreads);
+  IqData x{nSamples};
+  IqData y{nSamples};
+  std::mt19937 gen(0);
+
+  double total = 0;
+  for (uint32_t i = 0; i < N_RUNS; i++)
+  {
+    random_iq(x, gen);
+    random_iq(y, gen);
+    auto t0 = std::chrono::steady_clock::now();
+    ambiguity.process(&x, &y);
+    auto t1 = std::chrono::steady_clock::now();
+    total += std::chrono::duration<double, std::milli>(t1 - t0).count();
+  }
+  return total / N_RUNS;
+}
+
+/// @brief Compare processing time from 1 to N threads.
+TEST_CASE("Ambiguity_Threads", "[threads]")
+{
+  uint32_t nMax = std::max(1u, std::thread::hardware_concurrency());
+  double tDouble1 = 0, tFloat1 = 0;
+  std::cout << "nThreads, double (ms), speedup, float (ms), speedup" << std::endl;
+  for (uint32_t n = 1; n <= nMax; n++)
+  {
+    double tDouble = time_ambiguity<double>(n);
+    double tFloat = time_ambiguity<float>(n);
+    if (n == 1)
+    {
+      tDouble1 = tDouble;
+      tFloat1 = tFloat;
+    }
+    std::cout << n << ", " << tDouble << ", " << tDouble1 / tDouble 
+      << ", " << tFloat << ", " << tFloat1 / tFloat << std::endl;
+    CHECK(tDouble > 0);
+  }
+}
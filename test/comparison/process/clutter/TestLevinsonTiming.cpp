@@ -0,0 +1,89 @@
+/// @file TestLevinsonTiming.cpp
+/// @brief Comparison test for the clutter filter weight solvers.
+/// @details Times the Levinson recursion against the dense Cholesky solve, and reports the weight difference.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/clutter/Levinson.h"
+
+#include <random>
+#include <chrono>
+#include <iostream>
+
+/// @brief Number of solves to average over.
+const uint32_t N_RUNS = 5;
+
+/// @brief Solve the Hermitian Toeplitz system as WienerHopf did before Levinson.
+/// @param a First row of the matrix.
+/// @param b Right hand side.
+/// @param w Solution.
+/// @return True if successful.
+bool solve_cholesky(const arma::Col<std::complex<double>> &a, 
+  const arma::Col<std::complex<double>> &b, arma::Col<std::complex<double>> &w)
+{
+  uint32_t n = a.size();
+  arma::Mat<std::complex<double>> A = arma::toeplitz(a);
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t j = 0; j < i; j++) {
+      A(i, j) = std::conj(A(i, j));
+    }
+  }
+  if (!arma::chol(A, A)) {
+    return false;
+  }
+  return arma::solve(w, arma::trimatu(A), arma::solve(arma::trimatl(arma::trans(A)), b));
+}
+
+/// @brief Compare solve time and weights for clutter filter sizes.
+TEST_CASE("Levinson_Cholesky", "[levinson]")
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 1.0);
+  uint32_t nSamples = 20000;
+
+  std::cout << "bins, cholesky (ms), levinson (ms), max relative weight difference" << std::endl;
+  for (uint32_t n : {50, 100, 200, 410})
+  {
+    // autocorrelation of a signal with multipath, and a random cross-correlation
+    std::vector<std::complex<double>> x(nSamples);
+    for (uint32_t i = 0; i < nSamples; i++) {
+      x[i] = {dist(gen), dist(gen)};
+      if (i >= 2) {
+        x[i] += 0.7 * x[i - 2];
+      }
+    }
+    arma::Col<std::complex<double>> a(n), b(n), wCholesky(n), wLevinson(n);
+    for (uint32_t k = 0; k < n; k++)
+    {
+      std::complex<double> sum = 0;
+      for (uint32_t i = 0; i < nSamples; i++) {
+        sum += x[i] * std::conj(x[(i + k) % nSamples]);
+      }
+      a[k] = sum / (double)nSamples;
+      b[k] = {dist(gen), dist(gen)};
+    }
+
+    Levinson levinson(n);
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < N_RUNS; i++) {
+      REQUIRE(solve_cholesky(a, b, wCholesky));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < N_RUNS; i++) {
+      REQUIRE(levinson.solve(a, b, wLevinson));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double difference = 0, peak = 0;
+    for (uint32_t i = 0; i < n; i++) {
+      difference = std::max(difference, std::abs(wCholesky[i] - wLevinson[i]));
+      peak = std::max(peak, std::abs(wCholesky[i]));
+    }
+    std::cout << n << ", "
+      << std::chrono::duration<double, std::milli>(t1 - t0).count() / N_RUNS << ", "
+      << std::chrono::duration<double, std::milli>(t2 - t1).count() / N_RUNS << ", "
+      << difference / peak << std::endl;
+    CHECK(difference / peak < 1e-6);
+  }
+}
@@ -0,0 +1,100 @@
+/// @file TestOverlapSaveTiming.cpp
+/// @brief Comparison test for the clutter filter convolution.
+/// @details Times overlap-save against the single long FFT WienerHopf used before, across delay ranges, and reports the output difference.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/clutter/OverlapSave.h"
+#include "process/meta/Fftw.h"
+
+#include <random>
+#include <chrono>
+#include <iostream>
+
+/// @brief Number of convolutions to average over.
+const uint32_t N_RUNS = 5;
+
+/// @brief Convolve as WienerHopf did before overlap-save, padding to nTaps + nSamples + 1.
+/// @param x Signal.
+/// @param w Filter taps.
+/// @param out Filtered signal, the length of x.
+/// @return Void.
+void convolve_long(const std::vector<std::complex<double>> &x, 
+  const arma::Col<std::complex<double>> &w, std::vector<std::complex<double>> &out)
+{
+  uint32_t nSamples = x.size();
+  uint32_t nTaps = w.size();
+  uint32_t nFilt = nTaps + nSamples + 1;
+  std::vector<std::complex<double>> filtX(nFilt, 0), filtW(nFilt, 0);
+  Fftw<double>::Plan fftX = Fftw<double>::plan_dft_1d(nFilt, filtX.data(), 
+    filtX.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  Fftw<double>::Plan fftW = Fftw<double>::plan_dft_1d(nFilt, filtW.data(), 
+    filtW.data(), FFTW_FORWARD, FFTW_ESTIMATE);
+  Fftw<double>::Plan fftFilt = Fftw<double>::plan_dft_1d(nFilt, filtX.data(), 
+    filtX.data(), FFTW_BACKWARD, FFTW_ESTIMATE);
+
+  std::copy(x.begin(), x.end(), filtX.begin());
+  for (uint32_t k = 0; k < nTaps; k++) {
+    filtW[k] = w[k];
+  }
+  Fftw<double>::execute(fftX);
+  Fftw<double>::execute(fftW);
+  for (uint32_t i = 0; i < nFilt; i++) {
+    filtX[i] *= filtW[i];
+  }
+  Fftw<double>::execute(fftFilt);
+  for (uint32_t i = 0; i < nSamples; i++) {
+    out[i] = filtX[i] / (double)nFilt;
+  }
+
+  Fftw<double>::destroy_plan(fftX);
+  Fftw<double>::destroy_plan(fftW);
+  Fftw<double>::destroy_plan(fftFilt);
+}
+
+/// @brief Compare convolution time and output for clutter filter delay ranges.
+TEST_CASE("OverlapSave_Long", "[overlapsave]")
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 1.0);
+  uint32_t nSamples = 1000000;
+  std::vector<std::complex<double>> x(nSamples), outLong(nSamples), outBlock(nSamples);
+  for (auto &sample : x) {
+    sample = {dist(gen), dist(gen)};
+  }
+
+  std::cout << "taps, long fft length, block length, long fft (ms), overlap-save (ms), max difference" << std::endl;
+  for (uint32_t nTaps : {8, 16, 50, 100, 200, 410, 1000})
+  {
+    arma::Col<std::complex<double>> w(nTaps);
+    for (uint32_t k = 0; k < nTaps; k++) {
+      w[k] = {dist(gen), dist(gen)};
+    }
+
+    // plans sized once, as in WienerHopf
+    OverlapSave convolution(nTaps, nSamples);
+    convolution.set_weights(w);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < N_RUNS; i++) {
+      convolve_long(x, w, outLong);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < N_RUNS; i++) {
+      convolution.apply(x.data(), outBlock.data());
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double difference = 0;
+    for (uint32_t i = 0; i < nSamples; i++) {
+      difference = std::max(difference, std::abs(outLong[i] - outBlock[i]));
+    }
+    std::cout << nTaps << ", " << nTaps + nSamples + 1 << ", " 
+      << convolution.get_n_block() << ", "
+      << std::chrono::duration<double, std::milli>(t1 - t0).count() / N_RUNS << ", "
+      << std::chrono::duration<double, std::milli>(t2 - t1).count() / N_RUNS << ", "
+      << difference << std::endl;
+    CHECK(difference < 1e-6);
+  }
+}
@@ -0,0 +1,63 @@
+/// @file TestCfarTiming.cpp
+/// @brief Comparison test for CFAR detector cost.
+/// @details Times OS-CFAR against CA-CFAR per map across map sizes and training windows, single threaded.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/detection/CfarDetector1D.h"
+#include "process/detection/CfarDetectorOs.h"
+#include "data/Map.h"
+
+#include <random>
+#include <chrono>
+#include <iostream>
+
+/// @brief Number of maps to average over.
+const uint32_t N_RUNS = 10;
+
+/// @brief Compare OS-CFAR and CA-CFAR time per map.
+TEST_CASE("Cfar_Os", "[cfar]")
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<double> dist(0.0, 1.0);
+
+  std::cout << "doppler bins, delay bins, train cells, ca-cfar (ms), os-cfar (ms), ratio" << std::endl;
+  for (auto size : std::vector<std::pair<uint32_t, uint32_t>>{{201, 410}, {401, 410}, {801, 1000}})
+  {
+    Map<std::complex<float>> map(size.first, size.second);
+    for (uint32_t j = 0; j < size.second; j++) {
+      map.delay.push_back((int)j);
+    }
+    for (uint32_t i = 0; i < size.first; i++) {
+      map.doppler.push_back(((double)i - size.first / 2.0) * 2);
+      for (uint32_t j = 0; j < size.second; j++) {
+        map.at(i, j) = std::complex<float>(dist(gen), dist(gen));
+      }
+    }
+    map.set_metrics();
+
+    for (int nTrain : {6, 16, 32})
+    {
+      CfarDetector1D cfarCa(1e-5, 2, nTrain, 0, 0);
+      CfarDetectorOs cfarOs(1e-5, 2, nTrain, 0.75);
+      Detection detection;
+
+      auto t0 = std::chrono::steady_clock::now();
+      for (uint32_t i = 0; i < N_RUNS; i++) {
+        cfarCa.process(&map, &detection);
+      }
+      auto t1 = std::chrono::steady_clock::now();
+      for (uint32_t i = 0; i < N_RUNS; i++) {
+        cfarOs.process(&map, &detection);
+      }
+      auto t2 = std::chrono::steady_clock::now();
+
+      double timeCa = std::chrono::duration<double, std::milli>(t1 - t0).count() / N_RUNS;
+      double timeOs = std::chrono::duration<double, std::milli>(t2 - t1).count() / N_RUNS;
+      std::cout << size.first << ", " << size.second << ", " << 2 * nTrain << ", " 
+        << timeCa << ", " << timeOs << ", " << timeOs / timeCa << std::endl;
+      CHECK(timeOs < 10 * timeCa);
+    }
+  }
+}
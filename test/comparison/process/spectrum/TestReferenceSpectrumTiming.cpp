@@ -0,0 +1,83 @@
+/// @file TestReferenceSpectrumTiming.cpp
+/// @brief Comparison test for the shared reference spectrum.
+/// @details Times the spectrum analyser and clutter filter with their own reference FFTs, and with one shared ReferenceSpectrum.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/spectrum/ReferenceSpectrum.h"
+#include "process/spectrum/SpectrumAnalyser.h"
+#include "process/clutter/WienerHopf.h"
+
+#include <random>
+#include <chrono>
+#include <iostream>
+
+/// @brief Number of CPIs to average over.
+const uint32_t N_RUNS = 3;
+
+/// @brief Fill IQ data with random samples.
+/// @param iq_data Address of IqData object.
+/// @param gen Random number generator.
+/// @return Void.
+void random_iq(IqData& iq_data, std::mt19937& gen)
+{
+  std::uniform_real_distribution<> dist(-100.0, 100.0);
+  iq_data.clear();
+  for (uint32_t i = 0; i < iq_data.get_n(); ++i) {
+    iq_data.push_back({dist(gen), dist(gen)});
+  }
+}
+
+/// @brief Time the spectrum and clutter stages for a CPI.
+/// @param nSamples Number of samples.
+/// @param isShared True if the reference spectrum is shared.
+/// @return Mean time per CPI (ms).
+template <typename T>
+double time_stages(uint32_t nSamples, bool isShared)
+{
+  ReferenceSpectrum<T> reference(nSamples);
+  SpectrumAnalyser<T> spectrumAnalyser(nSamples, 2000);
+  WienerHopf<T> filter(-10, 400, nSamples);
+  IqData x{nSamples};
+  IqData y{nSamples};
+  std::mt19937 gen(0);
+
+  double total = 0;
+  for (uint32_t i = 0; i < N_RUNS; i++)
+  {
+    random_iq(x, gen);
+    random_iq(y, gen);
+    auto t0 = std::chrono::steady_clock::now();
+    if (isShared)
+    {
+      reference.process(&x);
+      spectrumAnalyser.process(&x, &reference);
+      filter.process(&x, &y, &reference);
+    }
+    else
+    {
+      spectrumAnalyser.process(&x);
+      filter.process(&x, &y);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    total += std::chrono::duration<double, std::milli>(t1 - t0).count();
+  }
+  return total / N_RUNS;
+}
+
+/// @brief Compare spectrum and clutter time with and without the shared spectrum.
+TEST_CASE("Reference_Spectrum", "[spectrum]")
+{
+  uint32_t fs = 2'000'000;
+  std::cout << "cpi (s), separate (ms), shared (ms), saving (ms)" << std::endl;
+  for (double tCpi : {0.25, 0.5, 1.0})
+  {
+    uint32_t nSamples = tCpi * fs;
+    double tSeparate = time_stages<double>(nSamples, false);
+    double tShared = time_stages<double>(nSamples, true);
+    std::cout << tCpi << ", " << tSeparate << ", " << tShared << ", "
+      << tSeparate - tShared << std::endl;
+    CHECK(tShared > 0);
+  }
+}
@@ -0,0 +1,96 @@
+/// @file TestTrackerTiming.cpp
+/// @brief Comparison test for tracker association cost.
+/// @details Times Tracker::process against an all-pairs gating scan as the number of tracks grows to the thousands.
+/// Each target initiates a tentative track per acceleration hypothesis, so the tracks outnumber targets by the number of hypotheses.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/tracker/Tracker.h"
+#include "data/Detection.h"
+#include "data/Track.h"
+#include "data/meta/Constants.h"
+
+#include <random>
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+/// @brief Number of CPIs to average over.
+const uint32_t N_RUNS = 5;
+
+/// @brief Compare tracker time per CPI with an all-pairs gating scan.
+TEST_CASE("Tracker_Association", "[tracker]")
+{
+  double cpi = 1;
+  double fs = 2000000;
+  double rangeRes = (double)Constants::c/fs;
+  double fc = 204640000;
+  double lambda = (double)Constants::c/fc;
+
+  std::cout << "targets, tracks, tracker (ms), all-pairs gating (ms)" << std::endl;
+  double timePerTrack0 = 0;
+  for (uint32_t nTargets : {50, 100, 200, 400, 800})
+  {
+    Tracker tracker(3, 5, 5, cpi, 10, rangeRes, lambda);
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> uniformDelay(0, 400);
+    std::uniform_real_distribution<double> uniformDoppler(-200, 200);
+    std::vector<double> delay(nTargets), doppler(nTargets), snr(nTargets, 20);
+    for (uint32_t k = 0; k < nTargets; k++)
+    {
+      delay[k] = uniformDelay(gen);
+      doppler[k] = uniformDoppler(gen);
+    }
+    Detection detection0(delay, doppler, snr);
+    std::unique_ptr<Track> track = tracker.process(&detection0, 0);
+    uint64_t nTracks = track->get_n();
+
+    double timeTracker = 0, timeScan = 0;
+    uint64_t nGated = 0;
+    for (uint32_t run = 1; run <= N_RUNS; run++)
+    {
+      // targets at constant Doppler
+      for (uint32_t k = 0; k < nTargets; k++)
+      {
+        delay[k] += doppler[k]*cpi*lambda/rangeRes;
+      }
+      Detection detection(delay, doppler, snr);
+
+      // all-pairs gating of the same tracks
+      auto t0 = std::chrono::steady_clock::now();
+      for (uint64_t i = 0; i < track->get_n(); i++)
+      {
+        Plot prediction = tracker.predict(track->get_current(i),
+          track->get_acceleration(i), cpi);
+        for (uint32_t j = 0; j < nTargets; j++)
+        {
+          double dDelay = delay[j] - prediction.delay;
+          double dDoppler = (doppler[j] - prediction.doppler)*cpi;
+          nGated += dDelay*dDelay + dDoppler*dDoppler < 1;
+        }
+      }
+      auto t1 = std::chrono::steady_clock::now();
+      track = tracker.process(&detection, run*cpi*1000);
+      auto t2 = std::chrono::steady_clock::now();
+
+      timeScan += std::chrono::duration<double, std::milli>(t1 - t0).count();
+      timeTracker += std::chrono::duration<double, std::milli>(t2 - t1).count();
+    }
+    timeTracker /= N_RUNS;
+    timeScan /= N_RUNS;
+    std::cout << nTargets << ", " << nTracks << ", " << timeTracker
+      << ", " << timeScan << std::endl;
+
+    // every target is held by exactly one track
+    CHECK(track->get_nState("ACTIVE") + track->get_nState("ASSOCIATED") == nTargets);
+    CHECK(nGated >= nTargets);
+
+    // association scales with tracks, not tracks by detections
+    if (timePerTrack0 == 0)
+    {
+      timePerTrack0 = timeTracker / nTracks;
+    }
+    CHECK(timeTracker / nTracks < 4 * timePerTrack0);
+  }
+}
@@ -0,0 +1,150 @@
+/// @file TestDetectionChain.cpp
+/// @brief Functional test for the fused peak extraction.
+/// @details Checks the fused pass matches the CFAR, centroid and interpolation stages on ambiguity maps.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+#include "process/detection/CfarDetector1D.h"
+#include "process/detection/Centroid.h"
+#include "process/detection/Interpolate.h"
+#include "process/detection/PeakExtractor.h"
+#include "data/Detection.h"
+
+#include <random>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <filesystem>
+
+/// @brief Generate a reference signal and delayed, Doppler shifted echoes.
+/// @param x Output reference samples.
+/// @param y Output surveillance samples.
+/// @param n Number of samples.
+/// @param fs Sampling frequency (Hz).
+/// @return Void.
+void simulate_targets(std::vector<std::complex<double>>& x, 
+  std::vector<std::complex<double>>& y, uint32_t n, uint32_t fs)
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 100.0);
+  std::vector<uint32_t> delay = {20, 50, 53, 120};
+  std::vector<double> doppler = {-150, 40, 46, 200};
+  x.resize(n);
+  y.resize(n);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x[i] = {dist(gen), dist(gen)};
+  }
+  for (uint32_t i = 0; i < n; i++)
+  {
+    y[i] = 0.1 * std::complex<double>(dist(gen), dist(gen));
+    for (size_t k = 0; k < delay.size(); k++)
+    {
+      std::complex<double> echo = (i >= delay[k]) ? x[i-delay[k]] : 0;
+      y[i] += echo * 0.02 * std::exp(std::complex<double>(0, 2 * M_PI * doppler[k] * i / fs));
+    }
+  }
+}
+
+/// @brief Read file to sample vectors.
+/// @param x Output reference samples.
+/// @param y Output surveillance samples.
+/// @param n Number of samples to read.
+/// @param file String of file name.
+/// @return Void.
+void read_file(std::vector<std::complex<double>>& x, 
+  std::vector<std::complex<double>>& y, uint32_t n, const std::string& file)
+{
+  short i1, q1, i2, q2;
+  auto file_replay = fopen(file.c_str(), "rb");
+  if (!file_replay) {
+    return;
+  }
+
+  auto read_short = [](short& v, FILE* fid) {
+    auto rv{fread(&v, 1, sizeof(short), fid)};
+    return rv == sizeof(short);
+  };
+
+  while (!feof(file_replay) && x.size() < n)
+  {
+    if (!read_short(i1, file_replay)) break;
+    if (!read_short(q1, file_replay)) break;
+    if (!read_short(i2, file_replay)) break;
+    if (!read_short(q2, file_replay)) break;
+
+    x.push_back({(double)i1, (double)q1});
+    y.push_back({(double)i2, (double)q2});
+  }
+
+  fclose(file_replay);
+}
+
+/// @brief Compare the fused pass with the stages on the ambiguity map of samples.
+/// @param x Reference samples.
+/// @param y Surveillance samples.
+/// @param fs Sampling frequency (Hz).
+/// @return Void.
+void compare_chain(const std::vector<std::complex<double>>& x, 
+  const std::vector<std::complex<double>>& y, uint32_t fs)
+{
+  uint32_t nSamples = x.size();
+  IqData iqX{nSamples};
+  IqData iqY{nSamples};
+  for (size_t i = 0; i < x.size(); i++)
+  {
+    iqX.push_back(x[i]);
+    iqY.push_back(y[i]);
+  }
+  Ambiguity<float> ambiguity(-10, 300, -300, 300, fs, nSamples, true);
+  Map<std::complex<float>> *map = ambiguity.process(&iqX, &iqY);
+  map->set_metrics();
+  double resolutionDoppler = 1 / ambiguity.get_cpi();
+
+  CfarDetector1D cfar(1e-5, 2, 6, 5, 15);
+  Centroid centroid(6, 6, resolutionDoppler);
+  Interpolate interpolate(true, true);
+  Detection detection1, detection2, reference;
+  cfar.process(map, &detection1);
+  centroid.process(&detection1, &detection2);
+  interpolate.process(&detection2, map, &reference);
+
+  PeakExtractor extractor(1e-5, 2, 6, 5, 15, 6, 6, resolutionDoppler, 3);
+  Detection detection;
+  extractor.process(map, &detection);
+
+  CHECK(detection.get_nDetections() > 0);
+  REQUIRE(detection.get_nDetections() == reference.get_nDetections());
+  CHECK(detection.get_delay() == reference.get_delay());
+  CHECK(detection.get_doppler() == reference.get_doppler());
+  CHECK(detection.get_snr() == reference.get_snr());
+}
+
+/// @brief Test the fused pass matches the stages for simulated targets.
+TEST_CASE("Chain_Simulated", "[chain]")
+{
+  uint32_t fs{2'000'000};
+  uint32_t nSamples = 0.5 * fs;
+  std::vector<std::complex<double>> x, y;
+  simulate_targets(x, y, nSamples, fs);
+  compare_chain(x, y, fs);
+}
+
+/// @brief Test the fused pass matches the stages on recorded data.
+TEST_CASE("Chain_File", "[chain]")
+{
+  std::filesystem::path test_input_file("20231214-230611.rspduo");
+  // Bail if the test file doesn't exist
+  if (!std::filesystem::exists(test_input_file)) {
+    SKIP("Input test file does not exist.");
+  }
+
+  uint32_t fs{2'000'000};
+  uint32_t nSamples = 0.5 * fs;
+  std::vector<std::complex<double>> x, y;
+  read_file(x, y, nSamples, test_input_file);
+  REQUIRE(x.size() == nSamples);
+  compare_chain(x, y, fs);
+}
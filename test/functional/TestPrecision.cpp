@@ -0,0 +1,272 @@
+/// @file TestPrecision.cpp
+/// @brief Functional test for single and double precision processing.
+/// @details Checks the float processing chain matches the double chain within tolerance,
+/// for the clutter filter, spectrum analyser, ambiguity map and CFAR detector.
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+#include "process/detection/CfarDetector1D.h"
+#include "process/clutter/WienerHopf.h"
+#include "process/spectrum/SpectrumAnalyser.h"
+#include "data/Detection.h"
+
+#include <random>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <filesystem>
+
+/// @brief Tolerance of map cells between precisions (dB).
+const double TOLERANCE_MAP_DB = 0.1;
+
+/// @brief Tolerance of map metrics between precisions (dB).
+const double TOLERANCE_METRIC_DB = 0.01;
+
+/// @brief Tolerance of clutter filter output between precisions, relative to the residual power.
+const double TOLERANCE_CLUTTER = 1e-3;
+
+/// @brief Generate a reference signal and a delayed, Doppler shifted echo.
+/// @param x Output reference samples.
+/// @param y Output surveillance samples.
+/// @param n Number of samples.
+/// @param fs Sampling frequency (Hz).
+/// @return Void.
+void simulate_target(std::vector<std::complex<double>>& x, 
+  std::vector<std::complex<double>>& y, uint32_t n, uint32_t fs)
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 100.0);
+  uint32_t delay = 50;
+  double doppler = 40;
+  x.resize(n);
+  y.resize(n);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x[i] = {dist(gen), dist(gen)};
+  }
+  for (uint32_t i = 0; i < n; i++)
+  {
+    std::complex<double> echo = (i >= delay) ? x[i-delay] : 0;
+    echo *= 0.05 * std::exp(std::complex<double>(0, 2 * M_PI * doppler * i / fs));
+    y[i] = echo + 0.1 * std::complex<double>(dist(gen), dist(gen));
+  }
+}
+
+/// @brief Read file to sample vectors.
+/// @param x Output reference samples.
+/// @param y Output surveillance samples.
+/// @param n Number of samples to read.
+/// @param file String of file name.
+/// @return Void.
+void read_file(std::vector<std::complex<double>>& x, 
+  std::vector<std::complex<double>>& y, uint32_t n, const std::string& file)
+{
+  short i1, q1, i2, q2;
+  auto file_replay = fopen(file.c_str(), "rb");
+  if (!file_replay) {
+    return;
+  }
+
+  auto read_short = [](short& v, FILE* fid) {
+    auto rv{fread(&v, 1, sizeof(short), fid)};
+    return rv == sizeof(short);
+  };
+
+  while (!feof(file_replay) && x.size() < n)
+  {
+    if (!read_short(i1, file_replay)) break;
+    if (!read_short(q1, file_replay)) break;
+    if (!read_short(i2, file_replay)) break;
+    if (!read_short(q2, file_replay)) break;
+
+    x.push_back({(double)i1, (double)q1});
+    y.push_back({(double)i2, (double)q2});
+  }
+
+  fclose(file_replay);
+}
+
+/// @brief Run the ambiguity and CFAR chain at a precision.
+/// @param x Reference samples.
+/// @param y Surveillance samples.
+/// @param ambiguity Ambiguity processor of precision T.
+/// @param detection Output detections.
+/// @return Pointer to the ambiguity map.
+template <typename T>
+Map<std::complex<T>> *run_chain(const std::vector<std::complex<double>>& x, 
+  const std::vector<std::complex<double>>& y, Ambiguity<T>& ambiguity,
+  Detection& detection)
+{
+  IqData iqX{(uint32_t)x.size()};
+  IqData iqY{(uint32_t)y.size()};
+  for (size_t i = 0; i < x.size(); i++)
+  {
+    iqX.push_back(x[i]);
+    iqY.push_back(y[i]);
+  }
+  CfarDetector1D cfar(1e-5, 2, 6, 5, 15);
+  Map<std::complex<T>> *map = ambiguity.process(&iqX, &iqY);
+  map->set_metrics();
+  cfar.process(map, &detection);
+  return map;
+}
+
+/// @brief Compare float and double processing of the same samples.
+/// @param x Reference samples.
+/// @param y Surveillance samples.
+/// @param fs Sampling frequency (Hz).
+/// @return Void.
+void compare_precision(const std::vector<std::complex<double>>& x, 
+  const std::vector<std::complex<double>>& y, uint32_t fs)
+{
+  uint32_t nSamples = x.size();
+  Ambiguity<double> ambiguityDouble(-10, 300, -300, 300, fs, nSamples, true);
+  Ambiguity<float> ambiguityFloat(-10, 300, -300, 300, fs, nSamples, true);
+  Detection detectionDouble, detectionFloat;
+  auto mapDouble = run_chain(x, y, ambiguityDouble, detectionDouble);
+  auto mapFloat = run_chain(x, y, ambiguityFloat, detectionFloat);
+
+  // map metrics
+  CHECK_THAT(mapFloat->noisePower, Catch::Matchers::WithinAbs(
+    mapDouble->noisePower, TOLERANCE_METRIC_DB));
+  CHECK_THAT(mapFloat->maxPower, Catch::Matchers::WithinAbs(
+    mapDouble->maxPower, TOLERANCE_METRIC_DB));
+
+  // map cells
+  REQUIRE(mapFloat->get_nRows() == mapDouble->get_nRows());
+  REQUIRE(mapFloat->get_nCols() == mapDouble->get_nCols());
+  double maxError = 0;
+  for (uint32_t i = 0; i < mapDouble->get_nRows(); i++)
+  {
+    for (uint32_t j = 0; j < mapDouble->get_nCols(); j++)
+    {
+      double valueDouble = 10 * std::log10(std::abs(mapDouble->at(i, j)));
+      double valueFloat = 10 * std::log10(std::abs(mapFloat->at(i, j)));
+      maxError = std::max(maxError, std::abs(valueDouble - valueFloat));
+    }
+  }
+  CHECK(maxError < TOLERANCE_MAP_DB);
+
+  // detections
+  CHECK(detectionDouble.get_nDetections() > 0);
+  REQUIRE(detectionFloat.get_nDetections() == detectionDouble.get_nDetections());
+  for (size_t i = 0; i < detectionDouble.get_nDetections(); i++)
+  {
+    CHECK(detectionFloat.get_delay()[i] == detectionDouble.get_delay()[i]);
+    CHECK(detectionFloat.get_doppler()[i] == detectionDouble.get_doppler()[i]);
+    CHECK_THAT(detectionFloat.get_snr()[i], Catch::Matchers::WithinAbs(
+      detectionDouble.get_snr()[i], TOLERANCE_METRIC_DB));
+  }
+}
+
+/// @brief Load samples to IqData.
+/// @param samples Samples to load.
+/// @param iq Output IqData.
+/// @return Void.
+void load_iq(const std::vector<std::complex<double>>& samples, IqData& iq)
+{
+  iq.clear();
+  for (const auto &sample : samples)
+  {
+    iq.push_back(sample);
+  }
+}
+
+/// @brief Compare float and double clutter filter and spectrum analyser on the same samples.
+/// @details The float clutter filter includes the float Levinson solver.
+/// @param x Reference samples.
+/// @param y Surveillance samples.
+/// @param fs Sampling frequency (Hz).
+/// @return Void.
+void compare_precision_clutter(const std::vector<std::complex<double>>& x, 
+  const std::vector<std::complex<double>>& y, uint32_t fs)
+{
+  uint32_t nSamples = x.size();
+  IqData xDouble{nSamples}, yDouble{nSamples}, xFloat{nSamples}, yFloat{nSamples};
+  load_iq(x, xDouble);
+  load_iq(y, yDouble);
+  load_iq(x, xFloat);
+  load_iq(y, yFloat);
+
+  // clutter filter
+  WienerHopf<double> filterDouble(-10, 100, nSamples);
+  WienerHopf<float> filterFloat(-10, 100, nSamples);
+  REQUIRE(filterDouble.process(&xDouble, &yDouble));
+  REQUIRE(filterFloat.process(&xFloat, &yFloat));
+  CHECK(filterDouble.get_cancellation() > 10);
+  CHECK_THAT(filterFloat.get_cancellation(), Catch::Matchers::WithinAbs(
+    filterDouble.get_cancellation(), TOLERANCE_METRIC_DB));
+  std::deque<std::complex<double>> outDouble = yDouble.get_data();
+  std::deque<std::complex<double>> outFloat = yFloat.get_data();
+  double error = 0, power = 0;
+  for (uint32_t i = 0; i < nSamples; i++)
+  {
+    error += std::norm(outFloat[i] - outDouble[i]);
+    power += std::norm(outDouble[i]);
+  }
+  CHECK(error < TOLERANCE_CLUTTER * power);
+
+  // spectrum analyser
+  SpectrumAnalyser<double> spectrumDouble(nSamples, fs / 1000);
+  SpectrumAnalyser<float> spectrumFloat(nSamples, fs / 1000);
+  spectrumDouble.process(&xDouble);
+  spectrumFloat.process(&xFloat);
+  std::vector<std::complex<double>> binDouble = xDouble.get_spectrum();
+  std::vector<std::complex<double>> binFloat = xFloat.get_spectrum();
+  REQUIRE(binFloat.size() == binDouble.size());
+  REQUIRE(binDouble.size() > 0);
+  double maxError = 0;
+  for (size_t i = 0; i < binDouble.size(); i++)
+  {
+    maxError = std::max(maxError, std::abs(10 * std::log10(std::abs(binDouble[i])) - 
+      10 * std::log10(std::abs(binFloat[i]))));
+  }
+  CHECK(maxError < TOLERANCE_MAP_DB);
+}
+
+/// @brief Test float matches double for a simulated target.
+TEST_CASE("Precision_Simulated", "[precision]")
+{
+  uint32_t fs{2'000'000};
+  uint32_t nSamples = 0.5 * fs;
+  std::vector<std::complex<double>> x, y;
+  simulate_target(x, y, nSamples, fs);
+  compare_precision(x, y, fs);
+}
+
+/// @brief Test float matches double for the clutter filter and spectrum analyser.
+TEST_CASE("Precision_Clutter", "[precision]")
+{
+  uint32_t fs{2'000'000};
+  uint32_t nSamples = 0.5 * fs;
+  std::vector<std::complex<double>> x, y;
+  simulate_target(x, y, nSamples, fs);
+
+  // add a direct path and a static clutter echo
+  for (uint32_t i = 0; i < nSamples; i++)
+  {
+    y[i] += x[i] + (i >= 20 ? 0.3 * x[i - 20] : 0);
+  }
+  compare_precision_clutter(x, y, fs);
+}
+
+/// @brief Test float matches double on recorded data.
+TEST_CASE("Precision_File", "[precision]")
+{
+  std::filesystem::path test_input_file("20231214-230611.rspduo");
+  // Bail if the test file doesn't exist
+  if (!std::filesystem::exists(test_input_file)) {
+    SKIP("Input test file does not exist.");
+  }
+
+  uint32_t fs{2'000'000};
+  uint32_t nSamples = 0.5 * fs;
+  std::vector<std::complex<double>> x, y;
+  read_file(x, y, nSamples, test_input_file);
+  REQUIRE(x.size() == nSamples);
+  compare_precision(x, y, fs);
+  compare_precision_clutter(x, y, fs);
+}
@@ -0,0 +1,132 @@
+/// @file TestHelper.h
+/// @brief Shared helpers for unit tests of maps and detection.
+/// @details Generates noise maps on regular axes and compares detections.
+/// Each test adds its own target pattern to the noise map.
+/// @author 30hours
+
+#ifndef TESTHELPER_H
+#define TESTHELPER_H
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "data/Map.h"
+#include "data/Detection.h"
+
+#include <stdint.h>
+#include <random>
+#include <complex>
+#include <cmath>
+
+/// @brief SNR tolerance of double maps, which use the exact log10 (dB).
+const double TOLERANCE_SNR_DOUBLE = 1e-9;
+
+/// @brief SNR tolerance of float maps, which use FastLog (dB).
+const double TOLERANCE_SNR_FLOAT = 1e-3;
+
+/// @brief Fill every cell of a map with complex Gaussian noise.
+/// @param map Map to fill.
+/// @param gen Random number generator.
+/// @return Void.
+template <typename T>
+void fill_noise(Map<std::complex<T>> &map, std::mt19937 &gen)
+{
+  std::normal_distribution<double> noise(0, 1);
+  for (uint32_t i = 0; i < map.get_nRows(); i++)
+  {
+    for (uint32_t j = 0; j < map.get_nCols(); j++)
+    {
+      map.at(i, j) = std::complex<T>{(T)noise(gen), (T)noise(gen)};
+    }
+  }
+}
+
+/// @brief Create a noise map on regular delay and Doppler axes.
+/// @param nRows Number of Doppler bins.
+/// @param nCols Number of delay bins.
+/// @param gen Random number generator.
+/// @param delay0 Delay of the first column (bins).
+/// @param resolutionDoppler Doppler bin width (Hz), with zero Doppler at row nRows/2.
+/// @return Map.
+template <typename T>
+Map<std::complex<T>> create_map(uint32_t nRows, uint32_t nCols, std::mt19937 &gen,
+  int32_t delay0 = 0, double resolutionDoppler = 2)
+{
+  Map<std::complex<T>> map(nRows, nCols);
+  for (uint32_t j = 0; j < nCols; j++)
+  {
+    map.delay.push_back(delay0 + (int)j);
+  }
+  for (uint32_t i = 0; i < nRows; i++)
+  {
+    map.doppler.push_back(((double)i - nRows / 2) * resolutionDoppler);
+  }
+  fill_noise(map, gen);
+  return map;
+}
+
+/// @brief Scale a random fraction of cells as point targets.
+/// @param map Map to add targets to.
+/// @param gen Random number generator.
+/// @param fraction Probability of each cell being a target.
+/// @param decades Maximum target gain in decades of amplitude, uniform from 0.
+/// @return Void.
+template <typename T>
+void add_targets(Map<std::complex<T>> &map, std::mt19937 &gen, double fraction, double decades)
+{
+  std::uniform_real_distribution<double> uniform(0, 1);
+  for (uint32_t i = 0; i < map.get_nRows(); i++)
+  {
+    for (uint32_t j = 0; j < map.get_nCols(); j++)
+    {
+      if (uniform(gen) < fraction)
+      {
+        map.at(i, j) *= (T)std::pow(10.0, decades * uniform(gen));
+      }
+    }
+  }
+}
+
+/// @brief Count detections at a delay.
+/// @param detection Detections.
+/// @param delay Delay to count (bins).
+/// @return Number of detections.
+inline size_t count_delay(const Detection &detection, double delay)
+{
+  size_t n = 0;
+  for (double value : detection.get_delay())
+  {
+    n += (value == delay);
+  }
+  return n;
+}
+
+/// @brief Check detections are identical, with SNR within a tolerance.
+/// @details Map indices are compared if both detections carry them.
+/// Non-finite cells leave a NaN noise power, so a NaN SNR only matches NaN.
+/// @param a First detections.
+/// @param b Second detections.
+/// @param tolerance Maximum absolute SNR difference (dB).
+/// @return Void.
+inline void check_identical(const Detection &a, const Detection &b, double tolerance)
+{
+  REQUIRE(a.get_nDetections() == b.get_nDetections());
+  CHECK(a.get_delay() == b.get_delay());
+  CHECK(a.get_doppler() == b.get_doppler());
+  for (size_t i = 0; i < a.get_nDetections(); i++)
+  {
+    if (std::isnan(a.get_snr()[i]) || std::isnan(b.get_snr()[i]))
+    {
+      CHECK((std::isnan(a.get_snr()[i]) && std::isnan(b.get_snr()[i])));
+      continue;
+    }
+    CHECK_THAT(a.get_snr()[i], Catch::Matchers::WithinAbs(b.get_snr()[i], tolerance));
+  }
+  if (a.has_bin() && b.has_bin())
+  {
+    CHECK(a.get_delay_bin() == b.get_delay_bin());
+    CHECK(a.get_doppler_bin() == b.get_doppler_bin());
+  }
+}
+
+#endif
@@ -0,0 +1,61 @@
+/// @file TestDetection.cpp
+/// @brief Unit test for Detection.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "data/Detection.h"
+#include "data/Plot.h"
+
+#include <vector>
+
+/// @brief Test constructors and single detection access.
+TEST_CASE("Constructor", "[constructor]")
+{
+  Detection empty;
+  CHECK(empty.get_nDetections() == 0);
+  CHECK(empty.has_bin());
+
+  Detection single(10, -20, 15);
+  REQUIRE(single.get_nDetections() == 1);
+  CHECK(!single.has_bin());
+  Plot plot = single.get_plot(0);
+  CHECK(plot.delay == 10);
+  CHECK(plot.doppler == -20);
+  CHECK(plot.snr == 15);
+
+  Detection list({1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {1, 2, 3}, {0, 1, 2});
+  REQUIRE(list.get_nDetections() == 3);
+  CHECK(list.has_bin());
+  plot = list.get_plot(2);
+  CHECK(plot.delay == 3);
+  CHECK(plot.doppler == 6);
+  CHECK(plot.snr == 9);
+}
+
+/// @brief Test storage is reused when refilled after clear.
+TEST_CASE("Clear_Reuse", "[detection]")
+{
+  Detection detection;
+  detection.reserve(100);
+  const double *data = detection.get_delay().data();
+  for (int cpi = 0; cpi < 3; cpi++)
+  {
+    detection.clear();
+    CHECK(detection.get_nDetections() == 0);
+    for (int i = 0; i < 100; i++)
+    {
+      detection.push_back(i, -i, cpi, i, i + 1);
+    }
+    REQUIRE(detection.get_nDetections() == 100);
+    CHECK(detection.get_delay().data() == data);
+    CHECK(detection.get_snr().back() == cpi);
+    CHECK(detection.get_doppler_bin().back() == 100);
+  }
+
+  // refilled without map indices
+  detection.clear();
+  detection.push_back(1, 2, 3);
+  REQUIRE(detection.get_nDetections() == 1);
+  CHECK(!detection.has_bin());
+}
@@ -0,0 +1,160 @@
+/// @file TestMap.cpp
+/// @brief Unit test for Map.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "data/Map.h"
+#include "data/meta/FastLog.h"
+#include "helper/TestHelper.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+/// @brief Test the fast log10 over the float range.
+TEST_CASE("FastLog", "[log]")
+{
+  double errorMax = 0;
+  for (double x = 1e-37; x < 1e38; x *= 1.0137)
+  {
+    float value = (float)x;
+    double exact = std::log10((double)value);
+    double error = std::abs(FastLog::log10(value) - exact) / std::max(1.0, std::abs(exact));
+    errorMax = std::max(errorMax, error);
+  }
+  CHECK(errorMax < 1e-6);
+  CHECK(FastLog::log10(1.0f) == 0.0f);
+}
+
+/// @brief Create a map of noise with a wide dynamic range.
+/// @param gen Random generator.
+/// @return The map.
+template <typename T>
+Map<std::complex<T>> create_wide_map(std::mt19937 &gen)
+{
+  std::uniform_real_distribution<double> uniform(0, 1);
+  Map<std::complex<T>> map = create_map<T>(32, 100, gen);
+  for (uint32_t i = 0; i < 32; i++)
+  {
+    for (uint32_t j = 0; j < 100; j++)
+    {
+      map.at(i, j) *= (T)std::pow(10.0, 8 * uniform(gen) - 4);
+    }
+  }
+  return map;
+}
+
+/// @brief Check the planes and metrics against direct calculation.
+/// @details Double planes must be exactly as the detectors computed per cell.
+/// @param x Map with metrics set.
+/// @return Void.
+template <typename T>
+void check_planes(const Map<std::complex<T>> &x)
+{
+  REQUIRE(x.has_planes());
+  double noisePower = 0, maxPower = 0;
+  for (uint32_t i = 0; i < x.get_nRows(); i++)
+  {
+    for (uint32_t j = 0; j < x.get_nCols(); j++)
+    {
+      size_t k = (size_t)i * x.get_nCols() + j;
+      double level = 10 * std::log10(std::abs(std::complex<double>(x.at(i, j))));
+      noisePower += level;
+      maxPower = std::max(maxPower, level);
+      CHECK_THAT(x.level[k], Catch::Matchers::WithinAbs(level, 1e-4));
+      CHECK_THAT(x.power[k], Catch::Matchers::WithinRel(
+        std::norm(std::complex<double>(x.at(i, j))), 1e-6));
+      if constexpr (std::is_same_v<T, double>)
+      {
+        CHECK(x.power[k] == std::abs(x.at(i, j) * x.at(i, j)));
+        CHECK(x.level[k] == 10 * std::log10(std::abs(x.at(i, j))));
+      }
+    }
+  }
+  noisePower /= x.get_nRows() * x.get_nCols();
+  CHECK_THAT(x.noisePower, Catch::Matchers::WithinAbs(noisePower, 1e-6));
+  CHECK_THAT(x.maxPower, Catch::Matchers::WithinAbs(maxPower - noisePower, 1e-4));
+}
+
+/// @brief Test the planes and metrics for double maps.
+TEST_CASE("Set_Metrics_Double", "[metrics]")
+{
+  std::mt19937 gen(1);
+  Map<std::complex<double>> map = create_wide_map<double>(gen);
+  map.set_metrics();
+  check_planes(map);
+}
+
+/// @brief Test the planes and metrics for float maps.
+TEST_CASE("Set_Metrics_Float", "[metrics]")
+{
+  std::mt19937 gen(2);
+  Map<std::complex<float>> map = create_wide_map<float>(gen);
+  map.set_metrics();
+  check_planes(map);
+}
+
+/// @brief Test cells outside the normal float range use the exact level.
+TEST_CASE("Set_Metrics_Edge", "[metrics]")
+{
+  Map<std::complex<float>> map(1, 4);
+  map.at(0, 0) = 0;
+  map.at(0, 1) = 1e-30;
+  map.at(0, 2) = 1e30;
+  map.at(0, 3) = std::numeric_limits<float>::infinity();
+  map.set_metrics();
+  CHECK(map.level[0] == -std::numeric_limits<float>::infinity());
+  CHECK_THAT(map.level[1], Catch::Matchers::WithinAbs(-300, 1e-4));
+  CHECK_THAT(map.level[2], Catch::Matchers::WithinAbs(300, 1e-4));
+  CHECK(map.level[3] == std::numeric_limits<float>::infinity());
+
+  // planes are refreshed when the map changes
+  map.at(0, 0) = 10;
+  map.set_metrics();
+  CHECK_THAT(map.level[0], Catch::Matchers::WithinAbs(10, 1e-4));
+  CHECK_THAT(map.power[0], Catch::Matchers::WithinRel(100, 1e-6));
+}
+
+/// @brief Test writes to the map mark the planes stale until set_metrics.
+TEST_CASE("Set_Metrics_Stale", "[metrics]")
+{
+  std::mt19937 gen(3);
+  Map<std::complex<double>> map = create_wide_map<double>(gen);
+  CHECK(!map.has_planes());
+  map.set_metrics();
+  REQUIRE(map.has_planes());
+
+  // reads leave the planes current
+  const Map<std::complex<double>> &mapConst = map;
+  std::complex<double> cell = mapConst.at(2, 3);
+  CHECK(map.has_planes());
+
+  // each writable accessor marks the planes stale
+  map.at(2, 3) = 10.0 * cell;
+  CHECK(!map.has_planes());
+  map.set_metrics();
+  CHECK_THAT(map.level[2 * 100 + 3], Catch::Matchers::WithinAbs(
+    10 + 10 * std::log10(std::abs(cell)), 1e-9));
+  map.get_row(0)[0] = 1;
+  CHECK(!map.has_planes());
+  map.set_metrics();
+  map.get_col(0)[1] = 1;
+  CHECK(!map.has_planes());
+  map.set_metrics();
+  map.set_row(1, std::vector<std::complex<double>>(100, 1));
+  CHECK(!map.has_planes());
+  map.set_metrics();
+  map.data[0] = 2;
+  map.mark_stale();
+  CHECK(!map.has_planes());
+
+  // transpose marks the output stale
+  Map<std::complex<double>> out(100, 32);
+  out.set_metrics();
+  map.transpose(&out);
+  CHECK(!out.has_planes());
+}
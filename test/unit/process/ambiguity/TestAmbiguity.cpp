@@ -176,3 +176,132 @@ TEST_CASE("Process_File", "[process]")
     CHECK_THAT(map->maxPower, Catch::Matchers::WithinAbs(30.2816, 0.001));
     CHECK_THAT(map->noisePower, Catch::Matchers::WithinAbs(76.918, 0.001));
 }
+
+/// @brief Test multithreaded processing matches a single thread.
+TEST_CASE("Process_Threads", "[process]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{300};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.5};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    Ambiguity ambiguity1(delayMin, delayMax, dopplerMin, 
+      dopplerMax, fs, nSamples, true, 1);
+    Ambiguity ambiguity4(delayMin, delayMax, dopplerMin, 
+      dopplerMax, fs, nSamples, true, 4);
+    CHECK(ambiguity4.get_n_threads() == 4);
+
+    IqData x1{nSamples};
+    IqData y1{nSamples};
+    IqData x4{nSamples};
+    IqData y4{nSamples};
+    random_iq(x1);
+    random_iq(y1);
+    for (auto sample : x1.get_data()) {
+      x4.push_back(sample);
+    }
+    for (auto sample : y1.get_data()) {
+      y4.push_back(sample);
+    }
+
+    auto map1{ambiguity1.process(&x1, &y1)};
+    auto map4{ambiguity4.process(&x4, &y4)};
+    REQUIRE(map1->data.size() == map4->data.size());
+    bool isEqual = true;
+    for (size_t i = 0; i < map1->data.size(); i++) {
+      isEqual = isEqual && (map1->data[i] == map4->data[i]);
+    }
+    CHECK(isEqual);
+}
+
+/// @brief Test an asymmetric Doppler window leaves the inputs unchanged.
+TEST_CASE("Process_Asymmetric", "[process]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{300};
+    int32_t dopplerMin{-100};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.5};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    Ambiguity ambiguity(delayMin, delayMax, dopplerMin, 
+      dopplerMax, fs, nSamples);
+    CHECK(ambiguity.get_doppler_middle() == 100);
+
+    IqData x{nSamples};
+    IqData y{nSamples};
+    random_iq(x);
+    random_iq(y);
+    auto xBefore = x.get_data();
+    auto yBefore = y.get_data();
+
+    auto map{ambiguity.process(&x, &y)};
+    map->set_metrics();
+    CHECK(map->maxPower > 0.0);
+    CHECK(x.get_data() == xBefore);
+    CHECK(y.get_data() == yBefore);
+}
+
+/// @brief Test shorter CPI maps from shared range processing.
+TEST_CASE("Process_Resolution", "[process]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{100};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.1};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    Ambiguity ambiguity(delayMin, delayMax, dopplerMin, 
+      dopplerMax, fs, nSamples);
+    CHECK(ambiguity.add_resolution(1) == 1);
+    CHECK(ambiguity.add_resolution(3) == 2);
+    CHECK(ambiguity.get_n_maps() == 3);
+    CHECK(ambiguity.get_map(2)->doppler.size() == 19);
+    CHECK_THAT(ambiguity.get_cpi(2), Catch::Matchers::WithinAbs(19.0 * ambiguity.get_n_corr() / fs, 1e-12));
+
+    // target at 20 bins delay and 100 Hz Doppler
+    int32_t delay{20};
+    double doppler{100};
+    IqData x{nSamples};
+    IqData y{nSamples};
+    random_iq(x);
+    auto xData = x.get_data();
+    for (uint32_t i = 0; i < nSamples; i++)
+    {
+      std::complex<double> sample = i < (uint32_t)delay ? 0 : xData[i - delay];
+      y.push_back(sample * std::polar(1.0, 2 * M_PI * doppler * i / fs));
+    }
+
+    auto map{ambiguity.process(&x, &y)};
+    CHECK(ambiguity.get_map(0) == map);
+    CHECK(ambiguity.get_map(1)->data == map->data);
+
+    // peak in the nearest bin of each map, with gain in proportion to pulses
+    std::vector<double> peak;
+    for (uint32_t k = 0; k < ambiguity.get_n_maps(); k++)
+    {
+      Map<std::complex<double>> *mapK = ambiguity.get_map(k);
+      size_t iMax = 0;
+      for (size_t i = 0; i < mapK->data.size(); i++) {
+        if (std::abs(mapK->data[i]) > std::abs(mapK->data[iMax])) {
+          iMax = i;
+        }
+      }
+      uint32_t nCols = mapK->delay.size();
+      CHECK(mapK->delay[iMax % nCols] == delay);
+      CHECK(std::abs(mapK->doppler[iMax / nCols] - doppler) <= 0.5 / ambiguity.get_cpi(k));
+      peak.push_back(std::abs(mapK->data[iMax]));
+    }
+    double ratio = peak[2] / peak[0];
+    CHECK(ratio > 0.9 * 19.0 / 61.0);
+    CHECK(ratio < 1.1 * 19.0 / 61.0);
+}
@@ -0,0 +1,183 @@
+/// @file TestAmbiguityDirect.cpp
+/// @brief Unit test for AmbiguityDirect.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+#include "process/ambiguity/AmbiguityDirect.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+
+/// @brief Fill reference and surveillance with a delayed, Doppler shifted echo.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @param delay Target delay (samples).
+/// @param doppler Target Doppler (Hz).
+/// @param fs Sampling frequency (Hz).
+/// @return Void.
+void simulate_target(IqData& x, IqData& y, uint32_t delay,
+  double doppler, uint32_t fs)
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 100.0);
+  std::vector<std::complex<double>> ref(x.get_n());
+  for (uint32_t i = 0; i < x.get_n(); i++)
+  {
+    ref[i] = {dist(gen), dist(gen)};
+    x.push_back(ref[i]);
+  }
+  for (uint32_t i = 0; i < y.get_n(); i++)
+  {
+    std::complex<double> echo = (i >= delay) ? ref[i-delay] : 0;
+    echo *= 0.05 * std::exp(std::complex<double>(0, 2 * M_PI * doppler * i / fs));
+    y.push_back(echo + 0.1 * std::complex<double>(dist(gen), dist(gen)));
+  }
+}
+
+/// @brief Find the delay and Doppler bin of the peak cell.
+/// @param map Ambiguity map.
+/// @param delayBin Output delay bin.
+/// @param dopplerBin Output Doppler bin.
+/// @return Peak magnitude.
+template <typename T>
+double find_peak(Map<std::complex<T>> *map, uint32_t &delayBin, uint32_t &dopplerBin)
+{
+  double peak = 0;
+  for (uint32_t i = 0; i < map->get_nRows(); i++)
+  {
+    for (uint32_t j = 0; j < map->get_nCols(); j++)
+    {
+      if (std::abs(map->at(i, j)) > peak)
+      {
+        peak = std::abs(map->at(i, j));
+        dopplerBin = i;
+        delayBin = j;
+      }
+    }
+  }
+  return peak;
+}
+
+/// @brief Test constructor.
+/// @details Check constructor parameters created correctly.
+TEST_CASE("Constructor", "[constructor]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{300};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.5};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    AmbiguityDirect ambiguity(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 4);
+
+    CHECK_THAT(ambiguity.get_cpi(), Catch::Matchers::WithinAbs(tCpi, 0.02));
+    CHECK(ambiguity.get_doppler_middle() == 0);
+    CHECK(ambiguity.get_n_delay_bins() == delayMax + std::abs(delayMin) + 1);
+    CHECK(ambiguity.get_n_doppler_bins() == 301);
+    CHECK(ambiguity.get_n_decimation() == 830);
+    CHECK(ambiguity.get_nfft() == 1204);
+    CHECK(ambiguity.get_n_samples() == 999320);
+}
+
+/// @brief Test constructor with rounded Hamming number FFT length.
+TEST_CASE("Constructor_Round", "[constructor]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{300};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.5};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    AmbiguityDirect ambiguity(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 4, true);
+
+    CHECK(ambiguity.get_n_decimation() == 830);
+    CHECK(ambiguity.get_nfft() == 1200);
+    CHECK(ambiguity.get_n_samples() == 996000);
+}
+
+/// @brief Test constructor without decimation is the direct FFT method.
+TEST_CASE("Constructor_Direct", "[constructor]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{300};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.5};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    AmbiguityDirect ambiguity(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, nSamples);
+
+    CHECK(ambiguity.get_n_decimation() == 1);
+    CHECK(ambiguity.get_nfft() == nSamples);
+    CHECK(ambiguity.get_n_samples() == nSamples);
+}
+
+/// @brief Test a target is placed in the correct delay and Doppler bin.
+TEST_CASE("Process_Target", "[process]")
+{
+    auto dopplerMin = GENERATE(-300, -100);
+    int32_t delayMin{-10};
+    int32_t delayMax{100};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.1};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+    uint32_t delay = 50;
+    double doppler = 120;
+
+    AmbiguityDirect ambiguity(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 4, true, 2);
+    IqData x{nSamples};
+    IqData y{nSamples};
+    simulate_target(x, y, delay, doppler, fs);
+
+    auto map{ambiguity.process(&x, &y)};
+    uint32_t delayBin = 0, dopplerBin = 0;
+    find_peak(map, delayBin, dopplerBin);
+    CHECK(map->delay[delayBin] == (int)delay);
+    CHECK_THAT(map->doppler[dopplerBin], Catch::Matchers::WithinAbs(doppler,
+      0.5 / ambiguity.get_cpi()));
+}
+
+/// @brief Test integration loss at the Doppler window edge is less than batches.
+TEST_CASE("Process_Edge", "[process]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{100};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.1};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    Ambiguity batches(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples);
+    AmbiguityDirect direct(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 4);
+    IqData x{nSamples};
+    IqData y{nSamples};
+    simulate_target(x, y, 50, 290, fs);
+
+    uint32_t delayBin = 0, dopplerBin = 0;
+    double peakBatches = find_peak(batches.process(&x, &y), delayBin, dopplerBin);
+    double peakDirect = find_peak(direct.process(&x, &y), delayBin, dopplerBin);
+    CHECK(20 * std::log10(peakDirect / peakBatches) > 2.0);
+}
@@ -0,0 +1,164 @@
+/// @file TestAmbiguityRoi.cpp
+/// @brief Unit test for AmbiguityRoi.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+#include "process/ambiguity/AmbiguityRoi.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+#include <stdexcept>
+
+/// @brief Fill reference and surveillance with a delayed, Doppler shifted echo.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @param delay Target delay (samples).
+/// @param doppler Target Doppler (Hz).
+/// @param fs Sampling frequency (Hz).
+/// @return Void.
+void simulate_target(IqData& x, IqData& y, uint32_t delay,
+  double doppler, uint32_t fs)
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 100.0);
+  std::vector<std::complex<double>> ref(x.get_n());
+  for (uint32_t i = 0; i < x.get_n(); i++)
+  {
+    ref[i] = {dist(gen), dist(gen)};
+    x.push_back(ref[i]);
+  }
+  for (uint32_t i = 0; i < y.get_n(); i++)
+  {
+    std::complex<double> echo = (i >= delay) ? ref[i-delay] : 0;
+    echo *= 0.05 * std::exp(std::complex<double>(0, 2 * M_PI * doppler * i / fs));
+    y.push_back(echo + 0.1 * std::complex<double>(dist(gen), dist(gen)));
+  }
+}
+
+/// @brief Test constructor.
+/// @details Check the ROI is selected on the full map grid.
+TEST_CASE("Constructor", "[constructor]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{300};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.5};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    AmbiguityRoi ambiguity(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 40, 60, 50, 150);
+
+    CHECK_THAT(ambiguity.get_cpi(), Catch::Matchers::WithinAbs(tCpi, 0.02));
+    CHECK(ambiguity.get_n_pulses() == 301);
+    CHECK(ambiguity.get_n_corr() == 3322);
+    CHECK(ambiguity.get_n_delay_bins() == 21);
+    CHECK(ambiguity.get_n_doppler_bins() == 50);
+    CHECK(ambiguity.is_direct_range());
+    CHECK(!ambiguity.is_direct_doppler());
+
+    CHECK_THROWS_AS(AmbiguityRoi(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 400, 500, 50, 150), std::invalid_argument);
+}
+
+/// @brief Test ROI cells match the full map.
+TEST_CASE("Process_Roi", "[process]")
+{
+    auto method = GENERATE(AmbiguityRoi<>::Method::Fft,
+      AmbiguityRoi<>::Method::Direct);
+
+    int32_t delayMin{-10};
+    int32_t delayMax{100};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.1};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    Ambiguity full(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, true);
+    AmbiguityRoi roi(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, -5, 60, -100, 200, true, 2, method);
+    IqData x{nSamples};
+    IqData y{nSamples};
+    simulate_target(x, y, 50, 120, fs);
+
+    auto mapFull{full.process(&x, &y)};
+    auto mapRoi{roi.process(&x, &y)};
+    REQUIRE(mapRoi->get_nCols() == 66);
+    uint32_t i0 = 0;
+    while (mapFull->doppler[i0] != mapRoi->doppler[0]) {
+      i0++;
+    }
+    double peak = 0;
+    for (auto cell : mapFull->data) {
+      peak = std::max(peak, std::abs(cell));
+    }
+    double error = 0;
+    for (uint32_t i = 0; i < mapRoi->get_nRows(); i++) {
+      for (uint32_t j = 0; j < mapRoi->get_nCols(); j++) {
+        error = std::max(error, std::abs(mapRoi->at(i, j) - mapFull->at(i0 + i, j + 5)));
+      }
+    }
+    CHECK(error / peak < 1e-9);
+}
+
+/// @brief Test zoom refines the Doppler of an off-grid target.
+TEST_CASE("Zoom", "[zoom]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{100};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.1};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+    double doppler = 124.3;
+
+    AmbiguityRoi ambiguity(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 40, 60, 0, 300);
+    IqData x{nSamples};
+    IqData y{nSamples};
+    simulate_target(x, y, 50, doppler, fs);
+    auto map{ambiguity.process(&x, &y)};
+
+    // coarse peak
+    uint32_t iPeak = 0, jPeak = 0;
+    for (uint32_t i = 0; i < map->get_nRows(); i++) {
+      for (uint32_t j = 0; j < map->get_nCols(); j++) {
+        if (std::abs(map->at(i, j)) > std::abs(map->at(iPeak, jPeak))) {
+          iPeak = i;
+          jPeak = j;
+        }
+      }
+    }
+    REQUIRE(map->delay[jPeak] == 50);
+    std::complex<double> coarse = map->at(iPeak, jPeak);
+    double dopplerCoarse = map->doppler[iPeak];
+
+    uint16_t factor = 8;
+    auto mapZoom{ambiguity.zoom(50, dopplerCoarse, 1, 1, factor)};
+    REQUIRE(mapZoom->get_nRows() == 17);
+    REQUIRE(mapZoom->get_nCols() == 3);
+    CHECK(std::abs(mapZoom->at(8, 1) - coarse) / std::abs(coarse) < 1e-9);
+
+    uint32_t iZoom = 0;
+    for (uint32_t i = 0; i < mapZoom->get_nRows(); i++) {
+      if (std::abs(mapZoom->at(i, 1)) > std::abs(mapZoom->at(iZoom, 1))) {
+        iZoom = i;
+      }
+    }
+    CHECK(std::abs(mapZoom->doppler[iZoom] - doppler) < std::abs(dopplerCoarse - doppler));
+    CHECK(std::abs(mapZoom->at(iZoom, 1)) > std::abs(coarse));
+
+    CHECK_THROWS_AS(ambiguity.zoom(80, dopplerCoarse, 1, 1, factor), std::out_of_range);
+}
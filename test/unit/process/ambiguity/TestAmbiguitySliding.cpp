@@ -0,0 +1,99 @@
+/// @file TestAmbiguitySliding.cpp
+/// @brief Unit test for AmbiguitySliding.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/ambiguity/Ambiguity.h"
+#include "process/ambiguity/AmbiguitySliding.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+
+/// @brief Push random samples to the reference and surveillance.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @param n Number of samples to push.
+/// @param gen Random number generator.
+/// @return Void.
+void push_random(IqData& x, IqData& y, uint32_t n, std::mt19937& gen)
+{
+  std::uniform_real_distribution<> dist(-100.0, 100.0);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x.push_back({dist(gen), dist(gen)});
+    y.push_back({dist(gen), dist(gen)});
+  }
+}
+
+/// @brief Test constructor.
+/// @details Check constructor parameters created correctly.
+TEST_CASE("Constructor", "[constructor]")
+{
+    int32_t delayMin{-10};
+    int32_t delayMax{300};
+    int32_t dopplerMin{-300};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.5};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    AmbiguitySliding ambiguity(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 4, true);
+
+    CHECK_THAT(ambiguity.get_cpi(), Catch::Matchers::WithinAbs(tCpi, 0.02));
+    CHECK(ambiguity.get_n_corr() == 3322);
+    CHECK(ambiguity.get_n_doppler_bins() == 301);
+    CHECK(ambiguity.get_nfft() == 6750);
+    CHECK(ambiguity.get_n_step() == 75 * 3322);
+}
+
+/// @brief Test each update matches the batches map of the same window.
+TEST_CASE("Process_Sliding", "[process]")
+{
+    auto dopplerMin = GENERATE(-300, -100);
+    int32_t delayMin{-10};
+    int32_t delayMax{100};
+    int32_t dopplerMax{300};
+
+    uint32_t fs{2'000'000};
+    float tCpi{0.1};
+    uint32_t nSamples = tCpi * fs;    // narrow on purpose
+
+    Ambiguity batches(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, true);
+    AmbiguitySliding sliding(delayMin, delayMax, dopplerMin,
+      dopplerMax, fs, nSamples, 4, true, 2);
+    IqData x{nSamples};
+    IqData y{nSamples};
+    std::mt19937 gen(0);
+    push_random(x, y, nSamples, gen);
+
+    for (uint32_t update = 0; update < 6; update++)
+    {
+      if (update > 0) {
+        push_random(x, y, sliding.get_n_step(), gen);
+      }
+      // reset part way through, as if an update was skipped
+      if (update == 4) {
+        sliding.reset();
+      }
+      auto mapSliding{sliding.process(&x, &y)};
+      auto mapBatches{batches.process(&x, &y)};
+      REQUIRE(mapSliding->data.size() == mapBatches->data.size());
+
+      double error = 0, peak = 0;
+      for (size_t i = 0; i < mapBatches->data.size(); i++) {
+        error = std::max(error, std::abs(std::abs(mapSliding->data[i]) - std::abs(mapBatches->data[i])));
+        peak = std::max(peak, std::abs(mapBatches->data[i]));
+      }
+      CHECK(error / peak < 1e-9);
+      if (dopplerMin == -300) {
+        CHECK(mapSliding->data == mapBatches->data);
+      }
+    }
+}
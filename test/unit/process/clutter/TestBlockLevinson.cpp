@@ -0,0 +1,106 @@
+/// @file TestBlockLevinson.cpp
+/// @brief Unit test for BlockLevinson.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/clutter/BlockLevinson.h"
+
+#include <random>
+#include <complex>
+
+/// @brief Build the first block row of a Hermitian positive definite block Toeplitz matrix.
+/// @details Correlations of m channels of a random signal with multipath, over nSamples.
+/// @param n Number of blocks.
+/// @param m Size of each block.
+/// @param gen Random number generator.
+/// @return First block row.
+std::vector<arma::Mat<std::complex<double>>> block_row(uint32_t n, uint32_t m, std::mt19937 &gen)
+{
+  std::normal_distribution<> dist(0.0, 1.0);
+  uint32_t nSamples = 4000;
+  std::vector<std::vector<std::complex<double>>> u(m, std::vector<std::complex<double>>(nSamples));
+  for (uint32_t d = 0; d < m; d++) {
+    for (uint32_t i = 0; i < nSamples; i++) {
+      u[d][i] = {dist(gen), dist(gen)};
+      if (i >= 2) {
+        u[d][i] += 0.7 * u[d][i - 2];
+      }
+      if (d > 0) {
+        u[d][i] += 0.5 * u[0][i];
+      }
+    }
+  }
+  // block k holds sum_j conj(u_i[j]) u_j[j - k]
+  std::vector<arma::Mat<std::complex<double>>> r(n, arma::Mat<std::complex<double>>(m, m));
+  for (uint32_t k = 0; k < n; k++) {
+    for (uint32_t i = 0; i < m; i++) {
+      for (uint32_t j = 0; j < m; j++) {
+        std::complex<double> sum = 0;
+        for (uint32_t s = 0; s < nSamples; s++) {
+          sum += std::conj(u[i][s]) * u[j][(s + nSamples - k) % nSamples];
+        }
+        r[k](i, j) = sum / (double)nSamples;
+      }
+    }
+  }
+  return r;
+}
+
+/// @brief Test solution satisfies the full block Toeplitz system.
+TEST_CASE("Solve", "[solve]")
+{
+  auto n = GENERATE(1, 2, 17, 60);
+  auto m = GENERATE(1, 3, 5);
+  std::mt19937 gen(n * 10 + m);
+  std::normal_distribution<> dist(0.0, 1.0);
+  std::vector<arma::Mat<std::complex<double>>> r = block_row(n, m, gen);
+  arma::Col<std::complex<double>> b(n * m), w(n * m);
+  for (uint32_t i = 0; i < (uint32_t)(n * m); i++) {
+    b[i] = {dist(gen), dist(gen)};
+  }
+
+  BlockLevinson levinson(n, m);
+  REQUIRE(levinson.solve(r, b, w));
+
+  // residual of A w = b, block (i, j) is r[j-i] or r[i-j]^H
+  double residual = 0, peak = 0;
+  for (int bi = 0; bi < n; bi++) {
+    for (int i = 0; i < m; i++) {
+      std::complex<double> sum = 0;
+      for (int bj = 0; bj < n; bj++) {
+        for (int j = 0; j < m; j++) {
+          std::complex<double> value = bj >= bi ? r[bj - bi](i, j) : std::conj(r[bi - bj](j, i));
+          sum += value * w[bj * m + j];
+        }
+      }
+      residual = std::max(residual, std::abs(sum - b[bi * m + i]));
+      peak = std::max(peak, std::abs(b[bi * m + i]));
+    }
+  }
+  CHECK(residual / peak < 1e-8);
+}
+
+/// @brief Test a singular block row is rejected and the solution unchanged.
+TEST_CASE("Solve_Singular", "[solve]")
+{
+  uint32_t n = 4, m = 2;
+  std::vector<arma::Mat<std::complex<double>>> r(n, arma::Mat<std::complex<double>>(m, m));
+  arma::Col<std::complex<double>> b(n * m), w(n * m);
+  for (uint32_t i = 0; i < n * m; i++) {
+    b[i] = 1;
+    w[i] = 7;
+  }
+
+  // identical channels
+  for (uint32_t i = 0; i < m; i++) {
+    for (uint32_t j = 0; j < m; j++) {
+      r[0](i, j) = 1;
+    }
+  }
+  BlockLevinson levinson(n, m);
+  CHECK(!levinson.solve(r, b, w));
+  CHECK(w[0] == std::complex<double>(7));
+}
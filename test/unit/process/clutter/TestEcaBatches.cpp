@@ -0,0 +1,156 @@
+/// @file TestEcaBatches.cpp
+/// @brief Unit test for EcaBatches.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/clutter/EcaBatches.h"
+
+#include <random>
+#include <complex>
+#include <stdexcept>
+#include <deque>
+
+/// @brief Push a CPI of reference and surveillance with a clutter echo.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @param delay Delay of the clutter echo (samples).
+/// @param gain Echo amplitude in the first and second half of the CPI.
+/// @param gen Random number generator.
+/// @return Void.
+void push_clutter(IqData& x, IqData& y, uint32_t delay,
+  std::pair<double, double> gain, std::mt19937& gen)
+{
+  std::normal_distribution<> dist(0.0, 1.0);
+  uint32_t n = x.get_n();
+  std::vector<std::complex<double>> xData(n);
+  for (auto &sample : xData) {
+    sample = {dist(gen), dist(gen)};
+  }
+  x.clear();
+  y.clear();
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x.push_back(xData[i]);
+    // direct path, a clutter echo and receiver noise
+    std::complex<double> echo = i >= delay ? xData[i - delay] : 0;
+    double g = i < n / 2 ? gain.first : gain.second;
+    y.push_back(xData[i] + g * echo + 0.1 * std::complex<double>(dist(gen), dist(gen)));
+  }
+}
+
+/// @brief Get the mean power of a signal.
+/// @param y Address of IqData object.
+/// @return Mean power.
+double power(IqData& y)
+{
+  double sum = 0;
+  for (const auto &sample : y.get_data()) {
+    sum += std::norm(sample);
+  }
+  return sum / y.get_n();
+}
+
+/// @brief Test static clutter is cancelled for any batch and thread count.
+TEST_CASE("Process_Static", "[process]")
+{
+  auto nBatches = GENERATE(1, 4, 7);
+  auto nThreads = GENERATE(1, 3);
+  uint32_t n = 16384;
+  IqData x{n};
+  IqData y{n};
+  std::mt19937 gen(0);
+  EcaBatches<double> filter(-2, 20, n, nBatches, nThreads);
+
+  push_clutter(x, y, 5, {0.5, 0.5}, gen);
+  double powerIn = power(y);
+  REQUIRE(filter.process(&x, &y));
+  CHECK(10 * std::log10(powerIn / power(y)) > 20);
+  CHECK(y.get_n() == n);
+}
+
+/// @brief Test the clutter estimate is a linear convolution with no wrap from the end of the CPI.
+TEST_CASE("Process_Linear", "[process]")
+{
+  uint32_t n = 2048;
+  int32_t delayMin = -2, delayMax = 20;
+  uint32_t nBins = delayMax - delayMin;
+  IqData x{n};
+  IqData y{n};
+  std::mt19937 gen(2);
+  push_clutter(x, y, 5, {0.5, 0.5}, gen);
+  std::deque<std::complex<double>> xData = x.get_data();
+  std::deque<std::complex<double>> yData = y.get_data();
+
+  EcaBatches<double> filter(delayMin, delayMax, n, 1);
+  REQUIRE(filter.process(&x, &y));
+  arma::cx_vec w = filter.get_weights(0);
+  REQUIRE(w.size() == nBins);
+
+  // reference shifted by delayMin as in the filter
+  std::vector<std::complex<double>> xShift(n);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    xShift[i] = xData[((((int64_t)i - delayMin) % n) + n) % n];
+  }
+
+  // first nBins outputs only see reference samples from the start of the CPI
+  std::deque<std::complex<double>> out = y.get_data();
+  double error = 0;
+  for (uint32_t i = 0; i < nBins; i++)
+  {
+    std::complex<double> clutter = 0;
+    for (uint32_t k = 0; k <= i; k++)
+    {
+      clutter += w[k] * xShift[i - k];
+    }
+    error += std::norm(out[i] - (yData[i] - clutter));
+  }
+  CHECK(error / nBins < 1e-20);
+}
+
+/// @brief Test batches track clutter that changes within the CPI.
+TEST_CASE("Process_Varying", "[process]")
+{
+  uint32_t n = 16384;
+  IqData x{n};
+  IqData y{n};
+  IqData x2{n};
+  IqData y2{n};
+  std::mt19937 gen(0);
+  std::mt19937 gen2(0);
+  EcaBatches<double> single(-2, 20, n, 1);
+  EcaBatches<double> batched(-2, 20, n, 8, 2);
+
+  // same CPI for both filters
+  push_clutter(x, y, 5, {0.5, 1.5}, gen);
+  push_clutter(x2, y2, 5, {0.5, 1.5}, gen2);
+  REQUIRE(single.process(&x, &y));
+  REQUIRE(batched.process(&x2, &y2));
+  CHECK(power(y2) < 0.05);
+  CHECK(power(y2) < 0.1 * power(y));
+}
+
+/// @brief Test single precision cancels static clutter.
+TEST_CASE("Process_Float", "[process]")
+{
+  uint32_t n = 8192;
+  IqData x{n};
+  IqData y{n};
+  std::mt19937 gen(1);
+  EcaBatches<float> filter(-2, 20, n, 4, 2);
+
+  push_clutter(x, y, 5, {0.5, 0.5}, gen);
+  double powerIn = power(y);
+  REQUIRE(filter.process(&x, &y));
+  CHECK(10 * std::log10(powerIn / power(y)) > 20);
+}
+
+/// @brief Test batches shorter than the filter are rejected.
+TEST_CASE("Constructor_Batch", "[constructor]")
+{
+  CHECK_THROWS_AS(EcaBatches<double>(-10, 400, 4000, 16), std::invalid_argument);
+  CHECK_NOTHROW(EcaBatches<double>(-10, 400, 4000, 8));
+}
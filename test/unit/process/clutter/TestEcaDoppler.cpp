@@ -0,0 +1,216 @@
+/// @file TestEcaDoppler.cpp
+/// @brief Unit test for EcaDoppler.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/clutter/EcaDoppler.h"
+#include "process/clutter/WienerHopf.h"
+
+#include <random>
+#include <complex>
+#include <stdexcept>
+
+/// @brief Push a CPI of reference and surveillance with Doppler shifted clutter.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @param delay Delay of the clutter echo (samples).
+/// @param doppler Doppler of the clutter echo (CPI bins).
+/// @param seed Random number generator seed.
+/// @return Void.
+void push_clutter(IqData& x, IqData& y, uint32_t delay, double doppler, uint32_t seed)
+{
+  std::mt19937 gen(seed);
+  std::normal_distribution<> dist(0.0, 1.0);
+  uint32_t n = x.get_n();
+  std::vector<std::complex<double>> xData(n);
+  for (auto &sample : xData) {
+    sample = {dist(gen), dist(gen)};
+  }
+  x.clear();
+  y.clear();
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x.push_back(xData[i]);
+    // direct path, a moving clutter echo and receiver noise
+    std::complex<double> echo = i >= delay ? xData[i - delay] : 0;
+    echo *= std::polar(1.0, 2 * M_PI * doppler * i / n);
+    y.push_back(xData[i] + 0.5 * echo + 0.1 * std::complex<double>(dist(gen), dist(gen)));
+  }
+}
+
+/// @brief Get the mean power of a signal.
+/// @param y Address of IqData object.
+/// @return Mean power.
+double power(IqData& y)
+{
+  double sum = 0;
+  for (const auto &sample : y.get_data()) {
+    sum += std::norm(sample);
+  }
+  return sum / y.get_n();
+}
+
+/// @brief Test Doppler shifted clutter is cancelled where zero Doppler is not.
+TEST_CASE("Process_Doppler", "[process]")
+{
+  uint32_t n = 16384;
+  uint32_t fs = n;
+  IqData x{n};
+  IqData y{n};
+  IqData x2{n};
+  IqData y2{n};
+  push_clutter(x, y, 5, 2, 0);
+  push_clutter(x2, y2, 5, 2, 0);
+  double powerIn = power(y);
+
+  EcaDoppler<double> filter(-2, 20, n, fs, {-2, -1, 1, 2});
+  WienerHopf<double> zero(-2, 20, n);
+  REQUIRE(filter.process(&x, &y));
+  REQUIRE(zero.process(&x2, &y2));
+
+  CHECK(filter.get_shift() == std::vector<int32_t>{-2, -1, 0, 1, 2});
+  CHECK(10 * std::log10(powerIn / power(y)) > 20);
+  CHECK(power(y) < 0.1 * power(y2));
+
+  // one FFT of each signal, 9 shift differences, 5 cross-correlations and 4 shifted references
+  EcaDoppler<double>::Cost cost = filter.get_cost();
+  CHECK(cost.nFft == 2 + 9 + 5 + 4);
+  CHECK(cost.solve >= 0);
+}
+
+/// @brief Test zero Doppler matches the WienerHopf filter.
+TEST_CASE("Process_Zero", "[process]")
+{
+  uint32_t n = 8192;
+  IqData x{n};
+  IqData y{n};
+  IqData x2{n};
+  IqData y2{n};
+  push_clutter(x, y, 7, 0, 1);
+  push_clutter(x2, y2, 7, 0, 1);
+
+  EcaDoppler<double> filter(-2, 20, n, n, {});
+  WienerHopf<double> zero(-2, 20, n);
+  REQUIRE(filter.process(&x, &y));
+  REQUIRE(zero.process(&x2, &y2));
+  CHECK(filter.get_shift() == std::vector<int32_t>{0});
+  CHECK_THAT(power(y), Catch::Matchers::WithinRel(power(y2), 0.05));
+}
+
+/// @brief Test the filter matches with a cached reference spectrum.
+TEST_CASE("Process_Cached", "[process]")
+{
+  uint32_t n = 8192;
+  IqData x{n};
+  IqData y{n};
+  IqData x2{n};
+  IqData y2{n};
+  push_clutter(x, y, 3, 1, 2);
+  push_clutter(x2, y2, 3, 1, 2);
+  ReferenceSpectrum<double> reference(n);
+  reference.process(&x2);
+
+  EcaDoppler<double> filter(-4, 10, n, n, {-1, 1});
+  EcaDoppler<double> cached(-4, 10, n, n, {-1, 1});
+  REQUIRE(filter.process(&x, &y));
+  REQUIRE(cached.process(&x2, &y2, &reference));
+  CHECK(cached.get_cost().nFft == filter.get_cost().nFft - 1);
+
+  std::deque<std::complex<double>> out1 = y.get_data();
+  std::deque<std::complex<double>> out2 = y2.get_data();
+  double error = 0;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    error += std::norm(out1[i] - out2[i]);
+  }
+  CHECK(error / n / power(y) < 1e-12);
+}
+
+/// @brief Test the weights match a dense least squares solve, and the filter is a linear convolution.
+TEST_CASE("Process_Dense", "[process]")
+{
+  uint32_t n = 128;
+  int32_t delayMin = -2, delayMax = 4;
+  uint32_t nBins = delayMax - delayMin;
+  IqData x{n};
+  IqData y{n};
+  push_clutter(x, y, 3, 1, 3);
+  std::deque<std::complex<double>> xData = x.get_data();
+  std::deque<std::complex<double>> yData = y.get_data();
+
+  EcaDoppler<double> filter(delayMin, delayMax, n, n, {-1, 1});
+  REQUIRE(filter.process(&x, &y));
+  std::vector<int32_t> shift = filter.get_shift();
+  uint32_t nShifts = shift.size();
+
+  // reference shifted by delayMin and each Doppler shift
+  std::vector<std::vector<std::complex<double>>> xShift(nShifts, 
+    std::vector<std::complex<double>>(n));
+  for (uint32_t d = 0; d < nShifts; d++)
+  {
+    for (uint32_t i = 0; i < n; i++)
+    {
+      xShift[d][i] = xData[((((int64_t)i - delayMin) % n) + n) % n] * 
+        std::polar(1.0, 2 * M_PI * shift[d] * (double)i / n);
+    }
+  }
+
+  // dense least squares over the circular correlations the weights are solved from
+  arma::cx_mat A(n, nBins * nShifts);
+  arma::cx_vec b(n);
+  for (uint32_t i = 0; i < n; i++)
+  {
+    b[i] = yData[i];
+    for (uint32_t k = 0; k < nBins; k++)
+    {
+      for (uint32_t d = 0; d < nShifts; d++)
+      {
+        A(i, k * nShifts + d) = xShift[d][(i + n - k) % n];
+      }
+    }
+  }
+  arma::cx_mat AH = arma::trans(A);
+  arma::cx_mat R = AH * A;
+  arma::cx_vec r = AH * b;
+  arma::cx_vec wDense;
+  REQUIRE(arma::solve(wDense, R, r));
+  arma::cx_vec w = filter.get_weights();
+  REQUIRE(w.size() == wDense.size());
+  double errorW = 0, powerW = 0;
+  for (uint32_t k = 0; k < w.size(); k++)
+  {
+    errorW += std::norm(w[k] - wDense[k]);
+    powerW += std::norm(wDense[k]);
+  }
+  CHECK(errorW < 1e-16 * powerW);
+
+  // clutter is subtracted by linear convolution, no wrap from the end of the CPI
+  std::deque<std::complex<double>> out = y.get_data();
+  double error = 0;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    std::complex<double> clutter = 0;
+    for (uint32_t k = 0; k <= std::min(i, nBins - 1); k++)
+    {
+      for (uint32_t d = 0; d < nShifts; d++)
+      {
+        clutter += w[k * nShifts + d] * xShift[d][i - k];
+      }
+    }
+    error += std::norm(out[i] - (yData[i] - clutter));
+  }
+  CHECK(error / n < 1e-20);
+}
+
+/// @brief Test Doppler shifts are rounded to CPI bins and checked.
+TEST_CASE("Constructor_Shift", "[constructor]")
+{
+  uint32_t n = 4000, fs = 2000;
+  EcaDoppler<float> filter(-2, 20, n, fs, {0.4, 0.6, -1.1, 1});
+  CHECK(filter.get_shift() == std::vector<int32_t>{-2, 0, 1, 2});
+  CHECK_THROWS_AS(EcaDoppler<double>(0, 0, n, fs, {}), std::invalid_argument);
+  CHECK_THROWS_AS(EcaDoppler<double>(-2, 20, n, fs, {1000}), std::invalid_argument);
+}
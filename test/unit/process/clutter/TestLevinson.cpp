@@ -0,0 +1,102 @@
+/// @file TestLevinson.cpp
+/// @brief Unit test for Levinson.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/clutter/Levinson.h"
+
+#include <random>
+#include <complex>
+
+/// @brief Compute the first row of the autocorrelation matrix of a random signal.
+/// @param n Number of lags.
+/// @param nSamples Number of samples.
+/// @param gen Random number generator.
+/// @return First row of the autocorrelation matrix, as in WienerHopf.
+arma::Col<std::complex<double>> random_autocorrelation(uint32_t n, uint32_t nSamples, std::mt19937& gen)
+{
+  std::normal_distribution<> dist(0.0, 1.0);
+  std::vector<std::complex<double>> x(nSamples);
+  for (auto &sample : x) {
+    sample = {dist(gen), dist(gen)};
+  }
+  // direct path and a few strong multipath echoes, as seen by the clutter filter
+  for (uint32_t i = nSamples; i-- > 3;) {
+    x[i] += 0.8 * x[i - 1] + std::complex<double>(0.3, -0.4) * x[i - 3];
+  }
+
+  arma::Col<std::complex<double>> a(n);
+  for (uint32_t k = 0; k < n; k++)
+  {
+    std::complex<double> sum = 0;
+    for (uint32_t i = 0; i < nSamples; i++) {
+      sum += x[i] * std::conj(x[(i + k) % nSamples]);
+    }
+    a[k] = sum / (double)nSamples;
+  }
+  return a;
+}
+
+/// @brief Test weights match a dense solve of the Hermitian Toeplitz system.
+TEST_CASE("Solve", "[levinson]")
+{
+  uint32_t n = GENERATE(1, 2, 17, 100);
+  std::mt19937 gen(n);
+  std::normal_distribution<> dist(0.0, 1.0);
+
+  arma::Col<std::complex<double>> a = random_autocorrelation(n, 4000, gen);
+  arma::Col<std::complex<double>> b(n);
+  for (uint32_t i = 0; i < n; i++) {
+    b[i] = {dist(gen), dist(gen)};
+  }
+
+  // dense matrix as built for the Cholesky solve
+  arma::Mat<std::complex<double>> A = arma::toeplitz(a);
+  for (uint32_t i = 0; i < n; i++) {
+    for (uint32_t j = 0; j < i; j++) {
+      A(i, j) = std::conj(A(i, j));
+    }
+  }
+
+  Levinson levinson(n);
+  arma::Col<std::complex<double>> w(n);
+  REQUIRE(levinson.solve(a, b, w));
+
+  // residual of A w = b relative to b
+  double residual = 0, norm = 0;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    std::complex<double> sum = 0;
+    for (uint32_t j = 0; j < n; j++) {
+      sum += A(i, j) * w[j];
+    }
+    residual += std::norm(sum - b[i]);
+    norm += std::norm(b[i]);
+  }
+  CHECK(std::sqrt(residual / norm) < 1e-9);
+}
+
+/// @brief Test a singular system fails and leaves the weights unchanged.
+TEST_CASE("Solve_Singular", "[levinson]")
+{
+  uint32_t n = 4;
+  arma::Col<std::complex<double>> a(n);
+  arma::Col<std::complex<double>> b(n);
+  arma::Col<std::complex<double>> w(n);
+  for (uint32_t i = 0; i < n; i++) {
+    a[i] = 1;
+    b[i] = 1;
+    w[i] = 7;
+  }
+
+  Levinson levinson(n);
+  CHECK(!levinson.solve(a, b, w));
+  a[0] = 0;
+  CHECK(!levinson.solve(a, b, w));
+  for (uint32_t i = 0; i < n; i++) {
+    CHECK(w[i] == std::complex<double>(7));
+  }
+}
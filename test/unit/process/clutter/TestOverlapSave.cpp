@@ -0,0 +1,91 @@
+/// @file TestOverlapSave.cpp
+/// @brief Unit test for OverlapSave.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/clutter/OverlapSave.h"
+
+#include <random>
+#include <complex>
+
+/// @brief Convolve directly in double precision.
+/// @param x Signal.
+/// @param w Filter taps.
+/// @return Filtered signal, the length of x.
+std::vector<std::complex<double>> convolve(const std::vector<std::complex<double>> &x, 
+  const arma::Col<std::complex<double>> &w)
+{
+  std::vector<std::complex<double>> out(x.size(), 0);
+  for (size_t i = 0; i < x.size(); i++) {
+    for (size_t k = 0; k < (size_t)w.size() && k <= i; k++) {
+      out[i] += w[k] * x[i - k];
+    }
+  }
+  return out;
+}
+
+/// @brief Test output matches direct convolution for direct and block filters.
+TEST_CASE("Apply", "[apply]")
+{
+  auto nTaps = GENERATE(1, 5, 16, 17, 64, 411);
+  auto nSamples = GENERATE(3000, 10007);
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 1.0);
+  std::vector<std::complex<double>> x(nSamples), out(nSamples);
+  arma::Col<std::complex<double>> w(nTaps);
+  for (auto &sample : x) {
+    sample = {dist(gen), dist(gen)};
+  }
+  for (uint32_t k = 0; k < (uint32_t)nTaps; k++) {
+    w[k] = {dist(gen), dist(gen)};
+  }
+
+  OverlapSave convolution(nTaps, nSamples);
+  CHECK((convolution.get_n_block() == 0) == (nTaps <= (int)OverlapSave<double>::N_DIRECT_MAX));
+  convolution.set_weights(w);
+  convolution.apply(x.data(), out.data());
+
+  std::vector<std::complex<double>> expected = convolve(x, w);
+  double difference = 0;
+  for (int i = 0; i < nSamples; i++) {
+    difference = std::max(difference, std::abs(out[i] - expected[i]));
+  }
+  CHECK(difference < 1e-9 * nTaps);
+}
+
+/// @brief Test weights can be changed, and single precision is close.
+TEST_CASE("Set_Weights", "[weights]")
+{
+  uint32_t nTaps = 100, nSamples = 5000;
+  std::mt19937 gen(1);
+  std::normal_distribution<> dist(0.0, 1.0);
+  std::vector<std::complex<double>> x(nSamples);
+  std::vector<std::complex<float>> xFloat(nSamples), out(nSamples);
+  arma::Col<std::complex<double>> w(nTaps);
+  arma::Col<std::complex<float>> wFloat(nTaps);
+  for (uint32_t i = 0; i < nSamples; i++) {
+    x[i] = {dist(gen), dist(gen)};
+    xFloat[i] = std::complex<float>(x[i]);
+  }
+
+  OverlapSave<float> convolution(nTaps, nSamples);
+  for (uint32_t j = 0; j < 2; j++)
+  {
+    for (uint32_t k = 0; k < nTaps; k++) {
+      w[k] = {dist(gen), dist(gen)};
+      wFloat[k] = std::complex<float>(w[k]);
+    }
+    convolution.set_weights(wFloat);
+    convolution.apply(xFloat.data(), out.data());
+
+    std::vector<std::complex<double>> expected = convolve(x, w);
+    double difference = 0;
+    for (uint32_t i = 0; i < nSamples; i++) {
+      difference = std::max(difference, std::abs(std::complex<double>(out[i]) - expected[i]));
+    }
+    CHECK(difference < 1e-3);
+  }
+}
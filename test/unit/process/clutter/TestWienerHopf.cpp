@@ -0,0 +1,85 @@
+/// @file TestWienerHopf.cpp
+/// @brief Unit test for WienerHopf.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/clutter/WienerHopf.h"
+
+#include <random>
+#include <complex>
+
+/// @brief Push a CPI of reference and surveillance with static clutter.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @param delay Delay of the clutter echo (samples).
+/// @param gen Random number generator.
+/// @return Void.
+void push_clutter(IqData& x, IqData& y, uint32_t delay, std::mt19937& gen)
+{
+  std::normal_distribution<> dist(0.0, 1.0);
+  uint32_t n = x.get_n();
+  std::vector<std::complex<double>> xData(n);
+  for (auto &sample : xData) {
+    sample = {dist(gen), dist(gen)};
+  }
+  x.clear();
+  y.clear();
+  for (uint32_t i = 0; i < n; i++)
+  {
+    x.push_back(xData[i]);
+    // direct path, a clutter echo and receiver noise
+    std::complex<double> echo = i >= delay ? xData[i - delay] : 0;
+    y.push_back(xData[i] + 0.5 * echo + 0.1 * std::complex<double>(dist(gen), dist(gen)));
+  }
+}
+
+/// @brief Test weights are solved every CPI without a threshold.
+TEST_CASE("Process_Solve", "[process]")
+{
+  uint32_t n = 16384;
+  IqData x{n};
+  IqData y{n};
+  std::mt19937 gen(0);
+  WienerHopf filter(-2, 20, n);
+
+  for (uint32_t i = 0; i < 3; i++)
+  {
+    push_clutter(x, y, 5, gen);
+    REQUIRE(filter.process(&x, &y));
+    CHECK(filter.is_solved());
+    CHECK(filter.get_cancellation() > 20);
+  }
+}
+
+/// @brief Test weights are reused for static clutter and solved on change.
+TEST_CASE("Process_Reuse", "[process]")
+{
+  auto forget = GENERATE(0.0, 0.5);
+  uint32_t n = 16384;
+  IqData x{n};
+  IqData y{n};
+  std::mt19937 gen(0);
+  WienerHopf<double> filter(-2, 20, n, nullptr, 1.0, forget);
+
+  push_clutter(x, y, 5, gen);
+  REQUIRE(filter.process(&x, &y));
+  CHECK(filter.is_solved());
+
+  // same clutter, previous weights still cancel it
+  push_clutter(x, y, 5, gen);
+  REQUIRE(filter.process(&x, &y));
+  CHECK(!filter.is_solved());
+  double power = 0;
+  for (const auto &sample : y.get_data()) {
+    power += std::norm(sample);
+  }
+  CHECK(power / n < 0.03);
+
+  // clutter moved, weights are solved again
+  push_clutter(x, y, 9, gen);
+  REQUIRE(filter.process(&x, &y));
+  CHECK(filter.is_solved());
+}
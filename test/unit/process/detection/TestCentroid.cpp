@@ -0,0 +1,167 @@
+/// @file TestCentroid.cpp
+/// @brief Unit test for Centroid.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/detection/Centroid.h"
+
+#include <random>
+#include <vector>
+
+/// @brief Reference centroid comparing every pair of detections.
+/// @param x Detections.
+/// @param nDelay Number of delay bins to check.
+/// @param nDoppler Number of Doppler bins to check.
+/// @param resolutionDoppler Doppler resolution (Hz).
+/// @return Centroided detections.
+Detection centroid_direct(Detection &x, int nDelay, int nDoppler, double resolutionDoppler)
+{
+  std::vector<double> delay = x.get_delay();
+  std::vector<double> doppler = x.get_doppler();
+  std::vector<double> snr = x.get_snr();
+  std::vector<double> delay2, doppler2, snr2;
+  for (size_t i = 0; i < snr.size(); i++)
+  {
+    int delayMin = (int)(delay[i]) - nDelay;
+    int delayMax = (int)(delay[i]) + nDelay;
+    double dopplerMin = doppler[i] - (nDoppler * resolutionDoppler);
+    double dopplerMax = doppler[i] + (nDoppler * resolutionDoppler);
+    bool isCentroid = true;
+    for (size_t j = 0; j < snr.size(); j++)
+    {
+      if (j != i && delay[j] > delayMin && delay[j] < delayMax &&
+        doppler[j] > dopplerMin && doppler[j] < dopplerMax && snr[i] < snr[j])
+      {
+        isCentroid = false;
+        break;
+      }
+    }
+    if (isCentroid)
+    {
+      delay2.push_back(delay[i]);
+      doppler2.push_back(doppler[i]);
+      snr2.push_back(snr[i]);
+    }
+  }
+  return Detection(delay2, doppler2, snr2);
+}
+
+/// @brief Create detections clustered around targets on the map grid.
+/// @param n Number of detections.
+/// @param resolutionDoppler Doppler resolution (Hz).
+/// @param gen Random number generator.
+/// @return Detections.
+Detection create_detections(size_t n, double resolutionDoppler, std::mt19937 &gen)
+{
+  std::uniform_int_distribution<int> target(-10, 400);
+  std::uniform_int_distribution<int> targetDoppler(-100, 100);
+  std::normal_distribution<double> spread(0, 3);
+  std::uniform_real_distribution<double> uniform(5, 30);
+  std::vector<double> delay, doppler, snr;
+  while (delay.size() < n)
+  {
+    int d = target(gen);
+    int f = targetDoppler(gen);
+    for (int k = 0; k < 20 && delay.size() < n; k++)
+    {
+      delay.push_back(d + std::lround(spread(gen)));
+      doppler.push_back((f + std::lround(spread(gen))) * resolutionDoppler);
+      snr.push_back(std::round(uniform(gen)));
+    }
+  }
+  return Detection(delay, doppler, snr);
+}
+
+/// @brief Test the grid matches comparing every pair.
+TEST_CASE("Process_Window", "[process]")
+{
+  auto nCentroid = GENERATE(1, 2, 6);
+  auto n = GENERATE(10, 1000, 5000);
+  std::mt19937 gen(n);
+  double resolutionDoppler = 1 / 0.3;
+  Detection x = create_detections(n, resolutionDoppler, gen);
+  Centroid centroid(nCentroid, nCentroid, resolutionDoppler);
+
+  Detection y;
+  centroid.process(&x, &y);
+  Detection reference = centroid_direct(x, nCentroid, nCentroid, resolutionDoppler);
+  CHECK(y.get_nDetections() <= x.get_nDetections());
+  CHECK(y.get_delay() == reference.get_delay());
+  CHECK(y.get_doppler() == reference.get_doppler());
+  CHECK(y.get_snr() == reference.get_snr());
+}
+
+/// @brief Test detections near zero delay are compared with neighbours.
+TEST_CASE("Process_Window_Edge", "[process]")
+{
+  Detection x({-3, -2, 2, 3}, {0, 0, 0, 0}, {10, 12, 9, 8});
+  Centroid centroid(6, 6, 1);
+
+  Detection y;
+  centroid.process(&x, &y);
+  REQUIRE(y.get_nDetections() == 1);
+  CHECK(y.get_delay()[0] == -2);
+}
+
+/// @brief Test one detection is kept per group of adjacent cells.
+TEST_CASE("Process_Component", "[process]")
+{
+  double resolutionDoppler = 2;
+  // an L-shaped group, a diagonal pair and an isolated cell
+  Detection x({10, 11, 12, 12, 20, 21, 30}, {0, 0, 0, 2, 4, 6, 0}, 
+    {5, 9, 7, 6, 3, 4, 8});
+  Centroid centroid(6, 6, resolutionDoppler, Centroid::Mode::Component);
+
+  Detection y;
+  centroid.process(&x, &y);
+  CHECK(y.get_delay() == std::vector<double>{11, 21, 30});
+  CHECK(y.get_snr() == std::vector<double>{9, 4, 8});
+}
+
+/// @brief Test components for negative delay and Doppler, and no Doppler resolution.
+TEST_CASE("Process_Component_Negative", "[process]")
+{
+  double resolutionDoppler = 2;
+  Detection x({-3, -2, -10, 5}, {-4, -4, 6, -2}, {5, 9, 7, 6});
+  Centroid centroid(6, 6, resolutionDoppler, Centroid::Mode::Component);
+
+  Detection y;
+  centroid.process(&x, &y);
+  CHECK(y.get_delay() == std::vector<double>{-2, -10, 5});
+  CHECK(y.get_snr() == std::vector<double>{9, 7, 6});
+
+  // no cells to connect, so every detection is kept
+  Centroid centroidZero(6, 6, 0, Centroid::Mode::Component);
+  centroidZero.process(&x, &y);
+  CHECK(y.get_nDetections() == x.get_nDetections());
+}
+
+/// @brief Test components are labelled for many detections.
+TEST_CASE("Process_Component_Many", "[process]")
+{
+  std::mt19937 gen(1);
+  double resolutionDoppler = 1 / 0.3;
+  Detection x = create_detections(20000, resolutionDoppler, gen);
+  Centroid centroid(6, 6, resolutionDoppler, Centroid::Mode::Component);
+
+  Detection y;
+  centroid.process(&x, &y);
+  CHECK(y.get_nDetections() > 0);
+  CHECK(y.get_nDetections() < x.get_nDetections());
+
+  // no two kept detections are adjacent
+  std::vector<double> delay = y.get_delay();
+  std::vector<double> doppler = y.get_doppler();
+  size_t nAdjacent = 0;
+  for (size_t i = 0; i < delay.size(); i++)
+  {
+    for (size_t j = i + 1; j < delay.size(); j++)
+    {
+      nAdjacent += std::abs(delay[i] - delay[j]) <= 1 && 
+        std::abs(doppler[i] - doppler[j]) <= 1.01 * resolutionDoppler;
+    }
+  }
+  CHECK(nAdjacent == 0);
+}
@@ -0,0 +1,158 @@
+/// @file TestCfarDetector1D.cpp
+/// @brief Unit test for CfarDetector1D.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/detection/CfarDetector1D.h"
+#include "data/Map.h"
+#include "helper/TestHelper.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+#include <limits>
+
+/// @brief Reference CFAR summing the training cells of every cell directly.
+/// @param x Map to process.
+/// @param pfa Probability of false alarm.
+/// @param nGuard Number of guard cells.
+/// @param nTrain Number of training cells.
+/// @param minDelay Minimum delay to process detections (bins).
+/// @param minDoppler Minimum absolute Doppler to process detections (Hz).
+/// @return Detections.
+template <typename T>
+Detection cfar_direct(const Map<std::complex<T>> &x, double pfa, int nGuard, 
+  int nTrain, int minDelay, double minDoppler)
+{
+  int nDelayBins = x.get_nCols();
+  std::vector<double> delay, doppler, snr;
+  for (int i = 0; i < (int)x.get_nRows(); i++)
+  {
+    if (std::abs(x.doppler[i]) < minDoppler)
+    {
+      continue;
+    }
+    std::vector<double> power(nDelayBins);
+    for (int j = 0; j < nDelayBins; j++)
+    {
+      power[j] = (double) std::abs(x.at(i, j) * x.at(i, j));
+    }
+    for (int j = 0; j < nDelayBins; j++)
+    {
+      if (x.delay[j] < minDelay)
+      {
+        continue;
+      }
+      std::vector<int> iTrain;
+      for (int k = j-nGuard-nTrain; k < j-nGuard; k++)
+      {
+        if (k > 0 && k < nDelayBins)
+        {
+          iTrain.push_back(k);
+        }
+      }
+      for (int k = j+nGuard+1; k < j+nGuard+nTrain+1; k++)
+      {
+        if (k >= 0 && k < nDelayBins)
+        {
+          iTrain.push_back(k);
+        }
+      }
+      int nCells = iTrain.size();
+      double alpha = nCells * (pow(pfa, -1.0 / nCells) - 1);
+      double trainNoise = 0.0;
+      for (int k : iTrain)
+      {
+        trainNoise += power[k];
+      }
+      trainNoise /= nCells;
+      if (power[j] > alpha * trainNoise)
+      {
+        delay.push_back(j + x.delay[0]);
+        doppler.push_back(x.doppler[i]);
+        snr.push_back((double)10 * std::log10(std::abs(x.at(i, j))) - x.noisePower);
+      }
+    }
+  }
+  return Detection(delay, doppler, snr);
+}
+
+/// @brief Test sliding sums match direct sums for double.
+TEST_CASE("Process_Double", "[process]")
+{
+  auto nThreads = GENERATE(1, 3);
+  auto nGuard = GENERATE(0, 2);
+  std::mt19937 gen(1);
+  Map<std::complex<double>> map = create_map<double>(64, 200, gen, -2);
+  add_targets(map, gen, 0.02, 6);
+  CfarDetector1D cfar(1e-3, nGuard, 6, 0, 3, nThreads);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  Detection reference = cfar_direct(map, 1e-3, nGuard, 6, 0, 3);
+  CHECK(detection.get_nDetections() > 0);
+  check_identical(detection, reference, TOLERANCE_SNR_DOUBLE);
+}
+
+/// @brief Test sliding sums match direct sums for float.
+TEST_CASE("Process_Float", "[process]")
+{
+  auto nThreads = GENERATE(1, 3);
+  std::mt19937 gen(2);
+  Map<std::complex<float>> map = create_map<float>(64, 200, gen, -2);
+  add_targets(map, gen, 0.02, 6);
+  CfarDetector1D cfar(1e-3, 2, 6, 0, 3, nThreads);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  Detection reference = cfar_direct(map, 1e-3, 2, 6, 0, 3);
+  CHECK(detection.get_nDetections() > 0);
+  check_identical(detection, reference, TOLERANCE_SNR_FLOAT);
+}
+
+/// @brief Test cells at the threshold and non-finite cells.
+TEST_CASE("Process_Edge", "[process]")
+{
+  std::mt19937 gen(3);
+  Map<std::complex<double>> map = create_map<double>(8, 64, gen, -2);
+  add_targets(map, gen, 0.02, 6);
+  // power exactly at the threshold of a constant row
+  double pfa = 1e-3;
+  double alpha = 12 * (pow(pfa, -1.0 / 12) - 1);
+  for (uint32_t j = 0; j < 64; j++)
+  {
+    map.at(0, j) = 1;
+    map.at(1, j) = 1e-8;
+  }
+  map.at(0, 30) = std::sqrt(alpha);
+  map.at(1, 20) = 1e8;
+  map.at(2, 10) = std::numeric_limits<double>::infinity();
+  map.at(3, 40) = std::numeric_limits<double>::quiet_NaN();
+  CfarDetector1D cfar(pfa, 2, 6, 0, 0, 2);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  Detection reference = cfar_direct(map, pfa, 2, 6, 0, 0);
+  check_identical(detection, reference, TOLERANCE_SNR_DOUBLE);
+}
+
+/// @brief Test minimum delay and Doppler are skipped.
+TEST_CASE("Process_Minimum", "[process]")
+{
+  std::mt19937 gen(4);
+  Map<std::complex<double>> map = create_map<double>(32, 100, gen, -2);
+  add_targets(map, gen, 0.02, 6);
+  CfarDetector1D cfar(1e-2, 1, 4, 5, 15, 2);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  Detection reference = cfar_direct(map, 1e-2, 1, 4, 5, 15);
+  check_identical(detection, reference, TOLERANCE_SNR_DOUBLE);
+  for (size_t i = 0; i < detection.get_nDetections(); i++)
+  {
+    CHECK(detection.get_delay()[i] >= 5);
+    CHECK(std::abs(detection.get_doppler()[i]) >= 15);
+  }
+}
@@ -0,0 +1,161 @@
+/// @file TestCfarDetector2D.cpp
+/// @brief Unit test for CfarDetector2D.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/detection/CfarDetector2D.h"
+#include "process/detection/CfarDetector1D.h"
+#include "data/Map.h"
+#include "helper/TestHelper.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+#include <stdexcept>
+
+using Mode = CfarDetector2D::Mode;
+using Window = CfarDetector2D::Window;
+
+/// @brief Reference 2D CFAR visiting every training cell directly.
+/// @param x Map to process.
+/// @param pfa Probability of false alarm.
+/// @param gR Number of guard cells in delay.
+/// @param gD Number of guard cells in Doppler.
+/// @param tR Number of training cells in delay.
+/// @param tD Number of training cells in Doppler.
+/// @param mode Estimate of the noise.
+/// @param window Shape of the training window.
+/// @return Detections.
+Detection cfar_direct(const Map<std::complex<double>> &x, double pfa, int gR, 
+  int gD, int tR, int tD, Mode mode, Window window)
+{
+  int nRows = x.get_nRows();
+  int nCols = x.get_nCols();
+  std::vector<double> delay, doppler, snr;
+  for (int i = 0; i < nRows; i++)
+  {
+    for (int j = 0; j < nCols; j++)
+    {
+      double lead = 0, lag = 0, centre = 0;
+      int nLead = 0, nLag = 0, nCentre = 0;
+      for (int di = -gD - tD; di <= gD + tD; di++)
+      {
+        for (int dj = -gR - tR; dj <= gR + tR; dj++)
+        {
+          int k = i + di, l = j + dj;
+          if (k < 0 || k >= nRows || l < 0 || l >= nCols)
+          {
+            continue;
+          }
+          bool isGuard = std::abs(di) <= gD && std::abs(dj) <= gR;
+          bool isArm = std::abs(di) <= gD || std::abs(dj) <= gR;
+          if (isGuard || (window == Window::Cross && !isArm))
+          {
+            continue;
+          }
+          double p = std::norm(x.at(k, l));
+          if (dj < -gR) { lead += p; nLead++; }
+          else if (dj > gR) { lag += p; nLag++; }
+          else { centre += p; nCentre++; }
+        }
+      }
+      int nCells = nLead + nLag + nCentre;
+      double noise = (lead + lag + centre) / nCells;
+      if (mode != Mode::Ca)
+      {
+        double a = nLead + nCentre > 0 ? (lead + centre) / (nLead + nCentre) : 0;
+        double b = nLag + nCentre > 0 ? (lag + centre) / (nLag + nCentre) : 0;
+        bool isLead = (nLag + nCentre == 0) || (nLead + nCentre > 0 && 
+          ((mode == Mode::Go) == (a >= b)));
+        noise = isLead ? a : b;
+        nCells = isLead ? nLead + nCentre : nLag + nCentre;
+      }
+      double alpha = nCells * (pow(pfa, -1.0 / nCells) - 1);
+      if (std::norm(x.at(i, j)) > alpha * noise)
+      {
+        delay.push_back(j + x.delay[0]);
+        doppler.push_back(x.doppler[i]);
+        snr.push_back(10 * std::log10(std::abs(x.at(i, j))) - x.noisePower);
+      }
+    }
+  }
+  return Detection(delay, doppler, snr);
+}
+
+/// @brief Test summed-area table matches direct training sums.
+TEST_CASE("Process_Direct", "[process]")
+{
+  auto mode = GENERATE(Mode::Ca, Mode::Go, Mode::So);
+  auto window = GENERATE(Window::Rectangle, Window::Cross);
+  auto nThreads = GENERATE(1, 3);
+  std::mt19937 gen(1);
+  Map<std::complex<double>> map = create_map<double>(40, 120, gen);
+  add_targets(map, gen, 0.01, 3);
+  CfarDetector2D cfar(1e-3, 2, 1, 5, 3, mode, window, 0, 0, nThreads);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  Detection reference = cfar_direct(map, 1e-3, 2, 1, 5, 3, mode, window);
+  CHECK(detection.get_nDetections() > 0);
+  check_identical(detection, reference, TOLERANCE_SNR_DOUBLE);
+}
+
+/// @brief Test Doppler-spread clutter is suppressed compared to 1D CFAR.
+TEST_CASE("Process_Spread", "[process]")
+{
+  std::mt19937 gen(2);
+  Map<std::complex<double>> map = create_map<double>(64, 100, gen);
+  // clutter spread over Doppler at delay 30
+  for (uint32_t i = 0; i < 64; i++)
+  {
+    map.at(i, 30) *= 10;
+  }
+  // point target
+  map.at(10, 70) = 100;
+
+  CfarDetector1D cfar1D(1e-3, 1, 4, 0, 0);
+  CfarDetector2D cfar2D(1e-3, 0, 1, 4, 8, Mode::Ca, Window::Cross, 0, 0, 2);
+  Detection detection1D;
+  cfar1D.process(&map, &detection1D);
+  Detection detection2D;
+  cfar2D.process(&map, &detection2D);
+
+  CHECK(count_delay(detection1D, 30) > 50);
+  CHECK(5 * count_delay(detection2D, 30) < count_delay(detection1D, 30));
+  CHECK(count_delay(detection2D, 70) == 1);
+}
+
+/// @brief Test float maps match double maps.
+TEST_CASE("Process_Float", "[process]")
+{
+  std::mt19937 gen(3);
+  Map<std::complex<double>> map = create_map<double>(32, 64, gen);
+  add_targets(map, gen, 0.01, 3);
+  Map<std::complex<float>> mapFloat(32, 64);
+  mapFloat.delay = map.delay;
+  mapFloat.doppler = map.doppler;
+  for (uint32_t i = 0; i < 32; i++)
+  {
+    for (uint32_t j = 0; j < 64; j++)
+    {
+      mapFloat.at(i, j) = std::complex<float>(map.at(i, j));
+    }
+  }
+  CfarDetector2D cfar(1e-3, 1, 1, 3, 3);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  Detection detectionFloat;
+  cfar.process(&mapFloat, &detectionFloat);
+  CHECK(detection.get_delay() == detectionFloat.get_delay());
+  CHECK(detection.get_doppler() == detectionFloat.get_doppler());
+}
+
+/// @brief Test invalid windows throw.
+TEST_CASE("Constructor_Invalid", "[constructor]")
+{
+  CHECK_THROWS_AS(CfarDetector2D(1e-3, 1, 1, 0, 0), std::invalid_argument);
+  CHECK_THROWS_AS(CfarDetector2D(1e-3, -1, 1, 2, 2), std::invalid_argument);
+}
@@ -0,0 +1,137 @@
+/// @file TestCfarDetectorClutterMap.cpp
+/// @brief Unit test for CfarDetectorClutterMap.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/detection/CfarDetectorClutterMap.h"
+#include "data/Map.h"
+#include "helper/TestHelper.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <filesystem>
+
+/// @brief Fill a map with noise and static clutter.
+/// @param map Map to fill.
+/// @param gen Random number generator.
+/// @return Void.
+void fill_map(Map<std::complex<float>> &map, std::mt19937 &gen)
+{
+  uint32_t nRows = map.get_nRows();
+  if (map.delay.empty())
+  {
+    map = create_map<float>(nRows, map.get_nCols(), gen);
+  }
+  else
+  {
+    fill_noise(map, gen);
+  }
+  // static clutter residue
+  map.at(nRows / 2, 10) *= 100;
+  map.at(nRows / 2, 11) *= 30;
+  map.set_metrics();
+}
+
+/// @brief Test the false alarm rate and static clutter after warm-up.
+TEST_CASE("Process_Pfa", "[process]")
+{
+  std::mt19937 gen(1);
+  Map<std::complex<float>> map(50, 100);
+  CfarDetectorClutterMap cfar(1e-2, 0.1);
+
+  size_t nDetections = 0;
+  size_t nClutter = 0;
+  for (uint32_t cpi = 0; cpi < 80; cpi++)
+  {
+    fill_map(map, gen);
+    Detection detection;
+    cfar.process(&map, &detection);
+    if (cpi < 10)
+    {
+      CHECK(detection.get_nDetections() == 0);
+    }
+    if (cpi >= 30)
+    {
+      nDetections += detection.get_nDetections();
+      for (size_t k = 0; k < detection.get_nDetections(); k++)
+      {
+        nClutter += detection.get_delay()[k] == 10 && 
+          detection.get_doppler()[k] == map.doppler[25];
+      }
+    }
+  }
+  double rate = (double)nDetections / (50 * 100 * 50);
+  CHECK(rate > 0.008);
+  CHECK(rate < 0.012);
+  CHECK(nClutter < 5);
+  CHECK(cfar.get_n_update() == 80);
+}
+
+/// @brief Test a new target in a clutter cell is detected.
+TEST_CASE("Process_Target", "[process]")
+{
+  std::mt19937 gen(2);
+  Map<std::complex<float>> map(20, 40);
+  CfarDetectorClutterMap cfar(1e-4, 0.2, 0, 0);
+  Detection detection;
+  for (uint32_t cpi = 0; cpi < 20; cpi++)
+  {
+    fill_map(map, gen);
+    cfar.process(&map, &detection);
+  }
+  fill_map(map, gen);
+  map.at(3, 30) = 100;
+  cfar.process(&map, &detection);
+  bool isFound = false;
+  for (size_t k = 0; k < detection.get_nDetections(); k++)
+  {
+    isFound |= detection.get_delay()[k] == 30 && detection.get_doppler()[k] == map.doppler[3];
+  }
+  CHECK(isFound);
+}
+
+/// @brief Test the background persists without a warm-up.
+TEST_CASE("Save_Load", "[save]")
+{
+  std::string path = (std::filesystem::temp_directory_path() / 
+    "testCfarDetectorClutterMap.map").string();
+  std::remove(path.c_str());
+  std::mt19937 gen(3);
+  Map<std::complex<float>> map(20, 40);
+  Detection detection;
+  {
+    CfarDetectorClutterMap cfar(1e-4, 0.2, 0, 0, path);
+    for (uint32_t cpi = 0; cpi < 12; cpi++)
+    {
+      fill_map(map, gen);
+      cfar.process(&map, &detection);
+    }
+  }
+  REQUIRE(std::filesystem::exists(path));
+
+  CfarDetectorClutterMap cfar(1e-4, 0.2, 0, 0, path);
+  CHECK(cfar.get_n_update() == 12);
+  fill_map(map, gen);
+  map.at(3, 30) = 100;
+  cfar.process(&map, &detection);
+  CHECK(detection.get_nDetections() >= 1);
+
+  // a different map size starts a new background
+  Map<std::complex<float>> mapOther(10, 40);
+  fill_map(mapOther, gen);
+  cfar.process(&mapOther, &detection);
+  CHECK(cfar.get_n_update() == 1);
+  CHECK(detection.get_nDetections() == 0);
+  std::remove(path.c_str());
+}
+
+/// @brief Test invalid arguments throw.
+TEST_CASE("Constructor_Invalid", "[constructor]")
+{
+  CHECK_THROWS_AS(CfarDetectorClutterMap(1e-3, 0), std::invalid_argument);
+  CHECK_THROWS_AS(CfarDetectorClutterMap(1e-3, 1.5), std::invalid_argument);
+}
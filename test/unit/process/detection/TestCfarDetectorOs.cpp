@@ -0,0 +1,141 @@
+/// @file TestCfarDetectorOs.cpp
+/// @brief Unit test for CfarDetectorOs.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/detection/CfarDetectorOs.h"
+#include "process/detection/CfarDetector1D.h"
+#include "data/Map.h"
+#include "helper/TestHelper.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+/// @brief Reference OS-CFAR sorting the training cells of every cell.
+/// @param x Map to process.
+/// @param pfa Probability of false alarm.
+/// @param nGuard Number of guard cells.
+/// @param nTrain Number of training cells.
+/// @param rank Rank of the order statistic as a fraction of training cells.
+/// @return Detections.
+Detection cfar_direct(const Map<std::complex<double>> &x, double pfa, int nGuard, 
+  int nTrain, double rank)
+{
+  int nCols = x.get_nCols();
+  std::vector<double> delay, doppler, snr;
+  for (int i = 0; i < (int)x.get_nRows(); i++)
+  {
+    for (int j = 0; j < nCols; j++)
+    {
+      std::vector<double> train;
+      for (int k = j - nGuard - nTrain; k <= j + nGuard + nTrain; k++)
+      {
+        if (k >= 0 && k < nCols && std::abs(k - j) > nGuard)
+        {
+          train.push_back(std::norm(x.at(i, k)));
+        }
+      }
+      int n = train.size();
+      int k = std::clamp((int)std::lround(rank * n), 1, n);
+      std::sort(train.begin(), train.end());
+
+      // solve Pfa = prod (n - i) / (n - i + alpha) by bisection
+      double low = 0, high = 1e6;
+      for (int iter = 0; iter < 200; iter++)
+      {
+        double mid = 0.5 * (low + high);
+        double p = 1;
+        for (int m = 0; m < k; m++)
+        {
+          p *= (double)(n - m) / (n - m + mid);
+        }
+        (p > pfa ? low : high) = mid;
+      }
+      if (std::norm(x.at(i, j)) > high * train[k - 1])
+      {
+        delay.push_back(j + x.delay[0]);
+        doppler.push_back(x.doppler[i]);
+        snr.push_back(10 * std::log10(std::abs(x.at(i, j))) - x.noisePower);
+      }
+    }
+  }
+  return Detection(delay, doppler, snr);
+}
+
+/// @brief Test the sliding window matches sorting every window.
+TEST_CASE("Process_Direct", "[process]")
+{
+  auto rank = GENERATE(0.5, 0.75, 1.0);
+  auto nGuard = GENERATE(0, 2);
+  auto nThreads = GENERATE(1, 3);
+  std::mt19937 gen(1);
+  Map<std::complex<double>> map = create_map<double>(32, 150, gen);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  for (uint32_t i = 0; i < 32; i++)
+  {
+    for (uint32_t j = 0; j < 150; j++)
+    {
+      if (uniform(gen) < 0.03)
+      {
+        map.at(i, j) *= 30 * uniform(gen);
+      }
+    }
+  }
+  CfarDetectorOs cfar(1e-3, nGuard, 8, rank, 0, 0, nThreads);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  Detection reference = cfar_direct(map, 1e-3, nGuard, 8, rank);
+  CHECK(detection.get_nDetections() > 0);
+  check_identical(detection, reference, TOLERANCE_SNR_DOUBLE);
+}
+
+/// @brief Test the false alarm rate on noise.
+TEST_CASE("Process_Pfa", "[process]")
+{
+  std::mt19937 gen(2);
+  Map<std::complex<double>> map = create_map<double>(200, 400, gen);
+  CfarDetectorOs cfar(1e-2, 2, 12, 0.75, 0, 0, 2);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  double rate = (double)detection.get_nDetections() / (200 * 400);
+  CHECK(rate > 0.008);
+  CHECK(rate < 0.012);
+}
+
+/// @brief Test a weak target next to a strong target is not masked.
+TEST_CASE("Process_Masking", "[process]")
+{
+  std::mt19937 gen(3);
+  Map<std::complex<double>> map = create_map<double>(16, 100, gen);
+  for (uint32_t i = 0; i < 16; i++)
+  {
+    map.at(i, 50) = 300;
+    map.at(i, 55) = 15;
+  }
+  CfarDetector1D cfarCa(1e-4, 1, 8, 0, 0);
+  CfarDetectorOs cfarOs(1e-4, 1, 8, 0.75);
+
+  Detection detectionCa;
+  cfarCa.process(&map, &detectionCa);
+  Detection detectionOs;
+  cfarOs.process(&map, &detectionOs);
+  CHECK(count_delay(detectionCa, 50) == 16);
+  CHECK(count_delay(detectionCa, 55) == 0);
+  CHECK(count_delay(detectionOs, 50) == 16);
+  CHECK(count_delay(detectionOs, 55) == 16);
+}
+
+/// @brief Test invalid arguments throw.
+TEST_CASE("Constructor_Invalid", "[constructor]")
+{
+  CHECK_THROWS_AS(CfarDetectorOs(1e-3, 1, 0, 0.75), std::invalid_argument);
+  CHECK_THROWS_AS(CfarDetectorOs(1e-3, 1, 4, 0), std::invalid_argument);
+  CHECK_THROWS_AS(CfarDetectorOs(1e-3, 1, 4, 1.5), std::invalid_argument);
+}
@@ -0,0 +1,124 @@
+/// @file TestInterpolate.cpp
+/// @brief Unit test for Interpolate.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "process/detection/Interpolate.h"
+#include "process/detection/CfarDetector1D.h"
+#include "data/Map.h"
+#include "helper/TestHelper.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+
+/// @brief Reference interpolation searching the Doppler axis for each value.
+/// @param x Detections.
+/// @param y Map.
+/// @return Interpolated detections.
+Detection interpolate_search(Detection &x, const Map<std::complex<double>> &y)
+{
+  std::vector<double> delay = x.get_delay();
+  std::vector<double> doppler = x.get_doppler();
+  std::vector<double> snr = x.get_snr();
+  std::vector<double> delay2, doppler2, snr2;
+  auto row = [&y](double hz) {
+    for (size_t i = 0; i < y.doppler.size(); i++) {
+      if (y.doppler[i] == hz) {
+        return (int)i;
+      }
+    }
+    return 0;
+  };
+  auto level = [&y](int i, int j) {
+    return (double)10*std::log10(std::abs(y.at(i, j)))-y.noisePower;
+  };
+  for (size_t i = 0; i < snr.size(); i++)
+  {
+    int r = row(doppler[i]);
+    int c = delay[i] - y.delay[0];
+    if (c == 0 || c == (int)y.get_nCols() - 1 || r == 0 || r == (int)y.get_nRows() - 1)
+    {
+      continue;
+    }
+    double a = level(r, c - 1), b = level(r, c), d = level(r, c + 1);
+    if (b < a || b < d)
+    {
+      continue;
+    }
+    double intDelay = (a-d)/(2*(a-(2*b)+d));
+    double intSnrDelay = b - (((a-d)*intDelay)/4);
+    a = level(r - 1, c);
+    d = level(r + 1, c);
+    if (b < a || b < d)
+    {
+      continue;
+    }
+    double intDoppler = (a-d)/(2*(a-(2*b)+d));
+    intSnrDelay = b - (((a-d)*intDoppler)/4);
+    delay2.push_back(delay[i] + intDelay);
+    doppler2.push_back(doppler[i] + ((y.doppler[1]-y.doppler[0])*intDoppler));
+    snr2.push_back(std::max(std::max(intSnrDelay, snr[i]), snr[i]));
+  }
+  return Detection(delay2, doppler2, snr2);
+}
+
+/// @brief Create a noise map with targets spread over neighbouring cells.
+/// @param gen Random number generator.
+/// @return Map.
+Map<std::complex<double>> create_spread_map(std::mt19937 &gen)
+{
+  Map<std::complex<double>> map = create_map<double>(101, 200, gen, -10, 1 / 0.3);
+  for (int k = 0; k < 30; k++)
+  {
+    uint32_t i = 1 + gen() % 99, j = 1 + gen() % 198;
+    map.at(i, j) *= 30;
+    map.at(i, j - 1) *= 10;
+    map.at(i + 1, j) *= 5;
+  }
+  map.set_metrics();
+  return map;
+}
+
+/// @brief Test interpolation from detector indices and from map axes.
+TEST_CASE("Process_Bin", "[process]")
+{
+  std::mt19937 gen(1);
+  Map<std::complex<double>> map = create_spread_map(gen);
+  CfarDetector1D cfar(1e-4, 2, 6, -10, 0);
+  Interpolate interpolate(true, true);
+
+  Detection detection;
+  cfar.process(&map, &detection);
+  REQUIRE(detection.has_bin());
+  Detection noBin(detection.get_delay(), detection.get_doppler(), detection.get_snr());
+  REQUIRE(!noBin.has_bin());
+
+  Detection y;
+  interpolate.process(&detection, &map, &y);
+  Detection yNoBin;
+  interpolate.process(&noBin, &map, &yNoBin);
+  Detection reference = interpolate_search(detection, map);
+  CHECK(y.get_nDetections() > 10);
+  check_identical(y, reference, TOLERANCE_SNR_DOUBLE);
+  CHECK(yNoBin.get_delay() == reference.get_delay());
+  CHECK(yNoBin.get_doppler() == reference.get_doppler());
+  CHECK(y.has_bin());
+}
+
+/// @brief Test map axis conversions round to the nearest bin and reject misses.
+TEST_CASE("Map_Bin", "[map]")
+{
+  std::mt19937 gen(2);
+  Map<std::complex<double>> map = create_spread_map(gen);
+  CHECK(map.doppler_hz_to_bin(map.doppler[0]) == 0);
+  CHECK(map.doppler_hz_to_bin(map.doppler[73]) == 73);
+  CHECK(map.doppler_hz_to_bin(map.doppler[73] + 0.4 / 0.3) == 73);
+  CHECK(map.doppler_hz_to_bin(map.doppler[100] + 2) == -1);
+  CHECK(map.doppler_hz_to_bin(map.doppler[0] - 2) == -1);
+  CHECK(map.delay_to_bin(-10) == 0);
+  CHECK(map.delay_to_bin(50.3) == 60);
+  CHECK(map.delay_to_bin(-11) == -1);
+  CHECK(map.delay_to_bin(190) == -1);
+}
@@ -0,0 +1,112 @@
+/// @file TestPeakExtractor.cpp
+/// @brief Unit test for PeakExtractor.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/detection/PeakExtractor.h"
+#include "process/detection/CfarDetector1D.h"
+#include "process/detection/Centroid.h"
+#include "process/detection/Interpolate.h"
+#include "data/Map.h"
+#include "helper/TestHelper.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+
+/// @brief Create a noise map with targets spread over neighbouring cells.
+/// @param nRows Number of rows.
+/// @param nCols Number of columns.
+/// @param gen Random number generator.
+/// @return Map.
+template <typename T>
+Map<std::complex<T>> create_spread_map(uint32_t nRows, uint32_t nCols, std::mt19937 &gen)
+{
+  std::uniform_real_distribution<double> uniform(0, 1);
+  Map<std::complex<T>> map = create_map<T>(nRows, nCols, gen, -5, 1 / 0.3);
+  for (uint32_t k = 0; k < nRows * nCols / 200; k++)
+  {
+    uint32_t i = gen() % nRows, j = gen() % nCols;
+    double gain = std::pow(10.0, 2 * uniform(gen) + 0.5);
+    for (int di = -2; di <= 2; di++)
+    {
+      for (int dj = -2; dj <= 2; dj++)
+      {
+        int r = i + di, c = j + dj;
+        if (r >= 0 && r < (int)nRows && c >= 0 && c < (int)nCols)
+        {
+          map.at(r, c) *= (T)(gain / (1 + di * di + dj * dj * uniform(gen)));
+        }
+      }
+    }
+  }
+  return map;
+}
+
+/// @brief Run the CFAR, centroid and interpolation stages in turn.
+/// @param x Map.
+/// @param nCentroid Number of bins to check for the centroid.
+/// @param minDelay Minimum delay to process detections (bins).
+/// @param minDoppler Minimum absolute Doppler to process detections (Hz).
+/// @return Detections.
+template <typename T>
+Detection process_chain(Map<std::complex<T>> &x, uint16_t nCentroid,
+  int8_t minDelay, double minDoppler)
+{
+  CfarDetector1D cfar(1e-4, 2, 6, minDelay, minDoppler);
+  Centroid centroid(nCentroid, nCentroid, 1 / 0.3);
+  Interpolate interpolate(true, true);
+  Detection detection1, detection2, detection3;
+  cfar.process(&x, &detection1);
+  centroid.process(&detection1, &detection2);
+  interpolate.process(&detection2, &x, &detection3);
+  return detection3;
+}
+
+/// @brief Test the fused pass matches the stages for double.
+TEST_CASE("Process_Double", "[process]")
+{
+  auto nThreads = GENERATE(1, 3);
+  auto nCentroid = GENERATE(0, 1, 3, 6);
+  std::mt19937 gen(1);
+  Map<std::complex<double>> map = create_spread_map<double>(64, 300, gen);
+  PeakExtractor extractor(1e-4, 2, 6, 0, 0, nCentroid, nCentroid, 1 / 0.3, nThreads);
+  Detection detection;
+
+  extractor.process(&map, &detection);
+  Detection reference = process_chain(map, nCentroid, 0, 0);
+  CHECK(detection.get_nDetections() > 0);
+  check_identical(detection, reference, 0);
+}
+
+/// @brief Test the fused pass matches the stages for float.
+TEST_CASE("Process_Float", "[process]")
+{
+  auto nThreads = GENERATE(1, 4);
+  std::mt19937 gen(2);
+  Map<std::complex<float>> map = create_spread_map<float>(50, 200, gen);
+  PeakExtractor extractor(1e-4, 2, 6, 0, 0, 4, 4, 1 / 0.3, nThreads);
+  Detection detection;
+
+  extractor.process(&map, &detection);
+  Detection reference = process_chain(map, 4, 0, 0);
+  CHECK(detection.get_nDetections() > 0);
+  check_identical(detection, reference, 0);
+}
+
+/// @brief Test minimum delay and Doppler, and reuse of the detection buffer.
+TEST_CASE("Process_Minimum", "[process]")
+{
+  std::mt19937 gen(3);
+  PeakExtractor extractor(1e-4, 2, 6, 10, 20, 3, 3, 1 / 0.3, 2);
+  Detection detection;
+  for (int cpi = 0; cpi < 3; cpi++)
+  {
+    Map<std::complex<double>> map = create_spread_map<double>(40, 150, gen);
+    extractor.process(&map, &detection);
+    Detection reference = process_chain(map, 3, 10, 20);
+    check_identical(detection, reference, 0);
+  }
+}
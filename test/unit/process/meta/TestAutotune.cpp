@@ -0,0 +1,80 @@
+/// @file TestAutotune.cpp
+/// @brief Unit test for Autotune.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "process/meta/Autotune.h"
+#include "process/meta/HammingNumber.h"
+
+#include <filesystem>
+#include <cstdio>
+
+/// @brief Test FFT length is one of the candidates.
+TEST_CASE("Fft_Length", "[autotune]")
+{
+    uint32_t nMin = GENERATE(1000, 3321, 6643);
+    std::string path = (std::filesystem::temp_directory_path() / "blah2_autotune_length").string();
+    std::remove(path.c_str());
+
+    Autotune autotune(path, "length");
+    uint32_t n = autotune.fft_length("range", nMin);
+    uint32_t pow2 = 1;
+    while (pow2 < nMin)
+    {
+      pow2 *= 2;
+    }
+
+    CHECK(n >= nMin);
+    CHECK((n == nMin || n == next_hamming(nMin - 1) ||
+      n == next_smooth(nMin - 1, {2, 3, 5, 7}) || n == pow2));
+    CHECK(!autotune.is_cached("range"));
+}
+
+/// @brief Test FFTW thread count is a power of 2 in range.
+TEST_CASE("Fft_Threads", "[autotune]")
+{
+    std::string path = (std::filesystem::temp_directory_path() / "blah2_autotune_threads").string();
+    std::remove(path.c_str());
+
+    Autotune<float> autotune(path, "threads");
+    uint32_t nThreads = autotune.fft_threads("fftw", 4096, 4);
+
+    CHECK(nThreads >= 1);
+    CHECK(nThreads <= 4);
+    CHECK((nThreads & (nThreads - 1)) == 0);
+}
+
+/// @brief Test decisions are cached in the profile by config.
+TEST_CASE("Profile", "[autotune]")
+{
+    std::string path = (std::filesystem::temp_directory_path() / "blah2_autotune_profile").string();
+    std::remove(path.c_str());
+
+    Autotune first(path, "config a");
+    uint32_t n = first.fft_length("range", 3321);
+    REQUIRE(first.save());
+
+    // same config reads the decision
+    Autotune second(path, "config a");
+    CHECK(second.is_cached("range"));
+    CHECK(second.fft_length("range", 3321) == n);
+    CHECK(second.to_string().find("(profile)") != std::string::npos);
+
+    // other config tunes again, keeping the first entry on save
+    Autotune third(path, "config b");
+    CHECK(!third.is_cached("range"));
+    third.fft_length("range", 1000);
+    REQUIRE(third.save());
+    Autotune fourth(path, "config a");
+    CHECK(fourth.is_cached("range"));
+    CHECK(fourth.fft_length("range", 3321) == n);
+
+    // larger minimum length is tuned again
+    CHECK(fourth.fft_length("range", n + 1) > n);
+    CHECK(!fourth.is_cached("range"));
+
+    std::remove(path.c_str());
+}
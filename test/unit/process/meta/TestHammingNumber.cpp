@@ -15,4 +15,21 @@ TEST_CASE("Next_Hamming", "[hamming]")
     CHECK(next_hamming(104) == 108);
     CHECK(next_hamming(3322) == 3375);
     CHECK(next_hamming(19043) == 19200);
-}
\ No newline at end of file
+}
+
+/// @brief Test Hamming number rounding down.
+TEST_CASE("Prev_Hamming", "[hamming]")
+{
+    CHECK(prev_hamming(108) == 108);
+    CHECK(prev_hamming(3322) == 3240);
+    CHECK(prev_hamming(19043) == 18750);
+}
+
+/// @brief Test smooth number calculation with other prime factors.
+TEST_CASE("Next_Smooth", "[hamming]")
+{
+    CHECK(next_smooth(3322, {2, 3, 5}) == next_hamming(3322));
+    CHECK(next_smooth(3322, {2, 3, 5, 7}) == 3360);
+    CHECK(next_smooth(19043, {2, 3, 5, 7}) == 19200);
+    CHECK(next_smooth(1000, {2}) == 1024);
+}
@@ -0,0 +1,114 @@
+/// @file TestReferenceSpectrum.cpp
+/// @brief Unit test for ReferenceSpectrum.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "process/spectrum/ReferenceSpectrum.h"
+#include "process/spectrum/SpectrumAnalyser.h"
+#include "process/clutter/WienerHopf.h"
+
+#include <random>
+#include <complex>
+#include <cmath>
+
+/// @brief Fill reference and surveillance with direct signal and clutter.
+/// @param x Address of reference IqData object.
+/// @param y Address of surveillance IqData object.
+/// @return Void.
+void simulate_clutter(IqData& x, IqData& y)
+{
+  std::mt19937 gen(0);
+  std::normal_distribution<> dist(0.0, 100.0);
+  std::vector<std::complex<double>> ref(x.get_n());
+  for (uint32_t i = 0; i < x.get_n(); i++)
+  {
+    ref[i] = {dist(gen), dist(gen)};
+    x.push_back(ref[i]);
+  }
+  for (uint32_t i = 0; i < y.get_n(); i++)
+  {
+    std::complex<double> clutter = 0.5 * ref[i];
+    clutter += (i >= 3) ? 0.2 * ref[i-3] : 0;
+    y.push_back(clutter + 0.1 * std::complex<double>(dist(gen), dist(gen)));
+  }
+}
+
+/// @brief Test the cached spectrum is the DFT of the reference.
+TEST_CASE("Process", "[process]")
+{
+  uint32_t n = 1000;
+  IqData x{n};
+  IqData y{n};
+  simulate_clutter(x, y);
+  ReferenceSpectrum reference(n);
+  reference.process(&x);
+  REQUIRE(x.get_length() == n);
+
+  std::deque<std::complex<double>> data = x.get_data();
+  for (uint32_t k : {0, 1, 123, 999})
+  {
+    std::complex<double> sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+      sum += data[i] * std::polar(1.0, -2.0 * M_PI * ((uint64_t)k * i % n) / n);
+    }
+    CHECK(std::abs(reference.get_spectrum()[k] - sum) / std::abs(sum) < 1e-9);
+  }
+}
+
+/// @brief Test the spectrum analyser matches with a cached spectrum.
+TEST_CASE("Spectrum_Cached", "[spectrum]")
+{
+  uint32_t n = 20000;
+  IqData x{n};
+  IqData y{n};
+  simulate_clutter(x, y);
+  ReferenceSpectrum reference(n);
+  reference.process(&x);
+
+  SpectrumAnalyser spectrumAnalyser(n, 2000);
+  spectrumAnalyser.process(&x);
+  std::vector<std::complex<double>> spectrum = x.get_spectrum();
+  spectrumAnalyser.process(&x, &reference);
+  std::vector<std::complex<double>> spectrumCached = x.get_spectrum();
+
+  REQUIRE(spectrum.size() == spectrumCached.size());
+  double error = 0;
+  for (size_t i = 0; i < spectrum.size(); i++)
+  {
+    error = std::max(error, std::abs(spectrum[i] - spectrumCached[i]) / std::abs(spectrum[i]));
+  }
+  CHECK(error < 1e-9);
+}
+
+/// @brief Test the clutter filter matches with a cached spectrum.
+TEST_CASE("Clutter_Cached", "[clutter]")
+{
+  uint32_t n = 20000;
+  IqData x1{n};
+  IqData y1{n};
+  IqData x2{n};
+  IqData y2{n};
+  simulate_clutter(x1, y1);
+  simulate_clutter(x2, y2);
+  ReferenceSpectrum reference(n);
+  reference.process(&x2);
+
+  WienerHopf filter1(-10, 50, n);
+  WienerHopf filter2(-10, 50, n);
+  REQUIRE(filter1.process(&x1, &y1));
+  REQUIRE(filter2.process(&x2, &y2, &reference));
+
+  std::deque<std::complex<double>> out1 = y1.get_data();
+  std::deque<std::complex<double>> out2 = y2.get_data();
+  REQUIRE(out1.size() == out2.size());
+  double error = 0, power = 0;
+  for (size_t i = 0; i < out1.size(); i++)
+  {
+    error += std::norm(out1[i] - out2[i]);
+    power += std::norm(out1[i]);
+  }
+  CHECK(error / power < 1e-12);
+}
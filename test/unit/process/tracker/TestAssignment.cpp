@@ -0,0 +1,113 @@
+/// @file TestAssignment.cpp
+/// @brief Unit test for Assignment.cpp
+/// @author 30hours
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "process/tracker/Assignment.h"
+
+#include <vector>
+#include <random>
+#include <limits>
+#include <algorithm>
+
+/// @brief Find the minimum total cost by trying every assignment.
+/// @param cost Cost of each pair, infinite if not allowed.
+/// @param costMiss Cost of leaving a row unassigned.
+/// @param row Current row.
+/// @param isUsed True if the column is assigned.
+/// @return Minimum total cost of rows from the current row.
+double brute_force(const std::vector<std::vector<double>> &cost, double costMiss,
+  size_t row, std::vector<bool> &isUsed)
+{
+  if (row == cost.size())
+  {
+    return 0;
+  }
+  double best = costMiss + brute_force(cost, costMiss, row + 1, isUsed);
+  for (size_t j = 0; j < isUsed.size(); j++)
+  {
+    if (!isUsed[j] && cost[row][j] < std::numeric_limits<double>::infinity())
+    {
+      isUsed[j] = true;
+      best = std::min(best, cost[row][j] + brute_force(cost, costMiss, row + 1, isUsed));
+      isUsed[j] = false;
+    }
+  }
+  return best;
+}
+
+/// @brief Test a case where first-come assignment is not optimal.
+TEST_CASE("Solve_Greedy", "[solve]")
+{
+  Assignment assignment;
+  std::vector<int32_t> col4row;
+  assignment.reset(2, 2);
+  assignment.add(0, 0, 0.1);
+  assignment.add(0, 1, 0.2);
+  assignment.add(1, 0, 0.15);
+
+  double total = assignment.solve(1, col4row);
+  CHECK_THAT(total, Catch::Matchers::WithinAbs(0.35, 1e-12));
+  CHECK(col4row == std::vector<int32_t>{1, 0});
+
+  // unassigned when the pair costs more than a miss
+  assignment.reset(2, 1);
+  assignment.add(0, 0, 0.5);
+  assignment.add(1, 0, 2);
+  total = assignment.solve(1, col4row);
+  CHECK_THAT(total, Catch::Matchers::WithinAbs(1.5, 1e-12));
+  CHECK(col4row == std::vector<int32_t>{0, -1});
+}
+
+/// @brief Test random sparse problems against a brute force search.
+TEST_CASE("Solve_Random", "[solve]")
+{
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  Assignment assignment;
+  std::vector<int32_t> col4row;
+  for (int trial = 0; trial < 300; trial++)
+  {
+    uint32_t nRows = 1 + gen() % 7;
+    uint32_t nCols = gen() % 7;
+    double density = uniform(gen);
+    std::vector<std::vector<double>> cost(nRows,
+      std::vector<double>(nCols, std::numeric_limits<double>::infinity()));
+    assignment.reset(nRows, nCols);
+    for (uint32_t i = 0; i < nRows; i++)
+    {
+      for (uint32_t j = 0; j < nCols; j++)
+      {
+        if (uniform(gen) < density)
+        {
+          cost[i][j] = uniform(gen);
+          assignment.add(i, j, cost[i][j]);
+        }
+      }
+    }
+
+    double total = assignment.solve(1, col4row);
+    std::vector<bool> isUsed(nCols, false);
+    CHECK_THAT(total, Catch::Matchers::WithinAbs(
+      brute_force(cost, 1, 0, isUsed), 1e-9));
+
+    // each column at most once, and only on allowed pairs
+    double check = 0;
+    REQUIRE(col4row.size() == nRows);
+    for (uint32_t i = 0; i < nRows; i++)
+    {
+      if (col4row[i] < 0)
+      {
+        check += 1;
+        continue;
+      }
+      REQUIRE(col4row[i] < (int32_t)nCols);
+      CHECK(!isUsed[col4row[i]]);
+      isUsed[col4row[i]] = true;
+      check += cost[i][col4row[i]];
+    }
+    CHECK_THAT(check, Catch::Matchers::WithinAbs(total, 1e-9));
+  }
+}
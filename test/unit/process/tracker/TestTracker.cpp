@@ -6,6 +6,7 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include "data/Detection.h"
+#include "data/Plot.h"
 #include "data/Track.h"
 #include "process/tracker/Tracker.h"
 #include "data/meta/Constants.h"
@@ -49,11 +50,27 @@ TEST_CASE("Process ACTIVE track constant acc", "[process]")
   
   
   // create detections with constant acc 5 Hz/s
-  std::vector<uint64_t> timestamp = {0,1,2,3,4,5,6,7,8,9,10};
+  std::vector<uint64_t> timestamp = {0,1000,2000,3000,4000,5000,6000,7000,8000,9000};
   std::vector<double> delay = {10};
   std::vector<double> doppler = {-20,-15,-10,-5,0,5,10,15,20,25};
 
+  std::unique_ptr<Track> track;
+  for (size_t i = 0; i < timestamp.size(); i++)
+  {
+    Detection detection(delay.front(), doppler[i], 20);
+    track = tracker.process(&detection, timestamp[i]);
+  }
+
   std::string state = "ACTIVE";
+  REQUIRE(track->get_nState(state) == 1);
+  for (uint64_t i = 0; i < track->get_n(); i++)
+  {
+    if (track->get_state(i) == state)
+    {
+      CHECK_THAT(track->get_acceleration(i), Catch::Matchers::WithinAbs(5, 1e-9));
+      CHECK(track->get_current(i).doppler == doppler.back());
+    }
+  }
 }
 
 /// @brief Test predict for kinematics equations.
@@ -71,14 +88,14 @@ TEST_CASE("Test predict", "[predict]")
   Tracker tracker = Tracker(m, n, nDelete, 
     cpi, maxAccInit, rangeRes, lambda);
 
-  Detection input = Detection(10, -20, 0);
+  Plot input = {10, -20, 0};
   double acc = 5;
   double T = 1;
-  Detection prediction = tracker.predict(input, acc, T);
-  Detection prediction_truth = Detection(9.821, -15, 0);
+  Plot prediction = tracker.predict(input, acc, T);
+  Plot prediction_truth = {9.821, -15, 0};
 
-  CHECK_THAT(prediction.get_delay().front(), 
-    Catch::Matchers::WithinAbs(prediction_truth.get_delay().front(), 0.01));
-  CHECK_THAT(prediction.get_doppler().front(), 
-    Catch::Matchers::WithinAbs(prediction_truth.get_doppler().front(), 0.01));
+  CHECK_THAT(prediction.delay, 
+    Catch::Matchers::WithinAbs(prediction_truth.delay, 0.01));
+  CHECK_THAT(prediction.doppler, 
+    Catch::Matchers::WithinAbs(prediction_truth.doppler, 0.01));
 }
\ No newline at end of file